@@ -34,29 +34,25 @@ using namespace std;
 
 namespace bart
 {
+    // Draws the current frame of an instance of the AnimationSystem, the frames advance with all the others
     class Animation final : public Sprite
     {
     public:
-        virtual ~Animation() = default;
+        virtual ~Animation();
         void InitAnimation(int aRows, int aWidth, int aHeight);
         void Draw() override;
         void Update(Transform* aTransform, float aDelta) override;
         void Play(int aStart, int aCount, float aDelay, bool aLoop);
+        void Play(const string& aClip, float aSpeed); // a clip added to the animation system
         void Stop();
+        void SetPaused(bool aPaused);
+        size_t GetInstance() const { return m_Instance; }
 
     private:
-        void UpdateFrame();
-
         int m_ImagePerRow{0};
         int m_ImageWidth{0};
         int m_ImageHeight{0};
-        int m_FirstFrame{0};
-        int m_LastFrame{0};
-        float m_Delay{0.0f};
-        float m_Elapsed{0.0f};
-        bool m_Playing{false};
-        bool m_Loop{false};
-        int m_CurrentFrame{0};
+        size_t m_Instance{0};
     };
 }
 
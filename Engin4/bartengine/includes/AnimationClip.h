@@ -0,0 +1,66 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: AnimationClip.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef BART_ANIMATIONCLIP_H
+#define BART_ANIMATIONCLIP_H
+
+#include <Rectangle.h>
+#include <string>
+#include <vector>
+
+namespace bart
+{
+    // The frames of an animation, shared by all the instances playing it. The source rectangles are computed
+    // once, when the clip is built, and the clip does not change once given to the AnimationSystem
+    class AnimationClip
+    {
+    public:
+        struct Event
+        {
+            int Frame{0};
+            std::string Name;
+        };
+
+        static AnimationClip FromGrid(int aColumns, int aWidth, int aHeight, int aStart, int aCount, float aDelay, bool aLoop);
+        void AddFrame(const Rectangle& aSource, float aDuration);
+        void AddEvent(int aFrame, const std::string& aName); // raised each time the frame starts
+        void SetLoop(bool aLoop) { m_Loop = aLoop; }
+
+        size_t GetFrameCount() const { return m_Frames.size(); }
+        const Rectangle& GetFrame(size_t aFrame) const { return m_Frames[aFrame]; }
+        float GetDuration(size_t aFrame) const { return m_Durations[aFrame]; }
+        const std::vector<Event>& GetEvents() const { return m_Events; }
+        bool IsLooping() const { return m_Loop; }
+
+    private:
+        std::vector<Rectangle> m_Frames;
+        std::vector<float> m_Durations; // seconds
+        std::vector<Event> m_Events;
+        bool m_Loop{false};
+    };
+}
+
+#endif
@@ -0,0 +1,102 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: AnimationSystem.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef BART_ANIMATIONSYSTEM_H
+#define BART_ANIMATIONSYSTEM_H
+
+#include <AnimationClip.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bart
+{
+    // Advances every animation instance in one pass per frame. The instances are small records kept contiguous,
+    // they refer to shared clips and only those playing and on screen are advanced
+    class AnimationSystem
+    {
+    public:
+        struct FiredEvent
+        {
+            size_t Instance{0};
+            const std::string* Name{nullptr};
+        };
+
+        void Clean();
+        size_t AddClip(const std::string& aName, const AnimationClip& aClip); // a name already used keeps its clip
+        size_t FindClip(const std::string& aName) const; // 0 when unknown
+        const AnimationClip& GetClip(size_t aClip) const { return m_Clips[aClip - 1]; }
+
+        size_t Create();
+        void Destroy(size_t aInstance);
+        void Play(size_t aInstance, size_t aClip, float aSpeed);
+        void Stop(size_t aInstance);
+        void SetPaused(size_t aInstance, bool aPaused);
+        void SetBounds(size_t aInstance, const Rectangle& aBounds); // in world coordinates, for the off screen test
+        bool IsPlaying(size_t aInstance) const;
+        const Rectangle& GetFrame(size_t aInstance) const;
+        int GetFrameIndex(size_t aInstance) const;
+
+        void Update(float aDelta);
+        const std::vector<FiredEvent>& GetEvents() const { return m_Events; } // raised by the last Update
+        unsigned int GetAdvanced() const { return m_Advanced; } // instances advanced by the last Update
+        double GetClock() const { return m_Clock; } // seconds of updates, the clock of the animated tiles
+
+    private:
+        enum EInstanceFlags : unsigned char
+        {
+            PLAYING = 1,
+            PAUSED = 2
+        };
+
+        struct Instance
+        {
+            float Time{0.0f}; // in the current frame
+            float Speed{1.0f};
+            float MinX;
+            float MinY;
+            float MaxX;
+            float MaxY;
+            unsigned int Clip{0}; // index in m_Clips
+            unsigned int Handle{0}; // slot + 1, to move the record
+            unsigned short Frame{0};
+            unsigned char Flags{0};
+        };
+
+        void RaiseEvents(const Instance& aInstance, const AnimationClip& aClip);
+
+        std::vector<AnimationClip> m_Clips;
+        std::map<std::string, size_t> m_ClipNames;
+        std::vector<Instance> m_Instances;
+        std::vector<unsigned int> m_Slots; // record of each handle
+        std::vector<unsigned int> m_FreeSlots;
+        std::vector<FiredEvent> m_Events;
+        unsigned int m_Advanced{0};
+        double m_Clock{0.0};
+    };
+}
+
+#endif
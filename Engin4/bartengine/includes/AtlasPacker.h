@@ -0,0 +1,65 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: AtlasPacker.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef BART_ATLAS_PACKER_H
+#define BART_ATLAS_PACKER_H
+
+#include <Rectangle.h>
+#include <vector>
+
+namespace bart
+{
+    // Skyline bottom-left packer used to place images inside a texture atlas page
+    class AtlasPacker
+    {
+    public:
+        void Init(int aWidth, int aHeight);
+        bool Pack(int aWidth, int aHeight, Rectangle* aResult);
+        float GetOccupancy() const;
+        int GetWidth() const { return m_Width; }
+        int GetHeight() const { return m_Height; }
+
+    private:
+        struct SkylineNode
+        {
+            int X;
+            int Y;
+            int Width;
+        };
+
+        bool Fit(size_t aIndex, int aWidth, int aHeight, int* aY) const;
+        void AddLevel(size_t aIndex, int aX, int aY, int aWidth, int aHeight);
+        void Merge();
+
+        std::vector<SkylineNode> m_Skyline;
+        int m_Width{0};
+        int m_Height{0};
+        int m_UsedArea{0};
+    };
+}
+
+#endif
@@ -0,0 +1,53 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: BodySync.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef BART_BODYSYNC_H
+#define BART_BODYSYNC_H
+
+#include <IPhysic.h>
+#include <map>
+
+namespace bart
+{
+    class Transform;
+
+    // Copies the poses of the moving bodies to the transforms bound to them once the physic has stepped, with one
+    // IPhysic::SyncTransforms per frame rather than a call per body. A body at rest keeps the transform it had
+    class BodySync
+    {
+    public:
+        void Clean();
+        void Bind(size_t aBody, Transform* aTransform);
+        void Unbind(size_t aBody);
+        void Update(IPhysic& aPhysic);
+
+    private:
+        BodyTransforms m_Transforms;
+        std::map<size_t, Transform*> m_Targets; // by body id
+    };
+}
+
+#endif
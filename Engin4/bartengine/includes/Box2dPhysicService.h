@@ -32,13 +32,18 @@
 #define BART_BOX2D_PHYSICSERVICE_H
 
 #include <IPhysic.h>
-#include <map>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <set>
-#include <list>
+#include <thread>
+#include <utility>
+#include <vector>
 
 class b2World;
 class b2Body;
 class b2Fixture;
+class b2Contact;
 class b2Shape;
 
 namespace bart
@@ -54,6 +59,18 @@ namespace bart
         float Height;
         float HalfWidth;
         float HalfHeight;
+        unsigned int Slot; // to move the record when a body before it is destroyed
+        float PreviousX; // physic units, the state before the last step, or the last batch but one when threaded
+        float PreviousY;
+        float PreviousAngle;
+        float CurrentX; // physic units, the state after the last step or batch, read while the physic thread runs
+        float CurrentY;
+        float CurrentAngle;
+        float VelocityX;
+        float VelocityY;
+        float AngularVelocity;
+        float Mass; // read while the physic thread runs
+        bool Moving; // not static, awake or still moving from its previous state
     };
 
     class Box2dPhysicService final : public IPhysic
@@ -68,14 +85,18 @@ namespace bart
         void Awake(bool aValue) override;
         size_t CreateBody(const PhysicMaterial& aMaterial) override;
         void GetTransform(size_t aId, float* aX, float* aY, float* aAngle) override;
+        void GetInterpolatedTransform(size_t aId, float* aX, float* aY, float* aAngle) override;
         void SetTransform(size_t aId, float aX, float aY, float aAngle) override;
+        size_t SyncTransforms(BodyTransforms& aTransforms) override;
         void ApplyImpulse(size_t aId, float aX, float aY, bool aWorld) override;
         void ApplyForce(size_t aId, float aX, float aY, bool aWorld) override;
         void ApplyTorque(size_t aId, float aTorque) override;
         void ApplyAngularImpulse(size_t aId, float aImpulse) override;
         void DestroyBody(size_t aId) override;
         size_t GetBodyCount() override;
-        void Update() override;
+        void Update(float aDelta) override;
+        void SetStep(float aStep, int aMaxSubsteps) override;
+        void SetIterations(int aVelocity, int aPosition) override;
         void SetGravityScale(size_t aId, float aScale) override;
         float GetMass(size_t aId) override;
         void SetMass(size_t aId, float aMass) override;
@@ -89,27 +110,104 @@ namespace bart
         void SetAngularVelocity(size_t aId, float aVelocity) override;
         float GetAngularVelocity(size_t aId) override;
         void ClearWorld() override;
-        void AddContactInfo(ContactInfo* aContactInfo) override;
+        void SetThreaded(bool aThreaded) override;
+        void SetSolverThreads(int aThreads) override;
+        void SetWideSolver(bool aWide) override;
+        void SetWideCollide(bool aWide) override;
+        float GetStepMilliseconds() override { return m_lastStepMilliseconds; }
+        const BroadPhaseStats& GetBroadPhaseStats() override { return m_broadPhaseStats; }
+        void AddContact(EContactType aType, b2Contact* aContact); // from the contact listener, during a step
+        size_t GetDroppedContacts() const { return m_droppedContacts; } // by the last Update, over CONTACT_CAPACITY
 
     protected:
         void DestroyFixture(size_t aId) override;
 
     private:
+        // A contact raised during the step, kept until the step is over. The bodies are checked again before the
+        // dispatch, an entity destroyed in between has no user data on its body anymore
+        struct ContactEvent
+        {
+            b2Body* BodyA;
+            b2Body* BodyB;
+            float PointsX[2]; // world units, b2_maxManifoldPoints
+            float PointsY[2];
+            float NormalX;
+            float NormalY;
+            unsigned char PointCount;
+            EContactType Type;
+        };
+
+        struct ContactOrder
+        {
+            Entity* Target; // the entity called back
+            size_t Group; // sequence of the first contact of the entity
+            size_t Sequence; // order in which the contact was raised
+            size_t Event; // in the ring buffer
+        };
+
+        Box2dBodyInfo* FindBody(size_t aId);
+        void DispatchContacts();
+        void StorePreviousStates();
+        void StoreCurrentStates();
+        void BuildBody(size_t aId, const PhysicMaterial& aMaterial);
+        bool Defer(std::function<void()>&& aCommand); // false when the world can be changed right away
+        void StartStep(int aSteps);
+        void FinishStep();
+        void EndStep();
+        void AddBroadPhaseCounters(); // of the step just taken, on the stepping thread
+        void UpdateBroadPhaseStats();
+        void WorkerLoop(unsigned int aGeneration);
+        void StopWorker();
+        static void GetInterpolated(const Box2dBodyInfo& aInfo, float aInterpolation, float* aX, float* aY, float* aAngle);
+
+        static const unsigned int SLOT_BITS; // the low bits of a body id are its slot + 1, the high bits a generation
+        static const unsigned int SLOT_MASK;
         static const float WORLD_SCALE; // conversion helper
         static const float WORLD_SCALE_INV; // conversion helper
-        static const float TIME_STEP; // the amount of time to simulate, this should not vary.
-        static const int VELOCITY_ITERATION; // for the velocity constraint solver.
-        static const int POSITION_ITERATION; // for the position constraint solver.
+        static const float TIME_STEP; // the default amount of time to simulate, this should not vary.
+        static const int MAX_SUBSTEPS; // the default steps at most per Update, the time over it is dropped
+        static const int VELOCITY_ITERATION; // default for the velocity constraint solver.
+        static const int POSITION_ITERATION; // default for the position constraint solver.
+        static const size_t CONTACT_CAPACITY; // contact events kept between two dispatches
 
         b2World* m_physicWorld{nullptr};
         bool m_running{false};
-        size_t m_bodyIdCount{0};
+        float m_timeStep{TIME_STEP};
+        int m_maxSubsteps{MAX_SUBSTEPS};
+        int m_velocityIterations{VELOCITY_ITERATION};
+        int m_positionIterations{POSITION_ITERATION};
+        float m_accumulator{0.0f}; // time not simulated yet, less than a step after an Update
+        float m_interpolation{1.0f}; // between the previous and the current states of the bodies
+        float m_stepMilliseconds{0.0f}; // summed over the steps, on the physic thread when threaded
+        float m_lastStepMilliseconds{0.0f}; // of the steps finished by the last Update, published by EndStep
+        BroadPhaseStats m_broadPhaseStats;
+        BroadPhaseStats m_stepBroadPhase; // the counters summed over the steps, published by EndStep
 
-        typedef std::map<size_t, Box2dBodyInfo*> TBodyMap;
-        TBodyMap m_bodyList;
+        std::thread m_worker; // steps the world when the physic service is threaded
+        std::mutex m_mutex;
+        std::condition_variable m_startSignal;
+        std::condition_variable m_doneSignal;
+        unsigned int m_generation{0};
+        int m_pendingSteps{0};
+        bool m_busy{false};
+        bool m_stopping{false};
+        bool m_stepping{false}; // a step was started and not finished, the changes to the world are queued
+        size_t m_bodyCount{0}; // of the world when the last batch started, read while the physic thread runs
+        std::vector<std::function<void()>> m_commands;
+
+        std::vector<Box2dBodyInfo> m_bodyList; // packed, the awake bodies are synced in one pass over it
+        std::vector<unsigned int> m_bodySlots; // index in m_bodyList of each slot
+        std::vector<unsigned int> m_bodyGenerations; // raised when the body of a slot is destroyed, stale ids fail
+        std::vector<unsigned int> m_freeSlots;
         std::set<b2Body*> m_scheduledBodyRemoval;
         std::set<b2Fixture*> m_scheduledFixtureRemoval;
-        std::list<ContactInfo*> m_contactList;
+
+        std::vector<ContactEvent> m_contacts; // ring buffer, allocated once
+        size_t m_contactHead{0};
+        size_t m_contactCount{0};
+        size_t m_droppedContacts{0};
+        std::vector<ContactOrder> m_contactOrder; // sorted to group the callbacks
+        std::vector<std::pair<float, float>> m_contactPoints; // reused for each OnCollisionEnter
     };
 }
 
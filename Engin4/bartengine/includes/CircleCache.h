@@ -0,0 +1,51 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: CircleCache.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef BART_CIRCLECACHE_H
+#define BART_CIRCLECACHE_H
+
+#include <Point.h>
+#include <map>
+#include <vector>
+
+namespace bart
+{
+    // Outline pixels of circles, relative to the center, computed once per radius
+    class CircleCache
+    {
+    public:
+        const std::vector<Point>& GetOutline(float aRadius);
+        void Clear();
+
+        static const size_t MAX_RADII; // distinct radii kept before the cache starts over
+
+    private:
+        std::map<float, std::vector<Point>> m_Outlines;
+    };
+}
+
+#endif
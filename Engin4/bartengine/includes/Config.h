@@ -53,11 +53,21 @@
 #define USE_SDL_ENGINE
 #define DEBUG_CACHES 1
 
+// Atlas manifests are looked up per scene: ATLAS_FOLDER + scene id + ".xml"
+#define ATLAS_FOLDER std::string("Assets/Atlas/")
+
+// Draws with SoftwareGraphics on the CPU instead of the SDL renderer
+#define USE_SOFTWARE_RENDERER 0
+// Threads drawing the software frame, 0 uses one per core
+#define SOFTWARE_RENDER_THREADS 0
+
 // https://kinddragon.github.io/vld/
 #define USE_VLD 0
 
 #ifdef USE_SDL_ENGINE
 #include <SdlGraphics.h>
+#include <SoftwareGraphics.h>
+#include <OffscreenGraphics.h>
 #include <SdlAudio.h>
 #include <SdlInput.h>
 #include <SdlTimer.h>
@@ -70,7 +80,12 @@
 #define CREATE_LOGGER(x) x = new FileLogger();
 #endif
 
+#if USE_SOFTWARE_RENDERER
+#define CREATE_GRAPHIC(x) x = new SoftwareGraphics();
+#else
 #define CREATE_GRAPHIC(x) x = new SdlGraphics();
+#endif
+#define CREATE_OFFSCREEN_GRAPHIC(x) x = new OffscreenGraphics();
 #define CREATE_AUDIO(x) x = new SdlAudio();
 #define CREATE_INPUT(x) x = new SdlInput();
 #define CREATE_TIMER(x) x = new SdlTimer();
@@ -78,6 +93,7 @@
 #define USE_NULL_ENGINE
 
 #define CREATE_GRAPHIC(x) x = new NullGraphic();
+#define CREATE_OFFSCREEN_GRAPHIC(x) CREATE_GRAPHIC(x)
 #define CREATE_AUDIO(x) x = new NullAudio();
 #define CREATE_INPUT(x) x = new NullInput();
 #define CREATE_TIMER(x) x = new NullTimer();
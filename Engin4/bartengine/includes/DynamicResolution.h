@@ -0,0 +1,75 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: DynamicResolution.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef BART_DYNAMICRESOLUTION_H
+#define BART_DYNAMICRESOLUTION_H
+
+#include <vector>
+
+namespace bart
+{
+    class RenderGraph;
+
+    // Renders the world pass into a smaller target when the frames take longer than the budget, the upscale pass
+    // then stretches it over the window. The passes added after (the UI layers) stay at the native resolution
+    class DynamicResolution
+    {
+    public:
+        void Initialize(RenderGraph& aGraph, size_t aWorldPass);
+        void Enable(float aBudget, float aMinScale, float aMaxScale);
+        void Disable();
+        bool IsEnabled() const { return m_Enabled; }
+        void BeginScene() const;
+        void EndScene() const;
+        void AddFrameTime(float aMilliseconds);
+        float GetScale() const { return m_Scale; }
+
+        static const size_t HISTORY_SIZE; // frames averaged at a scale before it changes again
+        static const float SCALE_STEP; // change of the scale at once, it also bounds the sizes the pool sees
+        static const float HEADROOM; // part of the budget a larger scale must fit in
+
+    private:
+        void Upscale(RenderGraph& aGraph);
+        void ResizeScene();
+
+        RenderGraph* m_Graph{nullptr};
+        size_t m_WorldPass{0};
+        size_t m_UpscalePass{0};
+        size_t m_Scene{0};
+        bool m_Enabled{false};
+        float m_Budget{16.0f}; // milliseconds
+        float m_MinScale{0.5f};
+        float m_MaxScale{1.0f};
+        float m_Scale{1.0f};
+        int m_Width{0}; // of the window, before its own scale
+        int m_Height{0};
+        int m_SceneWidth{0};
+        int m_SceneHeight{0};
+        std::vector<float> m_FrameTimes; // since the last change of the scale
+    };
+}
+
+#endif
@@ -37,6 +37,11 @@
 #include <string>
 #include <ICollision.h>
 #include <IPhysic.h>
+#include <RenderGraph.h>
+#include <DynamicResolution.h>
+#include <AnimationSystem.h>
+#include <ParticleSystem.h>
+#include <BodySync.h>
 
 namespace bart
 {
@@ -47,10 +52,12 @@ namespace bart
         bool Initialize(const std::string& aTitle, int aWidth, int aHeight);
         bool Initialize(const std::string& aTitle, int aWidth, int aHeight, EWindowState aState);
         void Start();
+        void RunFrames(int aFrameCount, float aDeltaTime);
+        bool RunComparison(const std::string& aTexture);
         void Stop();
         void ProcessInput() const;
-        void Update(float aDeltaTime) const;
-        void Render() const;
+        void Update(float aDeltaTime);
+        void Render();
         IAudio& GetAudio() const { return *m_AudioService; }
         IGraphic& GetGraphic() const { return *m_GraphicService; }
         IInput& GetInput() const { return *m_InputService; }
@@ -59,11 +66,16 @@ namespace bart
         IScene& GetScene() const { return *m_SceneService; }
         ICollision& GetCollision() const { return *m_CollisionService; }
         IPhysic& GetPhysic() const { return *m_PhysicService; }
+        RenderGraph& GetRenderGraph() { return m_RenderGraph; }
+        DynamicResolution& GetResolution() { return m_Resolution; }
+        AnimationSystem& GetAnimations() { return m_Animations; }
+        ParticleSystem& GetParticles() { return m_Particles; }
+        BodySync& GetBodySync() { return m_BodySync; }
 
     private:
         Engine() = default;
         void Clean();
-        void CreateServices();
+        void CreateServices(EWindowState aState);
         bool InitializeServices();
 
         IAudio* m_AudioService{nullptr};
@@ -74,6 +86,11 @@ namespace bart
         IScene* m_SceneService{nullptr};
         ICollision* m_CollisionService{nullptr};
         IPhysic* m_PhysicService{nullptr};
+        RenderGraph m_RenderGraph;
+        DynamicResolution m_Resolution;
+        AnimationSystem m_Animations;
+        ParticleSystem m_Particles;
+        BodySync m_BodySync;
 
         bool m_IsInitialized{false};
         bool m_IsRunning{false};
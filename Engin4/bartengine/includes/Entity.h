@@ -45,6 +45,7 @@ namespace bart
         virtual bool CanUpdate() = 0;
         virtual void Start() = 0;
         virtual void Destroy() = 0;
+        virtual bool GetBounds(Rectangle* aBounds) const; // world space bounds used to cull the drawing, false to always draw
         bool IsActive() const { return m_IsActive; }
         void SetActive(const bool aEnabled) { m_IsActive = aEnabled; }
         std::string GetName() const { return m_Name; }
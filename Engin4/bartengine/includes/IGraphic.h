@@ -31,8 +31,11 @@
 #include <IService.h>
 #include <Rectangle.h>
 #include <Point.h>
+#include <RenderStats.h>
+#include <OverdrawAnalyzer.h>
 #include <Circle.h>
 #include <string>
+#include <vector>
 #include "Transform.h"
 
 using namespace std;
@@ -42,7 +45,7 @@ namespace bart
     struct Color;
     class Camera;
 
-    enum EWindowState { FULLSCREEN, BORDERLESS, WINDOWED };
+    enum EWindowState { FULLSCREEN, BORDERLESS, WINDOWED, OFFSCREEN };
 
     class IGraphic : public IService
     {
@@ -51,6 +54,8 @@ namespace bart
 
         virtual bool InitWindow(const string& aTitle, int aWidth, int aHeight, EWindowState aState) = 0;
         virtual void Clear() = 0;
+        virtual void Clear(const Color& aColor) = 0;
+        virtual void Clear(const Color& aColor, const Rectangle& aRegion) = 0; // replaces the pixels of the region, ignores the camera
         virtual void Present() = 0;
         virtual void SetColor(unsigned char aRed, unsigned char aGreen, unsigned char aBlue, unsigned char aAlpha) = 0;
         virtual void SetClearColor(unsigned char aRed, unsigned char aGreen, unsigned char aBlue) = 0;
@@ -66,19 +71,41 @@ namespace bart
         virtual void Draw(int aX, int aY, float aRadius) = 0;
         virtual void Draw(const Point& aPoint) = 0;
         virtual void Draw(int aX, int aY) = 0;
+        virtual void DrawRects(const Rectangle* aRects, size_t aCount) = 0;
+        virtual void FillRects(const Rectangle* aRects, size_t aCount) = 0;
+        virtual void DrawPoints(const Point* aPoints, size_t aCount) = 0;
+        virtual void DrawLines(const Point* aPoints, size_t aCount) = 0; // a line from each point to the next one
+        virtual void DrawCircles(const Circle* aCircles, size_t aCount) = 0;
+        virtual void DrawSprites(size_t aTexture, const Rectangle& aSrc, const Rectangle* aDst, const Color* aTints, size_t aCount) = 0; // one region, tinted copies
         virtual void Draw(size_t aTexture, const Rectangle& aSrc, const Rectangle& aDst, float aAngle, bool aHorizontalFlip, bool aVerticalFlip, unsigned char aAlpha) = 0;
         virtual void Draw(size_t aFont, const std::string& aText, int aX, int aY) = 0;
+        virtual void Draw(size_t aFont, const std::string& aText, int aX, int aY, int aWrapWidth) = 0;
+        virtual void Draw(size_t aFont, const std::string& aText, int aX, int aY, const Color& aColor) = 0;
         virtual void GetTextureSize(size_t aTextureId, int* aWidth, int* aHeight) = 0;
+        virtual bool IsRegionOpaque(size_t aTextureId, const Rectangle& aRegion) = 0;
+        virtual void SetBlending(bool aEnabled) = 0; // disabled, textures are copied without alpha blending
         virtual void GetFontSize(size_t aFontId, const string& aText, int* aWidth, int* aHeight) = 0;
         virtual int GetTextureInCache() const = 0;
         virtual int GetFontInCache() const = 0;
         virtual void SetCamera(Camera* aCamera) = 0;
+        virtual Camera* GetCamera() const = 0;
         virtual void SetViewport(int aX, int aY, int aWidth, int aHeight) = 0;
-        virtual void ScaleViewport(float aX, float aY) = 0;
+        virtual void ScaleViewport(float aX, float aY) = 0; // with a render target bound, scales that target each time it is bound
+        virtual void GetViewportScale(float* aX, float* aY) = 0; // of the window
+        virtual size_t CreateRenderTarget(int aWidth, int aHeight) = 0; // released with UnloadTexture
+        virtual bool SetRenderTarget(size_t aTarget) = 0; // 0 for the window
+        virtual size_t GetRenderTarget() const = 0;
         virtual void GetScreenSize(int* aWidth, int* aHeight) = 0;
         virtual void GetWindowSize(int* aWidth, int* aHeight) = 0;
         virtual void SetWindowState(EWindowState aState) = 0;
-        virtual void Draw(Transform* transform) = 0;
+        virtual void Draw(Transform* transform) = 0; // outlines are batched and drawn over the frame when presented
+        virtual bool LoadAtlas(const string& aManifest) = 0;
+        virtual bool BuildAtlas(const vector<string>& aFiles, int aPadding) = 0;
+        virtual void UnloadAtlas() = 0;
+        virtual RenderStats& GetRenderStats() = 0;
+        virtual void ShowRenderStats(size_t aFont) = 0;
+        virtual OverdrawAnalyzer& GetOverdrawAnalyzer() = 0;
+        virtual void ShowOverdraw(bool aEnabled) = 0; // counts the pixel writes and draws them as a heat map
     };
 }
 
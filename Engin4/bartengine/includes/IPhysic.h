@@ -43,14 +43,31 @@ namespace bart
         END_CONTACT
     };
 
-    struct ContactInfo
+    // Transforms of many bodies, one array per field, filled by IPhysic::SyncTransforms. The caller keeps it from one
+    // frame to the next so the arrays are reused
+    struct BodyTransforms
     {
-        EContactType ContactType;
-        bart::Entity* EntityA;
-        bart::Entity* EntityB;
-        std::vector<std::pair<float, float>> ContactPoints;
-        float NormalX;
-        float NormalY;
+        std::vector<size_t> Ids;
+        std::vector<float> X; // world units, the top left corner like GetTransform
+        std::vector<float> Y;
+        std::vector<float> Angle; // degrees
+        size_t Count{0};
+    };
+
+    // The broad phase keeps the static bodies in a tree of their own, built again with the surface area heuristic once a
+    // map has loaded them. The quality is the sum of the node perimeters over the root perimeter, lower is better
+    struct BroadPhaseStats
+    {
+        int StaticProxies{0};
+        int DynamicProxies{0};
+        int StaticHeight{0};
+        int DynamicHeight{0};
+        float StaticQuality{0.0f};
+        float DynamicQuality{0.0f};
+        int StaticQueries{0}; // moved proxies looked up in the static tree by the last Update
+        int DynamicQueries{0};
+        int Pairs{0}; // candidate pairs found by the last Update, duplicates included
+        int StaticRebuilds{0};
     };
 
     class IPhysic : public IService
@@ -62,15 +79,19 @@ namespace bart
         virtual void SetGravity(float aX, float aY) = 0;
         virtual void Awake(bool aValue) = 0;
         virtual size_t CreateBody(const PhysicMaterial& aMaterial) = 0;
-        virtual void GetTransform(size_t aId, float* aX, float* aY, float* aAngle) = 0;
-        virtual void SetTransform(size_t aId, float aX, float aY, float aAngle) = 0;
+        virtual void GetTransform(size_t aId, float* aX, float* aY, float* aAngle) = 0; // after the last step
+        virtual void GetInterpolatedTransform(size_t aId, float* aX, float* aY, float* aAngle) = 0; // to draw, not to set back
+        virtual void SetTransform(size_t aId, float aX, float aY, float aAngle) = 0; // applied after the steps running on the physic thread, replaces their result
+        virtual size_t SyncTransforms(BodyTransforms& aTransforms) = 0; // the moving bodies, returns the count
         virtual size_t GetBodyCount() = 0;
         virtual void ApplyImpulse(size_t aId, float aX, float aY, bool aWorld) = 0;
         virtual void ApplyForce(size_t aId, float aX, float aY, bool aWorld) = 0;
         virtual void ApplyAngularImpulse(size_t aId, float aImpulse) = 0;
         virtual void ApplyTorque(size_t aId, float aTorque) = 0;
         virtual void DestroyBody(size_t aId) = 0;
-        virtual void Update() = 0;
+        virtual void Update(float aDelta) = 0; // simulates the elapsed time in fixed steps
+        virtual void SetStep(float aStep, int aMaxSubsteps) = 0; // seconds per step, steps at most per Update
+        virtual void SetIterations(int aVelocity, int aPosition) = 0; // fewer is faster but less accurate
         virtual void SetGravityScale(size_t aId, float aScale) = 0;
         virtual float GetMass(size_t aId) = 0;
         virtual void SetMass(size_t aId, float aMass) = 0;
@@ -84,7 +105,12 @@ namespace bart
         virtual void SetSensor(size_t aId, bool aSensor) = 0;
         virtual void SetRestitution(size_t aId, float aRestitution) = 0;
         virtual void ClearWorld() = 0;
-        virtual void AddContactInfo(ContactInfo* aContactInfo) = 0;
+        virtual void SetThreaded(bool aThreaded) = 0; // steps on a thread of its own, overlapped with the frame
+        virtual void SetSolverThreads(int aThreads) = 0; // threads solving the islands of a step, same result for any count
+        virtual void SetWideSolver(bool aWide) = 0; // solves the contacts several at a time with SIMD instructions
+        virtual void SetWideCollide(bool aWide) = 0; // computes the box manifolds several at a time with SIMD instructions
+        virtual float GetStepMilliseconds() = 0; // time spent by the steps the last Update finished, on the physic thread too
+        virtual const BroadPhaseStats& GetBroadPhaseStats() = 0; // after the last Update
 
     protected:
         virtual void DestroyFixture(size_t aId) = 0;
@@ -43,6 +43,8 @@ namespace bart
         void Clean() override;
         bool InitWindow(const string& aTitle, int aWidth, int aHeight, EWindowState aState) override;
         void Clear() override;
+        void Clear(const Color& aColor) override;
+        void Clear(const Color& aColor, const Rectangle& aRegion) override;
         void Present() override;
         void SetColor(unsigned char aRed, unsigned char aGreen, unsigned char aBlue, unsigned char aAlpha) override;
         void SetClearColor(unsigned char aRed, unsigned char aGreen, unsigned char aBlue) override;
@@ -56,21 +58,47 @@ namespace bart
         void Draw(int aX, int aY, float aRadius) override;
         void Draw(const Point& aPoint) override;
         void Draw(int aX, int aY) override;
+        void DrawRects(const Rectangle* aRects, size_t aCount) override;
+        void FillRects(const Rectangle* aRects, size_t aCount) override;
+        void DrawPoints(const Point* aPoints, size_t aCount) override;
+        void DrawLines(const Point* aPoints, size_t aCount) override;
+        void DrawCircles(const Circle* aCircles, size_t aCount) override;
+        void DrawSprites(size_t aTexture, const Rectangle& aSrc, const Rectangle* aDst, const Color* aTints, size_t aCount) override;
         void Draw(size_t aTexture, const Rectangle& aSrc, const Rectangle& aDst, float aAngle, bool aHorizontalFlip, bool aVerticalFlip, unsigned char aAlpha) override;
         void Draw(size_t aFont, const string& aText, int aX, int aY) override;
+        void Draw(size_t aFont, const string& aText, int aX, int aY, int aWrapWidth) override;
+        void Draw(size_t aFont, const string& aText, int aX, int aY, const Color& aColor) override;
         void GetTextureSize(size_t aTextureId, int* aWidth, int* aHeight) override;
+        bool IsRegionOpaque(size_t aTextureId, const Rectangle& aRegion) override;
+        void SetBlending(bool aEnabled) override;
         void GetFontSize(size_t aFontId, const string& aText, int* aWidth, int* aHeight) override;
         void GetScreenSize(int* aWidth, int* aHeight) override;
         void GetWindowSize(int* aWidth, int* aHeight) override;
         int GetTextureInCache() const override;
         int GetFontInCache() const override;
         void SetCamera(Camera* aCamera) override;
+        Camera* GetCamera() const override;
         void Fill(const Rectangle& aRect) override;
         void Fill(int aX, int aY, int aWidth, int aHeight) override;
         void SetViewport(int aX, int aY, int aWidth, int aHeight) override;
         void ScaleViewport(float aX, float aY) override;
+        void GetViewportScale(float* aX, float* aY) override;
+        size_t CreateRenderTarget(int aWidth, int aHeight) override;
+        bool SetRenderTarget(size_t aTarget) override;
+        size_t GetRenderTarget() const override;
         void SetWindowState(EWindowState aState) override;
         void Draw(Transform* transform) override;
+        bool LoadAtlas(const string& aManifest) override;
+        bool BuildAtlas(const vector<string>& aFiles, int aPadding) override;
+        void UnloadAtlas() override;
+        RenderStats& GetRenderStats() override;
+        void ShowRenderStats(size_t aFont) override;
+        OverdrawAnalyzer& GetOverdrawAnalyzer() override;
+        void ShowOverdraw(bool aEnabled) override;
+
+    private:
+        RenderStats m_Stats;
+        OverdrawAnalyzer m_Overdraw;
     };
 }
 
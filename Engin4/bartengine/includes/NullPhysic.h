@@ -44,14 +44,18 @@ namespace bart
         void Awake(bool aValue) override;
         size_t CreateBody(const PhysicMaterial& aMaterial) override;
         void GetTransform(size_t aId, float* aX, float* aY, float* aAngle) override;
+        void GetInterpolatedTransform(size_t aId, float* aX, float* aY, float* aAngle) override;
         void SetTransform(size_t aId, float aX, float aY, float aAngle) override;
+        size_t SyncTransforms(BodyTransforms& aTransforms) override;
         void ApplyImpulse(size_t aId, float aX, float aY, bool aWorld) override;
         void ApplyForce(size_t aId, float aX, float aY, bool aWorld) override;
         void ApplyTorque(size_t aId, float aTorque) override;
         void ApplyAngularImpulse(size_t aId, float aImpulse) override;
         void DestroyBody(size_t aId) override;
         size_t GetBodyCount() override;
-        void Update() override;
+        void Update(float aDelta) override;
+        void SetStep(float aStep, int aMaxSubsteps) override;
+        void SetIterations(int aVelocity, int aPosition) override;
         void SetGravityScale(size_t aId, float aScale) override;
         float GetMass(size_t aId) override;
         void SetMass(size_t aId, float aMass) override;
@@ -65,10 +69,18 @@ namespace bart
         void SetAngularVelocity(size_t aId, float aVelocity) override;
         float GetAngularVelocity(size_t aId) override;
         void ClearWorld() override;
-        void AddContactInfo(ContactInfo* aContactInfo) override;
+        void SetThreaded(bool aThreaded) override;
+        void SetSolverThreads(int aThreads) override;
+        void SetWideSolver(bool aWide) override;
+        void SetWideCollide(bool aWide) override;
+        float GetStepMilliseconds() override { return 0.0f; }
+        const BroadPhaseStats& GetBroadPhaseStats() override { return m_BroadPhaseStats; }
 
     protected:
         void DestroyFixture(size_t aId) override;
+
+    private:
+        BroadPhaseStats m_BroadPhaseStats;
     };
 }
 
@@ -0,0 +1,74 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: OffscreenGraphics.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef BART_OFFSCREENGRAPHICS_H
+#define BART_OFFSCREENGRAPHICS_H
+
+#include <SoftwareGraphics.h>
+
+namespace bart
+{
+    // Software renderer without window, every frame can be hashed or saved for comparisons
+    class OffscreenGraphics final : public SoftwareGraphics
+    {
+    public:
+        OffscreenGraphics() = default;
+        virtual ~OffscreenGraphics() = default;
+        bool Initialize() override;
+        void Clean() override;
+        void GetScreenSize(int* aWidth, int* aHeight) override;
+        void GetWindowSize(int* aWidth, int* aHeight) override;
+
+        void SetHashLogging(bool aEnabled);
+        void SetFrameDumps(const string& aFolder, unsigned int aInterval);
+        void DumpNextFrame(const string& aFilename);
+        unsigned long long GetFrameHash() const { return m_FrameHash; }
+        unsigned long long GetSequenceHash() const { return m_SequenceHash; }
+        unsigned int GetPresentedFrames() const { return m_PresentedFrames; }
+        const SoftwareSurface& GetFrame() const { return m_Frame; }
+
+    protected:
+        bool CreateOutput(const string& aTitle, int aWidth, int aHeight, EWindowState aState) override;
+        void PresentOutput() override;
+        void DestroyOutput() override;
+
+    private:
+        bool SaveFrame(const string& aFilename) const;
+
+        static unsigned long long HashFrame(const SoftwareSurface& aFrame);
+
+        bool m_HashLogging{false};
+        string m_DumpFolder;
+        unsigned int m_DumpInterval{0}; // 0 saves no frame
+        string m_NextDump;
+        unsigned long long m_FrameHash{0};
+        unsigned long long m_SequenceHash{0};
+        unsigned int m_PresentedFrames{0};
+    };
+}
+
+#endif
@@ -0,0 +1,81 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: OverdrawAnalyzer.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef BART_OVERDRAWANALYZER_H
+#define BART_OVERDRAWANALYZER_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace bart
+{
+    // Counts how many times each screen pixel is written during a frame
+    class OverdrawAnalyzer
+    {
+    public:
+        struct ScopeStats
+        {
+            unsigned long long Written{0}; // pixels written by the scope
+            unsigned long long Overdrawn{0}; // pixels written over a pixel already written this frame
+        };
+
+        typedef std::map<std::string, ScopeStats> TScopeMap;
+
+        void SetEnabled(bool aEnabled);
+        bool IsEnabled() const { return m_Enabled; }
+        void Resize(int aWidth, int aHeight);
+        void SetScope(const std::string& aScope);
+        const std::string& GetScope() const { return m_Scope; }
+        void Add(int aX, int aY, int aWidth, int aHeight);
+        void EndFrame();
+
+        int GetWidth() const { return m_Width; }
+        int GetHeight() const { return m_Height; }
+        unsigned long long GetPixelsWritten() const { return m_LastWritten; }
+        unsigned long long GetPixelsCovered() const { return m_LastCovered; }
+        float GetOverdrawRatio() const;
+        const TScopeMap& GetScopes() const { return m_LastScopes; }
+        void GetHeatmap(std::vector<unsigned int>* aPixels) const;
+        std::string ToString() const;
+
+    private:
+        bool m_Enabled{false};
+        int m_Width{0};
+        int m_Height{0};
+        std::vector<unsigned short> m_Counts;
+        std::vector<unsigned short> m_LastCounts;
+        std::string m_Scope;
+        ScopeStats* m_ScopeStats{nullptr};
+        TScopeMap m_Scopes;
+        TScopeMap m_LastScopes;
+        unsigned long long m_LastWritten{0};
+        unsigned long long m_LastCovered{0};
+    };
+}
+
+#endif
@@ -0,0 +1,109 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: ParticleEmitter.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef BART_PARTICLEEMITTER_H
+#define BART_PARTICLEEMITTER_H
+
+#include <Color.h>
+#include <Rectangle.h>
+#include <string>
+#include <vector>
+
+namespace bart
+{
+    class Transform;
+
+    struct ParticleSettings
+    {
+        float Rate{100.0f}; // particles per second
+        float MinLife{0.5f}; // seconds
+        float MaxLife{1.0f};
+        float MinSpeed{50.0f}; // pixels per second
+        float MaxSpeed{100.0f};
+        float Direction{-90.0f}; // degrees, 0 is to the right and 90 down
+        float Spread{360.0f}; // degrees around the direction
+        float GravityX{0.0f}; // pixels per second squared
+        float GravityY{0.0f};
+        Color StartColor;
+        Color EndColor;
+        float StartSize{4.0f}; // pixels
+        float EndSize{4.0f};
+        size_t Capacity{1024}; // particles alive at once
+    };
+
+    // Particles of one texture, kept as one array per attribute and updated 4 at a time. Drawn in a single batch
+    class ParticleEmitter
+    {
+    public:
+        ParticleEmitter(const ParticleSettings& aSettings, unsigned int aSeed);
+        bool Load(const std::string& aFilename);
+        void Unload();
+        void SetSettings(const ParticleSettings& aSettings);
+        const ParticleSettings& GetSettings() const { return m_Settings; }
+        void SetPosition(float aX, float aY);
+        void Attach(const Transform* aTransform); // emits from the center of the transform, nullptr to detach
+        void SetEmitting(bool aEmitting) { m_Emitting = aEmitting; }
+        void Burst(size_t aCount);
+        void Clear() { m_Count = 0; }
+
+        size_t Update(float aDelta, size_t aBudget); // returns the particles spawned, at most aBudget
+        void Draw();
+
+        size_t GetCount() const { return m_Count; }
+        size_t GetDropped() const { return m_Dropped; } // particles not spawned by the last Update, over a capacity
+
+    private:
+        size_t Spawn(size_t aCount);
+        float Random(float aMin, float aMax);
+        void Resize();
+
+        ParticleSettings m_Settings;
+        size_t m_Texture{0};
+        Rectangle m_Source;
+        const Transform* m_Transform{nullptr};
+        float m_X{0.0f};
+        float m_Y{0.0f};
+        float m_Debt{0.0f}; // fraction of particle not emitted yet
+        size_t m_Bursts{0};
+        bool m_Emitting{true};
+        size_t m_Count{0};
+        size_t m_Dropped{0};
+        unsigned int m_Seed;
+
+        // One entry per particle, padded to a multiple of 4
+        std::vector<float> m_PosX;
+        std::vector<float> m_PosY;
+        std::vector<float> m_VelX;
+        std::vector<float> m_VelY;
+        std::vector<float> m_Age;
+        std::vector<float> m_InvLife;
+
+        std::vector<Rectangle> m_Destinations;
+        std::vector<Color> m_Tints;
+    };
+}
+
+#endif
@@ -0,0 +1,69 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: ParticleSystem.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef BART_PARTICLESYSTEM_H
+#define BART_PARTICLESYSTEM_H
+
+#include <ParticleEmitter.h>
+#include <vector>
+
+namespace bart
+{
+    // Owns the particle emitters, updates them after the scene and draws them over it. The particles alive in all
+    // emitters are bounded, the emitters spawn nothing more once the bound is reached
+    class ParticleSystem
+    {
+    public:
+        struct Stats
+        {
+            size_t Emitters{0};
+            size_t Alive{0};
+            size_t Spawned{0}; // by the last Update
+            size_t Dropped{0}; // not spawned by the last Update, over a capacity or the bound
+            float UpdateMilliseconds{0.0f};
+        };
+
+        ParticleEmitter* CreateEmitter(const ParticleSettings& aSettings);
+        void DestroyEmitter(ParticleEmitter* aEmitter);
+        void Clean();
+        void SetMaxParticles(size_t aMax) { m_MaxParticles = aMax; }
+        size_t GetMaxParticles() const { return m_MaxParticles; }
+
+        void Update(float aDelta);
+        void Draw();
+        const Stats& GetStats() const { return m_Stats; }
+
+        static const size_t DEFAULT_MAX_PARTICLES;
+
+    private:
+        std::vector<ParticleEmitter*> m_Emitters;
+        size_t m_MaxParticles{DEFAULT_MAX_PARTICLES};
+        unsigned int m_NextSeed{1};
+        Stats m_Stats;
+    };
+}
+
+#endif
@@ -0,0 +1,74 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: RenderComparison.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef BART_RENDERCOMPARISON_H
+#define BART_RENDERCOMPARISON_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace bart
+{
+    class IGraphic;
+    class Camera;
+    class OffscreenGraphics;
+
+    // Draws the same cases with the software renderer and with SdlGraphics on the SDL software renderer, then counts
+    // the pixels that differ. Both run without a display on the dummy video driver
+    class RenderComparison
+    {
+    public:
+        bool Run(OffscreenGraphics& aSoftware, const string& aTexture);
+
+    private:
+        typedef void (*TDrawCase)(IGraphic& aGraphic, size_t aTexture, Camera& aCamera);
+
+        struct DrawCase
+        {
+            const char* Name;
+            TDrawCase Draw;
+            float MaxMismatch; // fraction of the pixels allowed to differ, rotations are not sampled the same way
+        };
+
+        static void DrawFills(IGraphic& aGraphic, size_t aTexture, Camera& aCamera);
+        static void DrawCopies(IGraphic& aGraphic, size_t aTexture, Camera& aCamera);
+        static void DrawCamera(IGraphic& aGraphic, size_t aTexture, Camera& aCamera);
+        static void DrawFlips(IGraphic& aGraphic, size_t aTexture, Camera& aCamera);
+        static void DrawAlpha(IGraphic& aGraphic, size_t aTexture, Camera& aCamera);
+        static void DrawRotations(IGraphic& aGraphic, size_t aTexture, Camera& aCamera);
+        static void DrawStretch(IGraphic& aGraphic, size_t aTexture, Camera& aCamera);
+        static int CountMismatches(const vector<unsigned int>& aFrame, const vector<unsigned int>& aReference, int* aMaxDelta);
+
+        static const DrawCase CASES[];
+        static const int CASE_COUNT;
+        static const int CHANNEL_TOLERANCE; // rounding of the blending differs by a unit or two
+    };
+}
+
+#endif
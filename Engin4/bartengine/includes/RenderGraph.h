@@ -0,0 +1,120 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: RenderGraph.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef BART_RENDERGRAPH_H
+#define BART_RENDERGRAPH_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bart
+{
+    // Passes declare the render target they draw to and the ones they read. Every frame the passes that do not
+    // contribute to the window are culled, the others run in the order they were added with their output bound.
+    // Transient targets come from a pool shared by the passes and the frames, a persistent target keeps its
+    // content from one frame to the next (caches)
+    class RenderGraph
+    {
+    public:
+        typedef std::function<void(RenderGraph&)> TPassFunction;
+
+        struct PassStats
+        {
+            std::string Name;
+            float Milliseconds{0.0f}; // time spent submitting the pass, the GPU work is not measured
+            bool Culled{false};
+        };
+
+        void Clean();
+        size_t AddResource(const std::string& aName, int aWidth, int aHeight, bool aPersistent);
+        void RemoveResource(size_t aResource);
+        void SetResourceSize(size_t aResource, int aWidth, int aHeight); // a persistent resource loses its content
+        size_t AddPass(const std::string& aName, const TPassFunction& aExecute);
+        void RemovePass(size_t aPass);
+        void SetOutput(size_t aPass, size_t aResource);
+        void AddInput(size_t aPass, size_t aResource);
+        void SetEnabled(size_t aPass, bool aEnabled);
+        void Execute();
+
+        size_t GetTarget(size_t aResource) const; // during the passes, the render target to draw a resource
+        bool IsNewTarget(size_t aResource) const; // the previous content of a persistent resource was lost
+        const std::vector<PassStats>& GetStats() const { return m_Stats; } // of the last execution
+        size_t GetPooledTargets() const { return m_Pool.size(); }
+        std::string ToString() const;
+
+        static const size_t BACKBUFFER; // the target bound when the graph executes, usually the window
+        static const unsigned int POOL_LIFETIME; // frames an unused pooled target is kept
+
+    private:
+        struct Resource
+        {
+            std::string Name;
+            int Width{0};
+            int Height{0};
+            bool Persistent{false};
+            bool Removed{false};
+            bool Needed{false};
+            bool NewTarget{false};
+            size_t Target{0}; // taken from the pool, 0 while a transient resource is not in use
+            int LastUse{-1}; // last pass of the frame to use a transient resource
+        };
+
+        struct Pass
+        {
+            std::string Name;
+            TPassFunction Execute;
+            size_t Output{0};
+            std::vector<size_t> Inputs;
+            bool Enabled{true};
+            bool Removed{false};
+            bool Culled{false};
+        };
+
+        struct PooledTarget
+        {
+            size_t Target{0};
+            int Width{0};
+            int Height{0};
+            bool InUse{false};
+            unsigned int LastUsedFrame{0};
+        };
+
+        void Cull();
+        void Acquire(Resource& aResource);
+        void Release(Resource& aResource);
+        void TrimPool();
+
+        std::vector<Resource> m_Resources;
+        std::vector<Pass> m_Passes;
+        std::vector<PooledTarget> m_Pool;
+        std::vector<PassStats> m_Stats;
+        size_t m_Backbuffer{0};
+        unsigned int m_FrameCount{0};
+    };
+}
+
+#endif
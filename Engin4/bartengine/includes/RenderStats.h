@@ -0,0 +1,87 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: RenderStats.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef BART_RENDERSTATS_H
+#define BART_RENDERSTATS_H
+
+#include <string>
+
+namespace bart
+{
+    enum ERenderCounter
+    {
+        DRAW_RECTANGLE,
+        FILL_RECTANGLE,
+        DRAW_POINT,
+        DRAW_LINE,
+        DRAW_TEXTURE,
+        DRAW_TEXT,
+        DRAW_TRANSFORM,
+        TEXTURE_SWITCHES,
+        STATE_CHANGES,
+        PIXELS_FILLED,
+        TEXT_RASTERIZED,
+        PRIMITIVES_BATCHED,
+        ENTITIES_DRAWN,
+        ENTITIES_CULLED,
+        PARTICLES_DRAWN,
+        RENDER_COUNTER_COUNT
+    };
+
+    // Per frame counters of a graphic service, with an average over the last frames
+    class RenderStats
+    {
+    public:
+        RenderStats();
+
+        void Add(ERenderCounter aCounter, unsigned long long aValue = 1);
+        void NextFrame();
+        void Reset();
+
+        unsigned long long GetCurrent(ERenderCounter aCounter) const;
+        unsigned long long GetLast(ERenderCounter aCounter) const;
+        float GetAverage(ERenderCounter aCounter) const;
+        unsigned long long GetDrawCalls() const;
+        float GetAverageDrawCalls() const;
+        unsigned int GetFrameCount() const { return m_FrameCount; }
+        std::string ToString() const;
+
+        static const char* GetName(ERenderCounter aCounter);
+
+        static const int HISTORY_SIZE = 60; // frames in the rolling average
+
+    private:
+        unsigned long long m_Current[RENDER_COUNTER_COUNT];
+        unsigned long long m_History[HISTORY_SIZE][RENDER_COUNTER_COUNT];
+        unsigned long long m_Sum[RENDER_COUNTER_COUNT];
+        int m_HistoryIndex{0};
+        int m_HistoryCount{0};
+        unsigned int m_FrameCount{0};
+    };
+}
+
+#endif
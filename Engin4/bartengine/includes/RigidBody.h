@@ -39,9 +39,9 @@ namespace bart
     {
     public:
         explicit RigidBody(Entity* aParent);
-        virtual ~RigidBody() = default;
+        virtual ~RigidBody();
         void Create(Transform* aTransform);
-        void Create(const PhysicMaterial& aMaterial);
+        void Create(const PhysicMaterial& aMaterial); // no transform follows the body
         void Create(EBodyType aBody, EShapeType aShape, Transform* aTransform);
 
         void Update(Transform* aTransform, float aDelta) override;
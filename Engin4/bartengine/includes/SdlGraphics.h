@@ -32,11 +32,13 @@
 #include <map>
 #include <Resource.h>
 #include <Color.h>
+#include <CircleCache.h>
 #include <vector>
 
 struct SDL_Texture;
 struct SDL_Renderer;
 struct SDL_Window;
+struct SDL_Surface;
 typedef struct _TTF_Font TTF_Font;
 struct FC_Font;
 
@@ -51,6 +53,8 @@ namespace bart
         void Clean() override;
         bool InitWindow(const string& aTitle, int aWidth, int aHeight, EWindowState aState) override;
         void Clear() override;
+        void Clear(const Color& aColor) override;
+        void Clear(const Color& aColor, const Rectangle& aRegion) override;
         void Present() override;
         void SetColor(unsigned char aRed, unsigned char aGreen, unsigned char aBlue, unsigned char aAlpha) override;
         void SetClearColor(unsigned char aRed, unsigned char aGreen, unsigned char aBlue) override;
@@ -64,36 +68,157 @@ namespace bart
         void Draw(int aX, int aY, float aRadius) override;
         void Draw(const Point& aPoint) override;
         void Draw(int aX, int aY) override;
+        void DrawRects(const Rectangle* aRects, size_t aCount) override;
+        void FillRects(const Rectangle* aRects, size_t aCount) override;
+        void DrawPoints(const Point* aPoints, size_t aCount) override;
+        void DrawLines(const Point* aPoints, size_t aCount) override;
+        void DrawCircles(const Circle* aCircles, size_t aCount) override;
+        void DrawSprites(size_t aTexture, const Rectangle& aSrc, const Rectangle* aDst, const Color* aTints, size_t aCount) override;
         void Draw(size_t aTexture, const Rectangle& aSrc, const Rectangle& aDst, float aAngle, bool aHorizontalFlip, bool aVerticalFlip, unsigned char aAlpha) override;
         void Draw(size_t aFont, const std::string& aText, int aX, int aY) override;
+        void Draw(size_t aFont, const std::string& aText, int aX, int aY, int aWrapWidth) override;
+        void Draw(size_t aFont, const std::string& aText, int aX, int aY, const Color& aColor) override;
         void GetTextureSize(size_t aTextureId, int* aWidth, int* aHeight) override;
+        bool IsRegionOpaque(size_t aTextureId, const Rectangle& aRegion) override;
+        void SetBlending(bool aEnabled) override;
         void GetFontSize(size_t aFontId, const string& aText, int* aWidth, int* aHeight) override;
         void GetScreenSize(int* aWidth, int* aHeight) override;
         void GetWindowSize(int* aWidth, int* aHeight) override;
         int GetTextureInCache() const override;
         int GetFontInCache() const override;
         void SetCamera(Camera* aCamera) override;
+        Camera* GetCamera() const override;
         void Fill(const Rectangle& aRect) override;
         void Fill(int aX, int aY, int aWidth, int aHeight) override;
         void SetViewport(int aX, int aY, int aWidth, int aHeight) override;
         void ScaleViewport(float aX, float aY) override;
+        void GetViewportScale(float* aX, float* aY) override;
+        size_t CreateRenderTarget(int aWidth, int aHeight) override;
+        bool SetRenderTarget(size_t aTarget) override;
+        size_t GetRenderTarget() const override;
         void SetWindowState(EWindowState aState) override;
         void Draw(Transform* transform) override;
+        bool LoadAtlas(const string& aManifest) override;
+        bool BuildAtlas(const vector<string>& aFiles, int aPadding) override;
+        void UnloadAtlas() override;
+        RenderStats& GetRenderStats() override;
+        void ShowRenderStats(size_t aFont) override;
+        OverdrawAnalyzer& GetOverdrawAnalyzer() override;
+        void ShowOverdraw(bool aEnabled) override;
+        bool ReadPixels(vector<unsigned int>& aPixels); // of the window before Present, ARGB as SoftwareSurface
 
     private:
-        typedef map<size_t, Resource<SDL_Texture>*> TTexMap;
-        typedef map<size_t, Resource<FC_Font>*> TFontMap;
+        // A texture in the cache, either standalone or a region of an atlas page
+        struct TextureInfo : Resource<SDL_Texture>
+        {
+            size_t Page{0};
+            int OffsetX{0};
+            int OffsetY{0};
+            int Width{0};
+            int Height{0};
+            float ScaleX{1.0f}; // of a render target, put back each time it is bound
+            float ScaleY{1.0f};
+        };
+
+        // A colored font handle, all the colors of a face share its glyph textures
+        struct FontInfo : Resource<FC_Font>
+        {
+            size_t Face{0};
+            Color Tint;
+        };
+
+        struct AtlasRegion
+        {
+            size_t Page;
+            Rectangle Bounds;
+        };
+
+        // A string laid out and rendered once, blitted as a single texture afterward
+        struct CachedText
+        {
+            SDL_Texture* Texture{nullptr};
+            size_t Face{0};
+            string Text;
+            int WrapWidth{0};
+            int Width{0};
+            int Height{0};
+            unsigned int LastUsedFrame{0};
+        };
+
+        // One bit per pixel, set when the pixel is fully opaque
+        struct OpacityMask
+        {
+            int Width{0};
+            int Height{0};
+            bool AllOpaque{false};
+            vector<unsigned char> Bits;
+        };
+
+        // Transform outlines of one color, drawn together when the frame is presented
+        struct OutlineBatch
+        {
+            Color Tint;
+            vector<float> Rects; // x, y, width and height of each outline
+        };
+
+        typedef map<size_t, TextureInfo*> TTexMap;
+        typedef map<size_t, FontInfo*> TFontMap;
+        typedef map<size_t, Resource<FC_Font>*> TFaceMap;
+        typedef map<size_t, AtlasRegion> TRegionMap;
+        typedef map<size_t, CachedText*> TTextMap;
+        typedef map<SDL_Texture*, OpacityMask> TMaskMap;
+
+        void ReleasePage(size_t aPageId);
+        void DestroyTexture(SDL_Texture* aTexture);
+        void BuildOpacityMask(SDL_Texture* aTexture, SDL_Surface* aSurface);
+        void DrawString(size_t aFont, const string& aText, int aX, int aY, int aWrapWidth, const Color& aColor);
+        CachedText* GetCachedText(size_t aFace, const string& aText, int aWrapWidth);
+        void RenderCachedText(CachedText* aText, FC_Font* aFont) const;
+        void EvictCachedText(bool aAll, size_t aFace);
+        void CountDraw(ERenderCounter aCounter, int aX, int aY, int aWidth, int aHeight);
+        void CountPixels(int aX, int aY, int aWidth, int aHeight);
+        void DrawOutlines();
+        void ApplyTargetScale() const;
+        void CountTexture(SDL_Texture* aTexture);
+        void DrawRenderStats();
+        void DrawOverdraw();
+
+        static const int ATLAS_PAGE_SIZE; // the largest atlas page created
+        static const int ATLAS_PADDING; // default padding between packed images
+        static const unsigned int TEXT_CACHE_LIFETIME; // frames an unused string stays in the text cache
 
         TTexMap m_TexCache;
         TFontMap m_FntCache;
+        TFaceMap m_FaceCache;
+        TTexMap m_AtlasPages;
+        TRegionMap m_AtlasRegions;
+        vector<size_t> m_AtlasOwnedPages;
+        size_t m_AtlasCount{0};
         SDL_Renderer* m_Renderer;
         SDL_Window* m_Window;
         Camera* m_Camera{nullptr};
-        vector<SDL_Texture*> m_FontBuffer = {nullptr, nullptr};
-        int m_FontIndex{0};
+        TTextMap m_TextCache;
+        TMaskMap m_OpacityMasks; // per texture, the atlas regions share the mask of their page
+        bool m_Blending{true};
+        unsigned int m_FrameCount{0};
         int m_ScreenWidth{0};
         int m_ScreenHeight{0};
         Color m_ClearColor;
+        Color m_DrawColor;
+        float m_ScaleX{1.0f};
+        float m_ScaleY{1.0f};
+        RenderStats m_Stats;
+        SDL_Texture* m_LastTexture{nullptr}; // last texture bound, to count the switches
+        size_t m_StatsFont{0}; // font of the statistics overlay, 0 when hidden
+        size_t m_RenderTarget{0};
+        OverdrawAnalyzer m_Overdraw;
+        SDL_Texture* m_HeatmapTexture{nullptr};
+        vector<unsigned int> m_HeatmapPixels;
+        unsigned int m_TargetCount{0};
+        CircleCache m_Circles;
+        vector<Point> m_PointBatch;
+        vector<Rectangle> m_RectBatch;
+        vector<OutlineBatch> m_Outlines;
     };
 }
 
@@ -0,0 +1,207 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: SoftwareGraphics.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef BART_SOFTWAREGRAPHICS_H
+#define BART_SOFTWAREGRAPHICS_H
+
+#include <IGraphic.h>
+#include <SoftwareRasterizer.h>
+#include <Resource.h>
+#include <Color.h>
+#include <CircleCache.h>
+#include <map>
+#include <vector>
+
+struct SDL_Window;
+struct SDL_Renderer;
+struct SDL_Texture;
+struct SDL_Surface;
+typedef struct _TTF_Font TTF_Font;
+
+namespace bart
+{
+    // Draws in a CPU frame buffer with SoftwareRasterizer, the frame goes to the window in one upload
+    class SoftwareGraphics : public IGraphic
+    {
+    public:
+        SoftwareGraphics() = default;
+        virtual ~SoftwareGraphics() = default;
+        bool Initialize() override;
+        void Clean() override;
+        bool InitWindow(const string& aTitle, int aWidth, int aHeight, EWindowState aState) override;
+        void Clear() override;
+        void Clear(const Color& aColor) override;
+        void Clear(const Color& aColor, const Rectangle& aRegion) override;
+        void Present() override;
+        void SetColor(unsigned char aRed, unsigned char aGreen, unsigned char aBlue, unsigned char aAlpha) override;
+        void SetClearColor(unsigned char aRed, unsigned char aGreen, unsigned char aBlue) override;
+        size_t LoadTexture(const string& aFilename) override;
+        void UnloadTexture(size_t aTextureId) override;
+        size_t LoadFont(const string& aFilename, int aFontSize, const Color& aColor) override;
+        void UnloadFont(size_t aFontId) override;
+        void Draw(const Rectangle& aRect) override;
+        void Draw(int aX, int aY, int aWidth, int aHeight) override;
+        void Draw(const Circle& aCircle) override;
+        void Draw(int aX, int aY, float aRadius) override;
+        void Draw(const Point& aPoint) override;
+        void Draw(int aX, int aY) override;
+        void DrawRects(const Rectangle* aRects, size_t aCount) override;
+        void FillRects(const Rectangle* aRects, size_t aCount) override;
+        void DrawPoints(const Point* aPoints, size_t aCount) override;
+        void DrawLines(const Point* aPoints, size_t aCount) override;
+        void DrawCircles(const Circle* aCircles, size_t aCount) override;
+        void DrawSprites(size_t aTexture, const Rectangle& aSrc, const Rectangle* aDst, const Color* aTints, size_t aCount) override;
+        void Draw(size_t aTexture, const Rectangle& aSrc, const Rectangle& aDst, float aAngle, bool aHorizontalFlip, bool aVerticalFlip, unsigned char aAlpha) override;
+        void Draw(size_t aFont, const std::string& aText, int aX, int aY) override;
+        void Draw(size_t aFont, const std::string& aText, int aX, int aY, int aWrapWidth) override;
+        void Draw(size_t aFont, const std::string& aText, int aX, int aY, const Color& aColor) override;
+        void GetTextureSize(size_t aTextureId, int* aWidth, int* aHeight) override;
+        bool IsRegionOpaque(size_t aTextureId, const Rectangle& aRegion) override;
+        void SetBlending(bool aEnabled) override;
+        void GetFontSize(size_t aFontId, const string& aText, int* aWidth, int* aHeight) override;
+        void GetScreenSize(int* aWidth, int* aHeight) override;
+        void GetWindowSize(int* aWidth, int* aHeight) override;
+        int GetTextureInCache() const override;
+        int GetFontInCache() const override;
+        void SetCamera(Camera* aCamera) override;
+        Camera* GetCamera() const override;
+        void Fill(const Rectangle& aRect) override;
+        void Fill(int aX, int aY, int aWidth, int aHeight) override;
+        void SetViewport(int aX, int aY, int aWidth, int aHeight) override;
+        void ScaleViewport(float aX, float aY) override;
+        void GetViewportScale(float* aX, float* aY) override;
+        size_t CreateRenderTarget(int aWidth, int aHeight) override;
+        bool SetRenderTarget(size_t aTarget) override;
+        size_t GetRenderTarget() const override;
+        void SetWindowState(EWindowState aState) override;
+        void Draw(Transform* transform) override;
+        bool LoadAtlas(const string& aManifest) override;
+        bool BuildAtlas(const vector<string>& aFiles, int aPadding) override;
+        void UnloadAtlas() override;
+        RenderStats& GetRenderStats() override;
+        void ShowRenderStats(size_t aFont) override;
+        OverdrawAnalyzer& GetOverdrawAnalyzer() override;
+        void ShowOverdraw(bool aEnabled) override;
+
+    protected:
+        // Where the finished frames go, a window by default
+        virtual bool CreateOutput(const string& aTitle, int aWidth, int aHeight, EWindowState aState);
+        virtual void PresentOutput();
+        virtual void DestroyOutput();
+
+        SoftwareSurface m_Frame;
+        SoftwareRasterizer m_Rasterizer;
+        int m_ScreenWidth{0};
+        int m_ScreenHeight{0};
+
+    private:
+        struct FontInfo : Resource<TTF_Font>
+        {
+            size_t Face{0};
+            Color Tint;
+        };
+
+        // A string rendered once in white, tinted when drawn
+        struct CachedText
+        {
+            SoftwareSurface* Surface{nullptr};
+            size_t Face{0};
+            string Text;
+            int WrapWidth{0};
+            unsigned int LastUsedFrame{0};
+        };
+
+        // Transform outlines of one color, drawn together when the frame is presented
+        struct OutlineBatch
+        {
+            Color Tint;
+            vector<float> Rects; // x, y, width and height of each outline
+        };
+
+        // Viewport scale of a render target, put back each time the target is bound
+        struct TargetScale
+        {
+            float X{1.0f};
+            float Y{1.0f};
+        };
+
+        typedef map<size_t, Resource<SoftwareSurface>*> TTexMap;
+        typedef map<size_t, FontInfo*> TFontMap;
+        typedef map<size_t, Resource<TTF_Font>*> TFaceMap;
+        typedef map<size_t, CachedText*> TTextMap;
+        typedef map<size_t, TargetScale> TScaleMap;
+
+        void DrawString(size_t aFont, const string& aText, int aX, int aY, int aWrapWidth, const Color& aColor);
+        CachedText* GetCachedText(size_t aFace, const string& aText, int aWrapWidth);
+        void EvictCachedText(bool aAll, size_t aFace);
+        void Submit(RasterCommand& aCommand, float aX, float aY, float aWidth, float aHeight);
+        void SubmitOutline(float aX, float aY, float aWidth, float aHeight);
+        void SubmitLine(int aX1, int aY1, int aX2, int aY2);
+        void DrawOutlines();
+        void CountDraw(ERenderCounter aCounter, int aX, int aY, int aWidth, int aHeight);
+        void CountPixels(int aX, int aY, int aWidth, int aHeight);
+        void DrawRenderStats();
+        void DrawOverdraw();
+        static bool CopySurface(SDL_Surface* aSurface, SoftwareSurface* aTarget);
+        static bool RenderText(TTF_Font* aFont, const string& aText, int aWrapWidth, SoftwareSurface* aTarget);
+
+        static const unsigned int TEXT_CACHE_LIFETIME; // frames an unused string stays in the text cache
+
+        TTexMap m_TexCache;
+        TFontMap m_FntCache;
+        TFaceMap m_FaceCache;
+        TTextMap m_TextCache;
+        TScaleMap m_TargetScales;
+        SDL_Window* m_Window{nullptr};
+        SDL_Renderer* m_Renderer{nullptr};
+        SDL_Texture* m_FrameTexture{nullptr};
+        Camera* m_Camera{nullptr};
+        Color m_ClearColor;
+        Color m_DrawColor;
+        bool m_Blending{true};
+        float m_ScaleX{1.0f};
+        float m_ScaleY{1.0f};
+        float m_TargetScaleX{1.0f}; // of the bound render target, taken from m_TargetScales when it is bound
+        float m_TargetScaleY{1.0f};
+        int m_ViewportX{0}; // window pixels
+        int m_ViewportY{0};
+        int m_ViewportWidth{0}; // 0 when no viewport is set
+        int m_ViewportHeight{0};
+        size_t m_RenderTarget{0};
+        unsigned int m_TargetCount{0};
+        unsigned int m_FrameCount{0};
+        RenderStats m_Stats;
+        size_t m_StatsFont{0}; // font of the statistics overlay, 0 when hidden
+        SoftwareSurface m_StatsSurface;
+        OverdrawAnalyzer m_Overdraw;
+        SoftwareSurface m_HeatmapSurface;
+        CircleCache m_Circles;
+        vector<OutlineBatch> m_Outlines;
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: SoftwareRasterizer.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef BART_SOFTWARERASTERIZER_H
+#define BART_SOFTWARERASTERIZER_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace bart
+{
+    // A CPU image, 0xAARRGGBB pixels with straight alpha
+    struct SoftwareSurface
+    {
+        int Width{0};
+        int Height{0};
+        std::vector<unsigned int> Pixels;
+    };
+
+    // A rectangle filled with a color or with a (scaled, flipped, rotated) part of a surface
+    struct RasterCommand
+    {
+        const SoftwareSurface* Source{nullptr}; // nullptr fills the destination with Color
+        int SrcX{0};
+        int SrcY{0};
+        int SrcW{0};
+        int SrcH{0};
+        int DstX{0};
+        int DstY{0};
+        int DstW{0};
+        int DstH{0};
+        float Angle{0.0f}; // degrees, clockwise around the center of the destination
+        bool HorizontalFlip{false};
+        bool VerticalFlip{false};
+        unsigned int Color{0xFFFFFFFF}; // fill color, or color and alpha modulation of the source
+        bool Blend{true};
+        int ClipX{0};
+        int ClipY{0};
+        int ClipW{0};
+        int ClipH{0};
+    };
+
+    // Draws commands in a target split in tiles, the tiles are shared between worker threads
+    class SoftwareRasterizer
+    {
+    public:
+        SoftwareRasterizer() = default;
+        ~SoftwareRasterizer();
+
+        void Start(int aThreadCount);
+        void Stop();
+        void SetTarget(SoftwareSurface* aTarget);
+        SoftwareSurface* GetTarget() const { return m_Target; }
+        void Submit(const RasterCommand& aCommand);
+        void Flush();
+        bool HasPendingCommands() const { return !m_Commands.empty(); }
+        int GetThreadCount() const { return static_cast<int>(m_Workers.size()) + 1; }
+
+        static const int TILE_SIZE; // pixels per side of a tile
+
+    private:
+        struct Bounds
+        {
+            int MinX;
+            int MinY;
+            int MaxX; // exclusive
+            int MaxY; // exclusive
+        };
+
+        void WorkerLoop(unsigned int aGeneration);
+        void RasterizeTiles();
+        void RasterizeTile(int aTile);
+        void Execute(const RasterCommand& aCommand, const Bounds& aArea) const;
+        void ExecuteRotated(const RasterCommand& aCommand, const Bounds& aArea) const;
+        static bool GetBounds(const RasterCommand& aCommand, Bounds* aBounds);
+
+        SoftwareSurface* m_Target{nullptr};
+        std::vector<RasterCommand> m_Commands;
+        std::vector<Bounds> m_CommandBounds;
+        std::vector<std::vector<unsigned int>> m_Bins; // commands touching each tile, in submission order
+        int m_TileColumns{0};
+        int m_TileRows{0};
+
+        std::vector<std::thread> m_Workers;
+        std::mutex m_Mutex;
+        std::condition_variable m_StartSignal;
+        std::condition_variable m_DoneSignal;
+        unsigned int m_Generation{0};
+        int m_Busy{0};
+        bool m_Stopping{false};
+        std::atomic<int> m_NextTile{0};
+    };
+}
+
+#endif
@@ -24,15 +24,51 @@ namespace bart
         void Draw(const Rectangle& aViewport) override;
         void Clean() override;
         int GetValueAt(const int aX, const int aY) const { return mLayerData[aY][aX]->Index; }
-        void SetValueAt(const int aX, const int aY, const int aValue) { mLayerData[aY][aX]->Index = aValue; }
+        void SetValueAt(int aX, int aY, int aValue);
         int IsColliding(const Rectangle& aCollider, int* aX, int* aY);
         int IsColliding(const Rectangle& aCollider);
+        bool CanOcclude() const;
+        const std::vector<unsigned long long>& GetOpaqueMasks() const { return m_OpaqueMasks; }
+        void SetOcclusion(const std::vector<unsigned long long>& aOcclusion) { m_Occlusion = aOcclusion; }
+        unsigned int GetRevision() const { return m_Revision; }
+
+        static const int LOD_CHUNK_SIZE; // tiles per side of a chunk baked for the zoomed out views
+        static const int LOD_TILE_SIZE; // below this on screen tile size (pixels) the chunks are drawn
+        static const int MAX_LOD_LEVEL; // the smallest chunk texture is 1 / 2^MAX_LOD_LEVEL of the chunk
+        static const int OCCLUSION_CHUNK_SIZE; // tiles per side of an occlusion mask, 8 x 8 bits
 
     private:
+        // Downsampled textures of a block of tiles, baked when first needed
+        struct TileChunk
+        {
+            std::vector<size_t> Textures; // one per level, 0 when not created yet
+            unsigned int DirtyLevels{0}; // bit per level to bake again
+            unsigned long long Animations{0}; // bits of the animated tiles in the chunk, see Tileset::GetAnimationBit
+        };
+
         void SetData(const char* aData);
+        void DrawTiles(int aFromX, int aFromY, int aToX, int aToY);
+        void DrawChunks(int aFromX, int aFromY, int aToX, int aToY, int aLevel);
+        void DrawTile(int aX, int aY, int aDestX, int aDestY, int aLevel, unsigned char aAlpha);
+        void BakeChunk(TileChunk& aChunk, int aChunkX, int aChunkY, int aLevel);
+        int GetLodLevel() const;
+        void CleanChunks();
+        void UpdateChunkAnimations(int aChunkX, int aChunkY);
+        void InvalidateAnimatedChunks();
+        bool IsOpaqueAt(int aX, int aY) const;
+        void UpdateOpaqueMask(int aX, int aY);
+        bool IsOccluded(int aX, int aY) const;
 
         typedef std::vector<std::vector<TileInfo*>> TTileMap;
         TTileMap mLayerData;
+        std::vector<TileChunk> m_Chunks;
+        int m_ChunkColumns{0};
+        int m_ChunkRows{0};
+        std::vector<int> m_AnimatedChunks; // chunks holding animated tiles, the only ones baked again when they play
+        std::vector<unsigned long long> m_OpaqueMasks; // cells this layer covers with an opaque tile
+        std::vector<unsigned long long> m_Occlusion; // cells covered by the layers drawn above
+        int m_OcclusionColumns{0};
+        unsigned int m_Revision{0};
         Tileset* m_TilesetPtr{nullptr};
         int m_TileWidth{0};
         int m_TileHeight{0};
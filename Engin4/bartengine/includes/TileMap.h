@@ -15,6 +15,8 @@ namespace tinyxml2
 
 namespace bart
 {
+    class TileLayer;
+
     class TileMap
     {
     public:
@@ -39,6 +41,7 @@ namespace bart
     private:
         void LoadMap(XMLNode* aNode);
         void AddLayer(Layer* aLayer);
+        void UpdateOcclusion();
 
         typedef std::map<std::string, Layer*> TLayerMap;
         std::map<std::string, Layer*> mMapInfo;
@@ -49,6 +52,8 @@ namespace bart
         int m_TileHeight{0};
         std::string m_MapPath;
         std::vector<Layer*> m_LayerDepth;
+        std::vector<TileLayer*> m_TileLayers; // back to front, like m_LayerDepth
+        unsigned int m_OcclusionRevision{~0u};
         ObjectFactory m_Factory;
         ELayerOrientation m_Orientation{ ORTHOGONAL };
     };
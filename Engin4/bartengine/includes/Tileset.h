@@ -19,6 +19,7 @@ namespace bart
     {
         size_t Texture;
         Rectangle Bounds;
+        bool Opaque{false}; // every pixel of the tile is fully opaque
     };
 
     class Tileset
@@ -28,10 +29,32 @@ namespace bart
         Tile* GetTile(int aIndex);
         void Clean();
 
+        // The animated tiles are evaluated once per frame against a clock, the layers then draw the tile of
+        // the current frame through Remap, whatever the number of cells using them
+        void Animate(unsigned long long aClock);
+        int Remap(const int aIndex) const { return static_cast<size_t>(aIndex) < m_Remap.size() ? m_Remap[aIndex] : aIndex; }
+        unsigned long long GetAnimationBit(int aIndex) const; // 0 when the tile is not animated
+        unsigned long long GetChangedAnimations() const { return m_Changed; } // bits of the tiles changed by Animate
+        bool HasAnimations() const { return !m_Animations.empty(); }
+
     private:
+        struct TileAnimation
+        {
+            int Index{0};
+            std::vector<int> Frames;
+            std::vector<unsigned int> Ends; // milliseconds from the start of the animation to the end of each frame
+            size_t Current{0};
+        };
+
+        void LoadAnimation(XMLNode* aNode, int aFirstIndex);
+
         typedef std::map<int, Tile*> TTileMap;
         TTileMap m_SourceMap;
         std::vector<size_t> m_TextureIds;
+        std::vector<TileAnimation> m_Animations;
+        std::vector<int> m_Remap; // tile drawn for each index, up to the last animated one
+        std::vector<int> m_AnimationIds; // animation of each index in m_Remap, -1 when not animated
+        unsigned long long m_Changed{0};
     };
 }
 #endif
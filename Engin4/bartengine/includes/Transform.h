@@ -46,6 +46,7 @@ namespace bart
         void SetHeight(float aHeight);
         void SetFlip(bool aHorizontal, bool aVertical);
         void GetBounds(Rectangle* aRectangle) const;
+        void GetAxisAlignedBounds(Rectangle* aRectangle) const;
 
         float X{0.0f};
         float Y{0.0f};
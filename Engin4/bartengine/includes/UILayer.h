@@ -0,0 +1,79 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: UILayer.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+
+#ifndef BART_UILAYER_H
+#define BART_UILAYER_H
+
+#include <UIWidget.h>
+#include <string>
+#include <vector>
+
+namespace bart
+{
+    class RenderGraph;
+
+    // Draws its widgets in screen space, ignoring the camera. The widgets are kept in a persistent target of the
+    // render graph and only the dirty ones (with those they overlap) are redrawn by the cache pass, the composite
+    // pass then copies the layer over the frame in a single draw
+    class UILayer
+    {
+    public:
+        void Initialize(const std::string& aName, int aWidth, int aHeight);
+        void Clean();
+        void Add(UIWidget* aWidget);
+        void Remove(UIWidget* aWidget);
+        void Invalidate();
+        void SetVisible(bool aVisible); // a hidden layer is culled from the graph, its widgets are not redrawn
+        unsigned int GetRedrawnWidgets() const { return m_RedrawnWidgets; } // during the last frame
+
+    private:
+        struct Slot
+        {
+            UIWidget* Widget{nullptr};
+            Rectangle Bounds;
+            bool Visible{false};
+        };
+
+        void Cache(RenderGraph& aGraph);
+        void Compose(RenderGraph& aGraph);
+        void Refresh();
+        bool IsInDirtyRegion(const Rectangle& aBounds) const;
+
+        std::vector<Slot> m_Slots;
+        std::vector<Rectangle> m_DirtyRegions;
+        std::vector<bool> m_Redraw;
+        size_t m_Resource{0};
+        size_t m_CachePass{0};
+        size_t m_CompositePass{0};
+        int m_Width{0};
+        int m_Height{0};
+        bool m_Invalid{true};
+        unsigned int m_RedrawnWidgets{0};
+    };
+}
+
+#endif
@@ -63,6 +63,13 @@ namespace bart
         TEntityVector m_DrawEntities;
         TEntityVector m_UpdateEntities;
         TTypeMap m_typeMap;
+
+        // Bounds of the entities to draw this frame, packed per axis for the culling
+        TEntityVector m_CullEntities;
+        std::vector<float> m_CullMinX;
+        std::vector<float> m_CullMinY;
+        std::vector<float> m_CullMaxX;
+        std::vector<float> m_CullMaxY;
     };
 }
 
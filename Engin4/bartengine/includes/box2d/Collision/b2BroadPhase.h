@@ -31,9 +31,24 @@ struct b2Pair
 	int32 next;
 };
 
+/// Work of the pair finding, counted until ResetCounters.
+struct b2BroadPhaseCounters
+{
+	int32 staticQueries;	///< moved proxies looked up in the static tree
+	int32 dynamicQueries;	///< moved proxies looked up in the dynamic tree
+	int32 pairs;			///< candidate pairs, duplicates included
+	int32 staticRebuilds;	///< times the static tree was built again
+};
+
+/// When the static proxies inserted one at a time are at least this fraction
+/// of the static tree, it is built again before the pairs are updated.
+#define b2_staticRebuildFraction	0.25f
+
 /// The broad-phase is used for computing pairs and performing volume queries and ray casts.
 /// This broad-phase does not persist pairs. Instead, this reports potentially new pairs.
 /// It is up to the client to consume the new pairs and to track subsequent overlap.
+/// The static proxies are kept in a tree of their own, only the moved proxies of the
+/// dynamic tree look them up. A proxy id holds its tree in the lowest bit.
 class b2BroadPhase
 {
 public:
@@ -47,8 +62,8 @@ public:
 	~b2BroadPhase();
 
 	/// Create a proxy with an initial AABB. Pairs are not reported until
-	/// UpdatePairs is called.
-	int32 CreateProxy(const b2AABB& aabb, void* userData);
+	/// UpdatePairs is called. Static proxies never pair with each other.
+	int32 CreateProxy(const b2AABB& aabb, void* userData, bool isStatic);
 
 	/// Destroy a proxy. It is up to the client to remove any pairs.
 	void DestroyProxy(int32 proxyId);
@@ -72,6 +87,9 @@ public:
 	/// Get the number of proxies.
 	int32 GetProxyCount() const;
 
+	/// Get the number of proxies in the static tree.
+	int32 GetStaticProxyCount() const;
+
 	/// Update the pairs. This results in pair callbacks. This can only add pairs.
 	template <typename T>
 	void UpdatePairs(T* callback);
@@ -91,15 +109,31 @@ public:
 	template <typename T>
 	void RayCast(T* callback, const b2RayCastInput& input) const;
 
-	/// Get the height of the embedded tree.
+	/// Get the height of the dynamic tree.
 	int32 GetTreeHeight() const;
 
-	/// Get the balance of the embedded tree.
+	/// Get the balance of the dynamic tree.
 	int32 GetTreeBalance() const;
 
-	/// Get the quality metric of the embedded tree.
+	/// Get the quality metric of the dynamic tree.
 	float32 GetTreeQuality() const;
 
+	/// Get the height of the static tree.
+	int32 GetStaticTreeHeight() const;
+
+	/// Get the quality metric of the static tree.
+	float32 GetStaticTreeQuality() const;
+
+	/// Build the static tree again with the surface area heuristic. UpdatePairs
+	/// does it when enough static proxies were inserted one at a time, after a load.
+	void RebuildStaticTree();
+
+	/// Get the work done by UpdatePairs since the last ResetCounters.
+	const b2BroadPhaseCounters& GetCounters() const;
+
+	/// Set the counters to zero.
+	void ResetCounters();
+
 private:
 
 	friend class b2DynamicTree;
@@ -107,11 +141,19 @@ private:
 	void BufferMove(int32 proxyId);
 	void UnBufferMove(int32 proxyId);
 
-	bool QueryCallback(int32 proxyId);
+	bool QueryCallback(int32 nodeId);
+
+	const b2DynamicTree& GetTree(int32 proxyId) const;
+	b2DynamicTree& GetTree(int32 proxyId);
 
 	b2DynamicTree m_tree;
+	b2DynamicTree m_staticTree;
 
 	int32 m_proxyCount;
+	int32 m_staticProxyCount;
+
+	// Static proxies inserted one at a time since the static tree was built
+	int32 m_staticInsertCount;
 
 	int32* m_moveBuffer;
 	int32 m_moveCapacity;
@@ -122,6 +164,51 @@ private:
 	int32 m_pairCount;
 
 	int32 m_queryProxyId;
+	int32 m_queryTree;
+
+	b2BroadPhaseCounters m_counters;
+};
+
+/// Get the node of a proxy in its tree.
+inline int32 b2ProxyNode(int32 proxyId)
+{
+	return proxyId >> 1;
+}
+
+/// Does the proxy live in the static tree?
+inline bool b2IsStaticProxy(int32 proxyId)
+{
+	return (proxyId & 1) != 0;
+}
+
+/// Forwards the callbacks of one tree with the proxy ids of the broad-phase.
+template <typename T>
+struct b2BroadPhaseTreeCallback
+{
+	bool QueryCallback(int32 nodeId)
+	{
+		proceed = callback->QueryCallback(2 * nodeId + tree);
+		return proceed;
+	}
+
+	float32 RayCastCallback(const b2RayCastInput& input, int32 nodeId)
+	{
+		float32 value = callback->RayCastCallback(input, 2 * nodeId + tree);
+		if (value == 0.0f)
+		{
+			proceed = false;
+		}
+		else if (value > 0.0f)
+		{
+			maxFraction = value;
+		}
+		return value;
+	}
+
+	T* callback;
+	int32 tree;
+	bool proceed;
+	float32 maxFraction;
 };
 
 /// This is used to sort pairs.
@@ -140,21 +227,31 @@ inline bool b2PairLessThan(const b2Pair& pair1, const b2Pair& pair2)
 	return false;
 }
 
+inline const b2DynamicTree& b2BroadPhase::GetTree(int32 proxyId) const
+{
+	return b2IsStaticProxy(proxyId) ? m_staticTree : m_tree;
+}
+
+inline b2DynamicTree& b2BroadPhase::GetTree(int32 proxyId)
+{
+	return b2IsStaticProxy(proxyId) ? m_staticTree : m_tree;
+}
+
 inline void* b2BroadPhase::GetUserData(int32 proxyId) const
 {
-	return m_tree.GetUserData(proxyId);
+	return GetTree(proxyId).GetUserData(b2ProxyNode(proxyId));
 }
 
 inline bool b2BroadPhase::TestOverlap(int32 proxyIdA, int32 proxyIdB) const
 {
-	const b2AABB& aabbA = m_tree.GetFatAABB(proxyIdA);
-	const b2AABB& aabbB = m_tree.GetFatAABB(proxyIdB);
+	const b2AABB& aabbA = GetFatAABB(proxyIdA);
+	const b2AABB& aabbB = GetFatAABB(proxyIdB);
 	return b2TestOverlap(aabbA, aabbB);
 }
 
 inline const b2AABB& b2BroadPhase::GetFatAABB(int32 proxyId) const
 {
-	return m_tree.GetFatAABB(proxyId);
+	return GetTree(proxyId).GetFatAABB(b2ProxyNode(proxyId));
 }
 
 inline int32 b2BroadPhase::GetProxyCount() const
@@ -162,6 +259,11 @@ inline int32 b2BroadPhase::GetProxyCount() const
 	return m_proxyCount;
 }
 
+inline int32 b2BroadPhase::GetStaticProxyCount() const
+{
+	return m_staticProxyCount;
+}
+
 inline int32 b2BroadPhase::GetTreeHeight() const
 {
 	return m_tree.GetHeight();
@@ -177,9 +279,30 @@ inline float32 b2BroadPhase::GetTreeQuality() const
 	return m_tree.GetAreaRatio();
 }
 
+inline int32 b2BroadPhase::GetStaticTreeHeight() const
+{
+	return m_staticTree.GetHeight();
+}
+
+inline float32 b2BroadPhase::GetStaticTreeQuality() const
+{
+	return m_staticTree.GetAreaRatio();
+}
+
+inline const b2BroadPhaseCounters& b2BroadPhase::GetCounters() const
+{
+	return m_counters;
+}
+
 template <typename T>
 void b2BroadPhase::UpdatePairs(T* callback)
 {
+	// A static tree mostly inserted one proxy at a time, as a level loads, is built again.
+	if (m_staticInsertCount > 0 && m_staticInsertCount >= b2_staticRebuildFraction * m_staticProxyCount)
+	{
+		RebuildStaticTree();
+	}
+
 	// Reset pair buffer
 	m_pairCount = 0;
 
@@ -194,14 +317,25 @@ void b2BroadPhase::UpdatePairs(T* callback)
 
 		// We have to query the tree with the fat AABB so that
 		// we don't fail to create a pair that may touch later.
-		const b2AABB& fatAABB = m_tree.GetFatAABB(m_queryProxyId);
+		const b2AABB& fatAABB = GetFatAABB(m_queryProxyId);
 
-		// Query tree, create pairs and add them pair buffer.
+		// Query trees, create pairs and add them pair buffer. Static
+		// proxies do not pair with each other.
+		if (b2IsStaticProxy(m_queryProxyId) == false)
+		{
+			m_queryTree = 1;
+			m_staticTree.Query(this, fatAABB);
+			++m_counters.staticQueries;
+		}
+
+		m_queryTree = 0;
 		m_tree.Query(this, fatAABB);
+		++m_counters.dynamicQueries;
 	}
 
 	// Reset move buffer
 	m_moveCount = 0;
+	m_counters.pairs += m_pairCount;
 
 	// Sort the pair buffer to expose duplicates.
 	std::sort(m_pairBuffer, m_pairBuffer + m_pairCount, b2PairLessThan);
@@ -211,8 +345,8 @@ void b2BroadPhase::UpdatePairs(T* callback)
 	while (i < m_pairCount)
 	{
 		b2Pair* primaryPair = m_pairBuffer + i;
-		void* userDataA = m_tree.GetUserData(primaryPair->proxyIdA);
-		void* userDataB = m_tree.GetUserData(primaryPair->proxyIdB);
+		void* userDataA = GetUserData(primaryPair->proxyIdA);
+		void* userDataB = GetUserData(primaryPair->proxyIdB);
 
 		callback->AddPair(userDataA, userDataB);
 		++i;
@@ -236,13 +370,37 @@ void b2BroadPhase::UpdatePairs(T* callback)
 template <typename T>
 inline void b2BroadPhase::Query(T* callback, const b2AABB& aabb) const
 {
-	m_tree.Query(callback, aabb);
+	b2BroadPhaseTreeCallback<T> treeCallback;
+	treeCallback.callback = callback;
+	treeCallback.tree = 1;
+	treeCallback.proceed = true;
+	m_staticTree.Query(&treeCallback, aabb);
+
+	if (treeCallback.proceed)
+	{
+		treeCallback.tree = 0;
+		m_tree.Query(&treeCallback, aabb);
+	}
 }
 
 template <typename T>
 inline void b2BroadPhase::RayCast(T* callback, const b2RayCastInput& input) const
 {
-	m_tree.RayCast(callback, input);
+	b2BroadPhaseTreeCallback<T> treeCallback;
+	treeCallback.callback = callback;
+	treeCallback.tree = 1;
+	treeCallback.proceed = true;
+	treeCallback.maxFraction = input.maxFraction;
+	m_staticTree.RayCast(&treeCallback, input);
+
+	if (treeCallback.proceed)
+	{
+		// The dynamic tree is cast up to the closest hit so far.
+		b2RayCastInput subInput = input;
+		subInput.maxFraction = treeCallback.maxFraction;
+		treeCallback.tree = 0;
+		m_tree.RayCast(&treeCallback, subInput);
+	}
 }
 
 #endif
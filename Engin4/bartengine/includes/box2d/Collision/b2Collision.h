@@ -229,6 +229,12 @@ void b2CollidePolygons(b2Manifold* manifold,
 					   const b2PolygonShape* polygonA, const b2Transform& xfA,
 					   const b2PolygonShape* polygonB, const b2Transform& xfB);
 
+/// Compute the collision manifolds of up to b2_wideLanes pairs of boxes (polygons of
+/// 4 vertices) at once, the same manifolds b2CollidePolygons computes for each pair.
+void b2CollideBoxes(b2Manifold* const* manifolds,
+					const b2PolygonShape* const* polygonsA, const b2Transform* const* xfsA,
+					const b2PolygonShape* const* polygonsB, const b2Transform* const* xfsB, int32 count);
+
 /// Compute the collision manifold between an edge and a circle.
 void b2CollideEdgeAndCircle(b2Manifold* manifold,
 							   const b2EdgeShape* polygonA, const b2Transform& xfA,
@@ -118,6 +118,10 @@ public:
 	/// Build an optimal tree. Very expensive. For testing.
 	void RebuildBottomUp();
 
+	/// Build the tree again from its leaves, top down, splitting each node where
+	/// the surface area heuristic is the lowest. O(n log n), the proxy ids are kept.
+	void RebuildTopDown();
+
 private:
 
 	int32 AllocateNode();
@@ -128,6 +132,8 @@ private:
 
 	int32 Balance(int32 index);
 
+	int32 BuildTopDown(int32* leaves, int32 count);
+
 	int32 ComputeHeight() const;
 	int32 ComputeHeight(int32 nodeId) const;
 
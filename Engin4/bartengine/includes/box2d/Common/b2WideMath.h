@@ -0,0 +1,139 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: b2WideMath.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef B2_WIDE_MATH_H
+#define B2_WIDE_MATH_H
+
+#include <box2d/Common/b2Settings.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define B2_WIDE_MATH 1
+#include <emmintrin.h>
+#else
+#define B2_WIDE_MATH 0
+#endif
+
+/// The number of values computed together.
+#define b2_wideLanes 4
+
+/// Does the CPU run the SSE2 instructions? Checked once.
+bool b2IsWideSupported();
+
+#if B2_WIDE_MATH
+
+// One value per lane, the helpers do the same operation as the scalar code of each lane.
+typedef __m128 b2FloatW;
+
+inline b2FloatW b2LoadW(const float32* a)
+{
+	return _mm_loadu_ps(a);
+}
+
+inline b2FloatW b2LoadMaskW(const int32* a)
+{
+	return _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)a));
+}
+
+inline void b2StoreW(float32* a, b2FloatW v)
+{
+	_mm_storeu_ps(a, v);
+}
+
+inline b2FloatW b2SplatW(float32 a)
+{
+	return _mm_set1_ps(a);
+}
+
+inline b2FloatW b2AddW(b2FloatW a, b2FloatW b)
+{
+	return _mm_add_ps(a, b);
+}
+
+inline b2FloatW b2SubW(b2FloatW a, b2FloatW b)
+{
+	return _mm_sub_ps(a, b);
+}
+
+inline b2FloatW b2MulW(b2FloatW a, b2FloatW b)
+{
+	return _mm_mul_ps(a, b);
+}
+
+inline b2FloatW b2NegW(b2FloatW a)
+{
+	return _mm_xor_ps(a, _mm_set1_ps(-0.0f));
+}
+
+// Same operands order as b2Min and b2Max, so the same result for equal values and zeros of both signs
+inline b2FloatW b2MinW(b2FloatW a, b2FloatW b)
+{
+	return _mm_min_ps(a, b);
+}
+
+inline b2FloatW b2MaxW(b2FloatW a, b2FloatW b)
+{
+	return _mm_max_ps(a, b);
+}
+
+inline b2FloatW b2SelectW(b2FloatW mask, b2FloatW a, b2FloatW b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline b2FloatW b2GreaterEqualW(b2FloatW a, b2FloatW b)
+{
+	return _mm_cmpge_ps(a, b);
+}
+
+inline b2FloatW b2GreaterW(b2FloatW a, b2FloatW b)
+{
+	return _mm_cmpgt_ps(a, b);
+}
+
+inline b2FloatW b2LessW(b2FloatW a, b2FloatW b)
+{
+	return _mm_cmplt_ps(a, b);
+}
+
+inline b2FloatW b2AndW(b2FloatW a, b2FloatW b)
+{
+	return _mm_and_ps(a, b);
+}
+
+inline b2FloatW b2OrW(b2FloatW a, b2FloatW b)
+{
+	return _mm_or_ps(a, b);
+}
+
+// b2Cross(a, b) of the lanes, a.x * b.y - a.y * b.x
+inline b2FloatW b2CrossW(b2FloatW ax, b2FloatW ay, b2FloatW bx, b2FloatW by)
+{
+	return _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+}
+
+#endif
+
+#endif
@@ -181,7 +181,9 @@ protected:
 	b2Contact(b2Fixture* fixtureA, int32 indexA, b2Fixture* fixtureB, int32 indexB);
 	virtual ~b2Contact() {}
 
-	void Update(b2ContactListener* listener);
+	// The manifold, when given, was computed ahead by the contact manager for the
+	// current transforms and replaces the call to Evaluate.
+	void Update(b2ContactListener* listener, const b2Manifold* manifold = NULL);
 
 	static b2ContactRegister s_registers[b2Shape::e_typeCount][b2Shape::e_typeCount];
 	static bool s_initialized;
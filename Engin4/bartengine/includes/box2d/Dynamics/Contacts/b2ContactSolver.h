@@ -22,11 +22,12 @@
 #include <box2d/Common/b2Math.h>
 #include <box2d/Collision/b2Collision.h>
 #include <box2d/Dynamics/b2TimeStep.h>
+#include <box2d/Dynamics/Contacts/b2WideContactSolver.h>
 
 class b2Contact;
 class b2Body;
+class b2Island;
 class b2StackAllocator;
-struct b2ContactPositionConstraint;
 
 struct b2VelocityConstraintPoint
 {
@@ -55,8 +56,24 @@ struct b2ContactVelocityConstraint
 	int32 contactIndex;
 };
 
+struct b2ContactPositionConstraint
+{
+	b2Vec2 localPoints[b2_maxManifoldPoints];
+	b2Vec2 localNormal;
+	b2Vec2 localPoint;
+	int32 indexA;
+	int32 indexB;
+	float32 invMassA, invMassB;
+	b2Vec2 localCenterA, localCenterB;
+	float32 invIA, invIB;
+	b2Manifold::Type type;
+	float32 radiusA, radiusB;
+	int32 pointCount;
+};
+
 struct b2ContactSolverDef
 {
+	const b2Island* island;
 	b2TimeStep step;
 	b2Contact** contacts;
 	int32 count;
@@ -88,6 +105,7 @@ public:
 	b2ContactVelocityConstraint* m_velocityConstraints;
 	b2Contact** m_contacts;
 	int m_count;
+	b2WideContactSolver m_wide;
 };
 
 #endif
@@ -0,0 +1,121 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: b2WideContactSolver.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef B2_WIDE_CONTACT_SOLVER_H
+#define B2_WIDE_CONTACT_SOLVER_H
+
+#include <box2d/Common/b2WideMath.h>
+
+class b2ContactSolver;
+
+/// Contacts solved together, one lane each. No two lanes move the same body.
+struct b2WideContactBatch
+{
+	// A lane without a contact has indices of -1 and no mass, nothing is applied to it.
+	int32 constraint[b2_wideLanes];
+	int32 indexA[b2_wideLanes];
+	int32 indexB[b2_wideLanes];
+	bool moveA[b2_wideLanes]; // false for a body no impulse moves, it can be in several lanes
+	bool moveB[b2_wideLanes];
+
+	// Velocity constraints
+	float32 normalX[b2_wideLanes];
+	float32 normalY[b2_wideLanes];
+	float32 friction[b2_wideLanes];
+	float32 invMassA[b2_wideLanes];
+	float32 invIA[b2_wideLanes];
+	float32 invMassB[b2_wideLanes];
+	float32 invIB[b2_wideLanes];
+	float32 rAX[b2_maxManifoldPoints][b2_wideLanes];
+	float32 rAY[b2_maxManifoldPoints][b2_wideLanes];
+	float32 rBX[b2_maxManifoldPoints][b2_wideLanes];
+	float32 rBY[b2_maxManifoldPoints][b2_wideLanes];
+	float32 normalMass[b2_maxManifoldPoints][b2_wideLanes];
+	float32 tangentMass[b2_maxManifoldPoints][b2_wideLanes];
+	float32 velocityBias[b2_maxManifoldPoints][b2_wideLanes];
+	float32 normalImpulse[b2_maxManifoldPoints][b2_wideLanes];
+	float32 tangentImpulse[b2_maxManifoldPoints][b2_wideLanes];
+	float32 K[4][b2_wideLanes]; // ex.x, ex.y, ey.x, ey.y
+	float32 blockMass[4][b2_wideLanes]; // inverse of K
+	int32 blockSolve[b2_wideLanes]; // -1 for the lanes with two points, solved together
+
+	// Position constraints
+	float32 localCenterAX[b2_wideLanes];
+	float32 localCenterAY[b2_wideLanes];
+	float32 localCenterBX[b2_wideLanes];
+	float32 localCenterBY[b2_wideLanes];
+	float32 localNormalX[b2_wideLanes];
+	float32 localNormalY[b2_wideLanes];
+	float32 localPointX[b2_wideLanes];
+	float32 localPointY[b2_wideLanes];
+	float32 localPointsX[b2_maxManifoldPoints][b2_wideLanes];
+	float32 localPointsY[b2_maxManifoldPoints][b2_wideLanes];
+	float32 radiusA[b2_wideLanes];
+	float32 radiusB[b2_wideLanes];
+	int32 circles[b2_wideLanes]; // -1 for a b2Manifold::e_circles lane
+	int32 faceB[b2_wideLanes]; // -1 for a b2Manifold::e_faceB lane
+	int32 positionPoints[b2_maxManifoldPoints][b2_wideLanes]; // -1 when the lane has the point
+};
+
+/// Solves the contacts of a b2ContactSolver b2_wideLanes at a time with SSE, the arithmetic of each lane is the
+/// one of b2ContactSolver. The contacts are grouped so the lanes of a batch never share a body that moves, the
+/// order they are solved in is not the one of the island but it is the same from one run to the next.
+/// This is an internal class.
+class b2WideContactSolver
+{
+public:
+	b2WideContactSolver();
+
+	/// Is SSE available on this CPU.
+	static bool IsSupported();
+
+	/// Groups the contacts once the velocity constraints are initialized.
+	void Initialize(b2ContactSolver* solver);
+
+	/// Releases the batches, before the solver frees its constraints.
+	void Clear();
+
+	bool IsActive() const { return m_batches != NULL; }
+
+	int32 GetBatchCount() const { return m_batchCount; }
+
+	void SolveVelocityConstraints();
+
+	/// Copies the accumulated impulses back to the velocity constraints of the solver.
+	void StoreImpulses();
+
+	bool SolvePositionConstraints();
+
+private:
+	int32 Group(b2WideContactBatch* batches);
+	void Fill(b2WideContactBatch* batch, int32 lane, int32 index);
+
+	b2ContactSolver* m_solver;
+	b2WideContactBatch* m_batches;
+	int32 m_batchCount;
+};
+
+#endif
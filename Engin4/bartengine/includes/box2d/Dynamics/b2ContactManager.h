@@ -20,12 +20,16 @@
 #define B2_CONTACT_MANAGER_H
 
 #include <box2d/Collision/b2BroadPhase.h>
+#include <box2d/Collision/b2Collision.h>
 
 class b2Contact;
 class b2ContactFilter;
 class b2ContactListener;
 class b2BlockAllocator;
 
+/// Contacts sorted and computed together by b2ContactManager::CollideWide.
+#define b2_wideCollideWindow	64
+
 // Delegate of b2World.
 class b2ContactManager
 {
@@ -41,12 +45,49 @@ public:
 
 	void Collide();
 
+	// Narrow-phase computing the manifolds of the contacts grouped by shape pair.
+	void CollideWide();
+	int32 CollectWide(b2Contact** next);
+	void CollideWide(int32 entryCount);
+	void UpdateWide(int32 entryCount);
+
+	// Checks applied to each contact before its update.
+	enum CheckResult
+	{
+		e_checkDestroy,
+		e_checkSleeping,
+		e_checkUpdate
+	};
+
+	CheckResult Check(b2Contact* c);
+
+	// Contact of the narrow-phase and the group it is computed with.
+	struct WideEntry
+	{
+		enum Bucket
+		{
+			e_destroy,
+			e_sleeping,
+			e_evaluate,
+			e_circles,
+			e_boxes,
+			e_polygonAndCircle
+		};
+
+		b2Contact* contact;
+		Bucket bucket;
+		b2Manifold manifold;
+	};
+
 	b2BroadPhase m_broadPhase;
 	b2Contact* m_contactList;
 	int32 m_contactCount;
 	b2ContactFilter* m_contactFilter;
 	b2ContactListener* m_contactListener;
 	b2BlockAllocator* m_allocator;
+
+	bool m_wideCollide;
+	WideEntry m_wideEntries[b2_wideCollideWindow];
 };
 
 #endif
@@ -43,20 +43,53 @@ public:
 		m_bodyCount = 0;
 		m_contactCount = 0;
 		m_jointCount = 0;
+		m_staticCount = 0;
 	}
 
-	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep);
+	/// concurrent is true when other islands are solved at the same time, see b2IslandSolver. The static bodies
+	/// are shared between islands, they are not written to.
+	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep,
+			   bool concurrent = false);
 
 	void SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiIndexB);
 
+	/// A static body can be in several islands solved at the same time, its index is kept by the island rather
+	/// than in the body.
 	void Add(b2Body* body)
 	{
 		b2Assert(m_bodyCount < m_bodyCapacity);
-		body->m_islandIndex = m_bodyCount;
+		if (body->m_type == b2_staticBody)
+		{
+			m_staticIndices[m_staticCount++] = m_bodyCount;
+		}
+		else
+		{
+			body->m_islandIndex = m_bodyCount;
+		}
 		m_bodies[m_bodyCount] = body;
 		++m_bodyCount;
 	}
 
+	/// Index of a body of the island in the positions and velocities. An island holds few static bodies.
+	int32 GetIndex(const b2Body* body) const
+	{
+		if (body->m_type != b2_staticBody)
+		{
+			return body->m_islandIndex;
+		}
+
+		for (int32 i = 0; i < m_staticCount; ++i)
+		{
+			if (m_bodies[m_staticIndices[i]] == body)
+			{
+				return m_staticIndices[i];
+			}
+		}
+
+		b2Assert(false);
+		return 0;
+	}
+
 	void Add(b2Contact* contact)
 	{
 		b2Assert(m_contactCount < m_contactCapacity);
@@ -80,10 +113,12 @@ public:
 
 	b2Position* m_positions;
 	b2Velocity* m_velocities;
+	int32* m_staticIndices;
 
 	int32 m_bodyCount;
 	int32 m_jointCount;
 	int32 m_contactCount;
+	int32 m_staticCount;
 
 	int32 m_bodyCapacity;
 	int32 m_contactCapacity;
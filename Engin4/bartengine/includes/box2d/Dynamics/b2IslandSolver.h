@@ -0,0 +1,107 @@
+/// --------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: b2IslandSolver.h
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+/// 
+/// --------------------------------------------------------------------------------------------------------------------
+#ifndef B2_ISLAND_SOLVER_H
+#define B2_ISLAND_SOLVER_H
+
+#include <box2d/Common/b2Math.h>
+#include <box2d/Dynamics/b2TimeStep.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class b2Body;
+class b2Contact;
+class b2Joint;
+class b2Island;
+class b2StackAllocator;
+class b2ContactListener;
+
+/// Solves the islands of a step on several threads. The islands are built by b2World one after the other as usual,
+/// kept here, then solved together. An island only touches its own bodies, contacts and joints, the static bodies
+/// shared between islands are only read, so the result does not depend on the thread count.
+/// This is an internal class.
+class b2IslandSolver
+{
+public:
+	b2IslandSolver();
+	~b2IslandSolver();
+
+	/// Threads solving the islands, the one calling Solve included. 1 solves them in b2World as before.
+	void SetThreadCount(int32 count);
+	int32 GetThreadCount() const { return int32(m_workers.size()) + 1; }
+
+	/// Keeps a copy of an island built by b2World, to solve later.
+	void Add(const b2Island& island);
+
+	/// Solves the islands added since the last call. The post solve callbacks and the profile are reported in
+	/// the order the islands were added.
+	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep,
+			   b2StackAllocator* allocator, b2ContactListener* listener);
+
+private:
+	struct b2IslandRange
+	{
+		int32 bodyStart;
+		int32 bodyCount;
+		int32 contactStart;
+		int32 contactCount;
+		int32 jointStart;
+		int32 jointCount;
+		b2Profile profile;
+	};
+
+	void SolveIslands(b2StackAllocator* allocator);
+	void SolveIsland(b2IslandRange& range, b2StackAllocator* allocator);
+	void SynchronizeStatics(const b2IslandRange& range);
+	void Report(const b2IslandRange& range, b2ContactListener* listener) const;
+	void WorkerLoop(int32 index, uint32 startGeneration);
+	void Stop();
+
+	std::vector<b2IslandRange> m_islands;
+	std::vector<b2Body*> m_bodies;
+	std::vector<b2Contact*> m_contacts;
+	std::vector<b2Joint*> m_joints;
+
+	// The step being solved
+	b2TimeStep m_step;
+	b2Vec2 m_gravity;
+	bool m_allowSleep;
+
+	std::vector<std::thread> m_workers;
+	std::vector<b2StackAllocator*> m_allocators; // one per worker, the calling thread uses the world's
+	std::mutex m_mutex;
+	std::condition_variable m_startSignal;
+	std::condition_variable m_doneSignal;
+	uint32 m_generation;
+	int32 m_busy;
+	bool m_stopping;
+	std::atomic<int32> m_nextIsland;
+};
+
+#endif
@@ -43,6 +43,7 @@ struct b2TimeStep
 	int32 velocityIterations;
 	int32 positionIterations;
 	bool warmStarting;
+	bool wideSolver;	// solve the contacts with b2WideContactSolver
 };
 
 /// This is an internal structure.
@@ -59,12 +60,15 @@ struct b2Velocity
 	float32 w;
 };
 
+class b2Island;
+
 /// Solver Data
 struct b2SolverData
 {
 	b2TimeStep step;
 	b2Position* positions;
 	b2Velocity* velocities;
+	const b2Island* island; ///< gives the index of the bodies in positions and velocities
 };
 
 #endif
@@ -34,6 +34,7 @@ class b2Body;
 class b2Draw;
 class b2Fixture;
 class b2Joint;
+class b2IslandSolver;
 
 /// The world class manages all physics entities, dynamic simulation,
 /// and asynchronous queries. The world also contains efficient memory
@@ -149,6 +150,16 @@ public:
 	void SetWarmStarting(bool flag) { m_warmStarting = flag; }
 	bool GetWarmStarting() const { return m_warmStarting; }
 
+	/// Enable/disable solving the contacts several at a time with SIMD instructions. The contacts are not solved
+	/// in the same order, the result is close but not the same. Ignored when the CPU does not support it.
+	void SetWideSolver(bool flag) { m_wideSolver = flag; }
+	bool GetWideSolver() const { return m_wideSolver; }
+
+	/// Enable/disable computing the contact manifolds grouped by shape pair, boxes and circles four at a time
+	/// with SIMD instructions. The manifolds are the same as one contact at a time.
+	void SetWideCollide(bool flag) { m_contactManager.m_wideCollide = flag; }
+	bool GetWideCollide() const { return m_contactManager.m_wideCollide; }
+
 	/// Enable/disable continuous physics. For testing.
 	void SetContinuousPhysics(bool flag) { m_continuousPhysics = flag; }
 	bool GetContinuousPhysics() const { return m_continuousPhysics; }
@@ -179,6 +190,22 @@ public:
 	/// The minimum is 1.
 	float32 GetTreeQuality() const;
 
+	/// Get the number of proxies of the static bodies, kept in a tree of their own.
+	int32 GetStaticProxyCount() const;
+
+	/// Get the height of the static tree.
+	int32 GetStaticTreeHeight() const;
+
+	/// Get the quality metric of the static tree.
+	float32 GetStaticTreeQuality() const;
+
+	/// Build the static tree with the surface area heuristic. This is done by the
+	/// next step on its own once many static fixtures were added, e.g. by a level load.
+	void RebuildStaticTree();
+
+	/// Get the work of the broad-phase during the last time step.
+	const b2BroadPhaseCounters& GetBroadPhaseCounters() const;
+
 	/// Change the global gravity vector.
 	void SetGravity(const b2Vec2& gravity);
 
@@ -200,6 +227,14 @@ public:
 	/// Get the current profile.
 	const b2Profile& GetProfile() const;
 
+	/// Set the number of threads solving the islands, the calling one included. The result does not depend on it.
+	/// 1, the default, solves them one after the other during the search.
+	/// @warning this should be called outside of a time step.
+	void SetThreadCount(int32 count);
+
+	/// Get the number of threads solving the islands.
+	int32 GetThreadCount() const;
+
 	/// Dump the world into the log file.
 	/// @warning this should be called outside of a time step.
 	void Dump();
@@ -250,12 +285,15 @@ private:
 
 	// These are for debugging the solver.
 	bool m_warmStarting;
+	bool m_wideSolver;
 	bool m_continuousPhysics;
 	bool m_subStepping;
 
 	bool m_stepComplete;
 
 	b2Profile m_profile;
+
+	b2IslandSolver* m_islandSolver;
 };
 
 inline b2Body* b2World::GetBodyList()
@@ -26,6 +26,15 @@
 /// -------------------------------------------------------------------------------------------------------------------
 
 #include <Animation.h>
+#include <Engine.h>
+
+bart::Animation::~Animation()
+{
+    if (m_Instance != 0)
+    {
+        Engine::Instance().GetAnimations().Destroy(m_Instance);
+    }
+}
 
 void bart::Animation::InitAnimation(const int aRows, const int aWidth, const int aHeight)
 {
@@ -35,73 +44,80 @@ void bart::Animation::InitAnimation(const int aRows, const int aWidth, const int
 
     m_Destination.Set(0, 0, m_ImageWidth, m_ImageHeight);
     m_Source.Set(0, 0, m_ImageWidth, m_ImageHeight);
+
+    if (m_Instance == 0)
+    {
+        m_Instance = Engine::Instance().GetAnimations().Create();
+    }
 }
 
 void bart::Animation::Update(Transform* aTransform, const float aDelta)
 {
     Sprite::Update(aTransform, aDelta);
 
-    if (m_Playing)
+    if (m_Instance != 0)
     {
-        m_Elapsed += aDelta;
-        if (m_Elapsed >= m_Delay)
-        {
-            m_Elapsed = 0.0f;
-
-            m_CurrentFrame++;
-            if (m_CurrentFrame > m_LastFrame)
-            {
-                m_CurrentFrame = m_FirstFrame;
-
-                if (!m_Loop)
-                {
-                    m_Playing = false;
-                }
-            }
-
-            UpdateFrame();
-        }
+        Engine::Instance().GetAnimations().SetBounds(m_Instance, m_Destination);
     }
 }
 
 void bart::Animation::Draw()
 {
-    if (m_Playing)
+    if (m_Instance != 0)
     {
-        Sprite::Draw();
+        AnimationSystem& tAnimations = Engine::Instance().GetAnimations();
+        if (tAnimations.IsPlaying(m_Instance))
+        {
+            m_Source = tAnimations.GetFrame(m_Instance);
+            Sprite::Draw();
+        }
     }
 }
 
 void bart::Animation::Play(const int aStart, const int aCount, const float aDelay, const bool aLoop)
 {
-    m_CurrentFrame = aStart;
-    m_FirstFrame = aStart;
-    m_LastFrame = aStart + aCount - 1;
-    m_Delay = aDelay;
-    m_Loop = aLoop;
+    if (m_Instance == 0)
+    {
+        return;
+    }
+
+    // The same sheet layout and timing gives the same clip, every character walking shares it
+    const std::string tName = "Grid_" + std::to_string(m_ImagePerRow) + "_" + std::to_string(m_ImageWidth) + "x" +
+        std::to_string(m_ImageHeight) + "_" + std::to_string(aStart) + "_" + std::to_string(aCount) + "_" +
+        std::to_string(aDelay) + (aLoop ? "_Loop" : "");
 
-    UpdateFrame();
+    AnimationSystem& tAnimations = Engine::Instance().GetAnimations();
+    size_t tClip = tAnimations.FindClip(tName);
+    if (tClip == 0)
+    {
+        tClip = tAnimations.AddClip(tName, AnimationClip::FromGrid(m_ImagePerRow, m_ImageWidth, m_ImageHeight, aStart, aCount,
+                                                                  aDelay, aLoop));
+    }
 
-    m_Playing = true;
+    tAnimations.Play(m_Instance, tClip, 1.0f);
 }
 
-void bart::Animation::Stop()
+void bart::Animation::Play(const string& aClip, const float aSpeed)
 {
-    m_Playing = false;
-
-    m_CurrentFrame = 0;
-    m_FirstFrame = 0;
-    m_LastFrame = 0;
-    m_Delay = 0.0f;
-    m_Loop = false;
+    if (m_Instance != 0)
+    {
+        AnimationSystem& tAnimations = Engine::Instance().GetAnimations();
+        tAnimations.Play(m_Instance, tAnimations.FindClip(aClip), aSpeed);
+    }
 }
 
-void bart::Animation::UpdateFrame()
+void bart::Animation::Stop()
 {
-    const int tRow = m_CurrentFrame / m_ImagePerRow;
-    const int tCol = m_CurrentFrame - (m_ImagePerRow * tRow);
-    const int tX = m_ImageWidth * tCol;
-    const int tY = m_ImageHeight * tRow;
-
-    m_Source.Set(tX, tY, m_ImageWidth, m_ImageHeight);
+    if (m_Instance != 0)
+    {
+        Engine::Instance().GetAnimations().Stop(m_Instance);
+    }
 }
+
+void bart::Animation::SetPaused(const bool aPaused)
+{
+    if (m_Instance != 0)
+    {
+        Engine::Instance().GetAnimations().SetPaused(m_Instance, aPaused);
+    }
+}
\ No newline at end of file
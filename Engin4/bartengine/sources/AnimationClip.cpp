@@ -0,0 +1,62 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: AnimationClip.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <AnimationClip.h>
+#include <algorithm>
+
+bart::AnimationClip bart::AnimationClip::FromGrid(const int aColumns, const int aWidth, const int aHeight, const int aStart,
+                                                  const int aCount, const float aDelay, const bool aLoop)
+{
+    AnimationClip tClip;
+    tClip.m_Loop = aLoop;
+
+    for (int i = aStart; i < aStart + aCount; i++)
+    {
+        const int tRow = i / aColumns;
+        const int tCol = i - aColumns * tRow;
+
+        Rectangle tSource;
+        tSource.Set(aWidth * tCol, aHeight * tRow, aWidth, aHeight);
+        tClip.AddFrame(tSource, aDelay);
+    }
+
+    return tClip;
+}
+
+void bart::AnimationClip::AddFrame(const Rectangle& aSource, const float aDuration)
+{
+    // A frame always lasts a little, the instances never loop on the spot
+    m_Frames.push_back(aSource);
+    m_Durations.push_back(std::max(aDuration, 0.001f));
+}
+
+void bart::AnimationClip::AddEvent(const int aFrame, const std::string& aName)
+{
+    Event tEvent;
+    tEvent.Frame = aFrame;
+    tEvent.Name = aName;
+    m_Events.push_back(tEvent);
+}
\ No newline at end of file
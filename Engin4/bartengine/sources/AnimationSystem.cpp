@@ -0,0 +1,235 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: AnimationSystem.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <AnimationSystem.h>
+#include <Engine.h>
+#include <Camera.h>
+#include <cfloat>
+
+void bart::AnimationSystem::Clean()
+{
+    m_Clips.clear();
+    m_ClipNames.clear();
+    m_Instances.clear();
+    m_Slots.clear();
+    m_FreeSlots.clear();
+    m_Events.clear();
+}
+
+size_t bart::AnimationSystem::AddClip(const std::string& aName, const AnimationClip& aClip)
+{
+    const size_t tExisting = FindClip(aName);
+    if (tExisting != 0)
+    {
+        return tExisting;
+    }
+
+    m_Clips.push_back(aClip);
+    m_ClipNames[aName] = m_Clips.size();
+    return m_Clips.size();
+}
+
+size_t bart::AnimationSystem::FindClip(const std::string& aName) const
+{
+    const std::map<std::string, size_t>::const_iterator tItr = m_ClipNames.find(aName);
+    return tItr != m_ClipNames.end() ? tItr->second : 0;
+}
+
+size_t bart::AnimationSystem::Create()
+{
+    unsigned int tSlot;
+    if (m_FreeSlots.empty())
+    {
+        tSlot = static_cast<unsigned int>(m_Slots.size());
+        m_Slots.push_back(0);
+    }
+    else
+    {
+        tSlot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+    }
+
+    // Without bounds the instance is always on screen
+    Instance tInstance;
+    tInstance.MinX = -FLT_MAX;
+    tInstance.MinY = -FLT_MAX;
+    tInstance.MaxX = FLT_MAX;
+    tInstance.MaxY = FLT_MAX;
+    tInstance.Handle = tSlot + 1;
+
+    m_Slots[tSlot] = static_cast<unsigned int>(m_Instances.size());
+    m_Instances.push_back(tInstance);
+    return tSlot + 1;
+}
+
+void bart::AnimationSystem::Destroy(const size_t aInstance)
+{
+    if (aInstance == 0 || aInstance > m_Slots.size())
+    {
+        return;
+    }
+
+    // The last record fills the hole, the records stay packed
+    const unsigned int tIndex = m_Slots[aInstance - 1];
+    m_Instances[tIndex] = m_Instances.back();
+    m_Slots[m_Instances[tIndex].Handle - 1] = tIndex;
+    m_Instances.pop_back();
+
+    m_FreeSlots.push_back(static_cast<unsigned int>(aInstance - 1));
+}
+
+void bart::AnimationSystem::Play(const size_t aInstance, const size_t aClip, const float aSpeed)
+{
+    if (aClip == 0 || aClip > m_Clips.size() || m_Clips[aClip - 1].GetFrameCount() == 0)
+    {
+        return;
+    }
+
+    Instance& tInstance = m_Instances[m_Slots[aInstance - 1]];
+    tInstance.Clip = static_cast<unsigned int>(aClip - 1);
+    tInstance.Frame = 0;
+    tInstance.Time = 0.0f;
+    tInstance.Speed = aSpeed;
+    tInstance.Flags = PLAYING;
+}
+
+void bart::AnimationSystem::Stop(const size_t aInstance)
+{
+    Instance& tInstance = m_Instances[m_Slots[aInstance - 1]];
+    tInstance.Frame = 0;
+    tInstance.Time = 0.0f;
+    tInstance.Flags = 0;
+}
+
+void bart::AnimationSystem::SetPaused(const size_t aInstance, const bool aPaused)
+{
+    Instance& tInstance = m_Instances[m_Slots[aInstance - 1]];
+    if (aPaused)
+    {
+        tInstance.Flags |= PAUSED;
+    }
+    else
+    {
+        tInstance.Flags &= ~PAUSED;
+    }
+}
+
+void bart::AnimationSystem::SetBounds(const size_t aInstance, const Rectangle& aBounds)
+{
+    Instance& tInstance = m_Instances[m_Slots[aInstance - 1]];
+    tInstance.MinX = static_cast<float>(aBounds.X);
+    tInstance.MinY = static_cast<float>(aBounds.Y);
+    tInstance.MaxX = static_cast<float>(aBounds.X + aBounds.W);
+    tInstance.MaxY = static_cast<float>(aBounds.Y + aBounds.H);
+}
+
+bool bart::AnimationSystem::IsPlaying(const size_t aInstance) const
+{
+    return (m_Instances[m_Slots[aInstance - 1]].Flags & PLAYING) != 0;
+}
+
+const bart::Rectangle& bart::AnimationSystem::GetFrame(const size_t aInstance) const
+{
+    const Instance& tInstance = m_Instances[m_Slots[aInstance - 1]];
+    return m_Clips[tInstance.Clip].GetFrame(tInstance.Frame);
+}
+
+int bart::AnimationSystem::GetFrameIndex(const size_t aInstance) const
+{
+    return m_Instances[m_Slots[aInstance - 1]].Frame;
+}
+
+void bart::AnimationSystem::Update(const float aDelta)
+{
+    m_Events.clear();
+    m_Advanced = 0;
+    m_Clock += aDelta;
+
+    // Same visibility test as the culling of the world, an instance off screen keeps its frame
+    float tLeft = -FLT_MAX;
+    float tTop = -FLT_MAX;
+    float tRight = FLT_MAX;
+    float tBottom = FLT_MAX;
+
+    Camera* tCamera = Engine::Instance().GetGraphic().GetCamera();
+    if (tCamera != nullptr)
+    {
+        tLeft = static_cast<float>(tCamera->GetX());
+        tTop = static_cast<float>(tCamera->GetY());
+        tRight = static_cast<float>(tCamera->GetX() + tCamera->GetWidth());
+        tBottom = static_cast<float>(tCamera->GetY() + tCamera->GetHeight());
+    }
+
+    for (Instance& tInstance : m_Instances)
+    {
+        if ((tInstance.Flags & (PLAYING | PAUSED)) != PLAYING || tInstance.MinX >= tRight || tInstance.MaxX <= tLeft ||
+            tInstance.MinY > tBottom || tInstance.MaxY < tTop)
+        {
+            continue;
+        }
+
+        const AnimationClip& tClip = m_Clips[tInstance.Clip];
+        tInstance.Time += aDelta * tInstance.Speed;
+        m_Advanced++;
+
+        while (tInstance.Time >= tClip.GetDuration(tInstance.Frame))
+        {
+            tInstance.Time -= tClip.GetDuration(tInstance.Frame);
+            tInstance.Frame++;
+
+            if (tInstance.Frame >= tClip.GetFrameCount())
+            {
+                if (!tClip.IsLooping())
+                {
+                    tInstance.Frame = static_cast<unsigned short>(tClip.GetFrameCount() - 1);
+                    tInstance.Flags &= ~PLAYING;
+                    break;
+                }
+
+                tInstance.Frame = 0;
+            }
+
+            if (!tClip.GetEvents().empty())
+            {
+                RaiseEvents(tInstance, tClip);
+            }
+        }
+    }
+}
+
+void bart::AnimationSystem::RaiseEvents(const Instance& aInstance, const AnimationClip& aClip)
+{
+    for (const AnimationClip::Event& tEvent : aClip.GetEvents())
+    {
+        if (tEvent.Frame == aInstance.Frame)
+        {
+            FiredEvent tFired;
+            tFired.Instance = aInstance.Handle;
+            tFired.Name = &tEvent.Name;
+            m_Events.push_back(tFired);
+        }
+    }
+}
\ No newline at end of file
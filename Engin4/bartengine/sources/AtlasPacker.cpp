@@ -0,0 +1,168 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: AtlasPacker.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <AtlasPacker.h>
+#include <climits>
+
+void bart::AtlasPacker::Init(const int aWidth, const int aHeight)
+{
+    m_Width = aWidth;
+    m_Height = aHeight;
+    m_UsedArea = 0;
+
+    m_Skyline.clear();
+    m_Skyline.push_back({0, 0, aWidth});
+}
+
+bool bart::AtlasPacker::Pack(const int aWidth, const int aHeight, Rectangle* aResult)
+{
+    int tBestIndex = -1;
+    int tBestBottom = INT_MAX;
+    int tBestWidth = INT_MAX;
+    int tBestY = 0;
+
+    for (size_t i = 0; i < m_Skyline.size(); i++)
+    {
+        int tY;
+        if (Fit(i, aWidth, aHeight, &tY))
+        {
+            const int tBottom = tY + aHeight;
+            if (tBottom < tBestBottom || (tBottom == tBestBottom && m_Skyline[i].Width < tBestWidth))
+            {
+                tBestIndex = static_cast<int>(i);
+                tBestBottom = tBottom;
+                tBestWidth = m_Skyline[i].Width;
+                tBestY = tY;
+            }
+        }
+    }
+
+    if (tBestIndex < 0)
+    {
+        return false;
+    }
+
+    const int tX = m_Skyline[tBestIndex].X;
+    AddLevel(static_cast<size_t>(tBestIndex), tX, tBestY, aWidth, aHeight);
+    m_UsedArea += aWidth * aHeight;
+
+    aResult->Set(tX, tBestY, aWidth, aHeight);
+    return true;
+}
+
+float bart::AtlasPacker::GetOccupancy() const
+{
+    if (m_Width == 0 || m_Height == 0)
+    {
+        return 0.0f;
+    }
+
+    return static_cast<float>(m_UsedArea) / static_cast<float>(m_Width * m_Height);
+}
+
+bool bart::AtlasPacker::Fit(const size_t aIndex, const int aWidth, const int aHeight, int* aY) const
+{
+    const int tX = m_Skyline[aIndex].X;
+    if (tX + aWidth > m_Width)
+    {
+        return false;
+    }
+
+    int tWidthLeft = aWidth;
+    int tY = m_Skyline[aIndex].Y;
+    size_t tIndex = aIndex;
+
+    while (tWidthLeft > 0)
+    {
+        if (tIndex >= m_Skyline.size())
+        {
+            return false;
+        }
+
+        if (m_Skyline[tIndex].Y > tY)
+        {
+            tY = m_Skyline[tIndex].Y;
+        }
+
+        if (tY + aHeight > m_Height)
+        {
+            return false;
+        }
+
+        tWidthLeft -= m_Skyline[tIndex].Width;
+        tIndex++;
+    }
+
+    *aY = tY;
+    return true;
+}
+
+void bart::AtlasPacker::AddLevel(const size_t aIndex, const int aX, const int aY, const int aWidth, const int aHeight)
+{
+    m_Skyline.insert(m_Skyline.begin() + aIndex, {aX, aY + aHeight, aWidth});
+
+    // Shrink or remove the nodes now hidden under the new level
+    for (size_t i = aIndex + 1; i < m_Skyline.size();)
+    {
+        const SkylineNode& tPrevious = m_Skyline[i - 1];
+        const int tPreviousEnd = tPrevious.X + tPrevious.Width;
+
+        if (m_Skyline[i].X >= tPreviousEnd)
+        {
+            break;
+        }
+
+        const int tShrink = tPreviousEnd - m_Skyline[i].X;
+        m_Skyline[i].X += tShrink;
+        m_Skyline[i].Width -= tShrink;
+
+        if (m_Skyline[i].Width > 0)
+        {
+            break;
+        }
+
+        m_Skyline.erase(m_Skyline.begin() + i);
+    }
+
+    Merge();
+}
+
+void bart::AtlasPacker::Merge()
+{
+    for (size_t i = 0; i + 1 < m_Skyline.size();)
+    {
+        if (m_Skyline[i].Y == m_Skyline[i + 1].Y)
+        {
+            m_Skyline[i].Width += m_Skyline[i + 1].Width;
+            m_Skyline.erase(m_Skyline.begin() + i + 1);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
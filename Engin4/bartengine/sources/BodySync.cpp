@@ -0,0 +1,68 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: BodySync.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <BodySync.h>
+#include <Transform.h>
+
+void bart::BodySync::Clean()
+{
+    m_Targets.clear();
+}
+
+void bart::BodySync::Bind(const size_t aBody, Transform* aTransform)
+{
+    if (aBody != 0)
+    {
+        m_Targets[aBody] = aTransform;
+    }
+}
+
+void bart::BodySync::Unbind(const size_t aBody)
+{
+    m_Targets.erase(aBody);
+}
+
+void bart::BodySync::Update(IPhysic& aPhysic)
+{
+    if (m_Targets.empty())
+    {
+        return;
+    }
+
+    const size_t tCount = aPhysic.SyncTransforms(m_Transforms);
+
+    for (size_t i = 0; i < tCount; i++)
+    {
+        std::map<size_t, Transform*>::iterator tItr = m_Targets.find(m_Transforms.Ids[i]);
+        if (tItr != m_Targets.end())
+        {
+            Transform* tTransform = tItr->second;
+            tTransform->X = m_Transforms.X[i];
+            tTransform->Y = m_Transforms.Y[i];
+            tTransform->Angle = m_Transforms.Angle[i];
+        }
+    }
+}
@@ -40,6 +40,8 @@
 #include <iostream>
 #include <MathHelper.h>
 #include <box2d/Dynamics/Contacts/b2Contact.h>
+#include <algorithm>
+#include <functional>
 
 /*
  *  http://www.box2d.org/manual.html
@@ -49,11 +51,15 @@
  *  - Generally physics engines for games like a time step at least as fast as 60Hz or 1/60 seconds.
  *  - http://www.iforce2d.net/b2dtut
  */
+const unsigned int bart::Box2dPhysicService::SLOT_BITS = 20;
+const unsigned int bart::Box2dPhysicService::SLOT_MASK = (1u << SLOT_BITS) - 1;
 const float32 bart::Box2dPhysicService::WORLD_SCALE = 30.0f;
 const float32 bart::Box2dPhysicService::WORLD_SCALE_INV = 1.0f / WORLD_SCALE;
 const float32 bart::Box2dPhysicService::TIME_STEP = 1.0f / 60.0f;
+const int32 bart::Box2dPhysicService::MAX_SUBSTEPS = 5;
 const int32 bart::Box2dPhysicService::VELOCITY_ITERATION = 8;
 const int32 bart::Box2dPhysicService::POSITION_ITERATION = 3;
+const size_t bart::Box2dPhysicService::CONTACT_CAPACITY = 4096;
 
 b2BodyType GetB2DBodyType(const bart::EBodyType aType)
 {
@@ -73,70 +79,28 @@ b2BodyType GetB2DBodyType(const bart::EBodyType aType)
 class ContactListener final : public b2ContactListener
 {
 public:
+    explicit ContactListener(bart::Box2dPhysicService* aService) : m_Service(aService) {}
     virtual ~ContactListener() = default;
     void BeginContact(b2Contact* aContact) override;
     void EndContact(b2Contact* aContact) override;
+
+private:
+    bart::Box2dPhysicService* m_Service;
 };
 
 void ContactListener::BeginContact(b2Contact* aContact)
 {
-    const b2Manifold* _manifold = aContact->GetManifold();
-
-    b2WorldManifold _worldManifold;
-    aContact->GetWorldManifold(&_worldManifold);
-
-    b2Fixture* tFixtureA = aContact->GetFixtureA();
-    b2Fixture* tFixtureB = aContact->GetFixtureB();
-
-    b2Body* tBodyA = tFixtureA->GetBody();
-    b2Body* tBodyB = tFixtureB->GetBody();
-
-    bart::Entity* tEntityA = static_cast<bart::Entity*>(tBodyA->GetUserData());
-    bart::Entity* tEntityB = static_cast<bart::Entity*>(tBodyB->GetUserData());
-
-    if (tEntityA && tEntityB && aContact->IsTouching())
+    if (aContact->IsTouching())
     {
-        bart::ContactInfo* tInfo = new bart::ContactInfo();
-        tInfo->ContactType = bart::BEGIN_CONTACT;
-        tInfo->EntityA = tEntityA;
-        tInfo->EntityB = tEntityB;
-
-        bart::IPhysic& tPhysic = bart::Engine::Instance().GetPhysic();
-        for (int i = 0; i < _manifold->pointCount; i++)
-        {
-            tInfo->ContactPoints.push_back(
-                {
-                    tPhysic.ToWorld(_worldManifold.points[i].x),
-                    tPhysic.ToWorld(-_worldManifold.points[i].y)
-                });
-        }
-
-        tInfo->NormalX = _worldManifold.normal.x;
-        tInfo->NormalY = _worldManifold.normal.y;
-        tPhysic.AddContactInfo(tInfo);
+        m_Service->AddContact(bart::BEGIN_CONTACT, aContact);
     }
 }
 
 void ContactListener::EndContact(b2Contact* aContact)
 {
-    b2Fixture* tFixtureA = aContact->GetFixtureA();
-    b2Fixture* tFixtureB = aContact->GetFixtureB();
-
-    b2Body* tBodyA = tFixtureA->GetBody();
-    b2Body* tBodyB = tFixtureB->GetBody();
-
-    bart::Entity* tEntityA = static_cast<bart::Entity*>(tBodyA->GetUserData());
-    bart::Entity* tEntityB = static_cast<bart::Entity*>(tBodyB->GetUserData());
-
-    if (tEntityA && tEntityB && !aContact->IsTouching())
+    if (!aContact->IsTouching())
     {
-        bart::IPhysic& tPhysic = bart::Engine::Instance().GetPhysic();
-
-        bart::ContactInfo* tInfo = new bart::ContactInfo();
-        tInfo->ContactType = bart::END_CONTACT;
-        tInfo->EntityA = tEntityA;
-        tInfo->EntityB = tEntityB;
-        tPhysic.AddContactInfo(tInfo);
+        m_Service->AddContact(bart::END_CONTACT, aContact);
     }
 }
 
@@ -154,7 +118,12 @@ bool bart::Box2dPhysicService::Initialize()
 {
     const b2Vec2 tGravity = {0.0f, -10.0f};
     m_physicWorld = new b2World(tGravity);
-    m_physicWorld->SetContactListener(new ContactListener());
+    m_physicWorld->SetContactListener(new ContactListener(this));
+    m_contacts.resize(CONTACT_CAPACITY);
+    m_contactOrder.reserve(CONTACT_CAPACITY);
+    m_contactPoints.reserve(b2_maxManifoldPoints);
+    m_contactHead = 0;
+    m_contactCount = 0;
     m_running = true;
     return true;
 }
@@ -170,14 +139,19 @@ bool bart::Box2dPhysicService::Initialize()
 //
 void bart::Box2dPhysicService::Clean()
 {
-    for (TBodyMap::iterator tItr = m_bodyList.begin(); tItr != m_bodyList.end(); ++tItr)
+    StopWorker();
+
+    for (Box2dBodyInfo& tInfo : m_bodyList)
     {
-        tItr->second->Body->DestroyFixture(tItr->second->Fixture);
-        m_physicWorld->DestroyBody(tItr->second->Body);
-        delete tItr->second;
+        tInfo.Body->DestroyFixture(tInfo.Fixture);
+        m_physicWorld->DestroyBody(tInfo.Body);
     }
 
     m_bodyList.clear();
+    m_bodySlots.clear();
+    m_bodyGenerations.clear();
+    m_freeSlots.clear();
+    m_contactCount = 0;
 
     m_running = false;
 
@@ -232,6 +206,11 @@ float bart::Box2dPhysicService::ToPhysic(const float aValue)
 //
 void bart::Box2dPhysicService::SetGravity(const float aX, const float aY)
 {
+    if (Defer([this, aX, aY]() { SetGravity(aX, aY); }))
+    {
+        return;
+    }
+
     const b2Vec2 tGravity = {aX, aY};
     m_physicWorld->SetGravity(tGravity);
     Awake(true);
@@ -249,6 +228,11 @@ void bart::Box2dPhysicService::SetGravity(const float aX, const float aY)
 //  
 void bart::Box2dPhysicService::Awake(const bool aValue)
 {
+    if (Defer([this, aValue]() { Awake(aValue); }))
+    {
+        return;
+    }
+
     b2Body* tBody = m_physicWorld->GetBodyList();
     while (tBody != nullptr)
     {
@@ -266,7 +250,7 @@ void bart::Box2dPhysicService::Awake(const bool aValue)
 //                                                  |___/ 
 //  \brief Creates and add a body in the world
 //  \param aMaterial contains all the information needed to initialize the body
-//  \return an Id to find back the body in the body list
+//  \return an Id to find back the body in the body list, 0 when there is no world
 //
 size_t bart::Box2dPhysicService::CreateBody(const PhysicMaterial& aMaterial)
 {
@@ -274,63 +258,105 @@ size_t bart::Box2dPhysicService::CreateBody(const PhysicMaterial& aMaterial)
 
     if (m_physicWorld)
     {
-        const float tHalfWidth = ToPhysic(aMaterial.Width) * 0.5f;
-        const float tHalfHeight = ToPhysic(aMaterial.Height) * 0.5f;
-
-        b2BodyDef tBodyDef;
-        tBodyDef.userData = aMaterial.BodyUserData;
-        tBodyDef.position.x = ToPhysic(aMaterial.PosX) + tHalfWidth;
-        tBodyDef.position.y = -ToPhysic(aMaterial.PosY) - tHalfHeight;
-        tBodyDef.angle = aMaterial.Angle;
-        tBodyDef.linearVelocity.Set(aMaterial.VelocityX, aMaterial.VelocityY);
-        tBodyDef.angularVelocity = aMaterial.AngularVelocity;
-        tBodyDef.linearDamping = aMaterial.Damping;
-        tBodyDef.angularDamping = aMaterial.AngularDamping;
-        tBodyDef.allowSleep = aMaterial.AllowSleep;
-        tBodyDef.awake = aMaterial.Awake;
-        tBodyDef.fixedRotation = aMaterial.FixedRotation;
-        tBodyDef.bullet = aMaterial.Bullet;
-        tBodyDef.type = GetB2DBodyType(aMaterial.BodyType);
-        tBodyDef.active = aMaterial.Active;
-        tBodyDef.gravityScale = aMaterial.GravityScale;
-
-        b2Body* tBody = m_physicWorld->CreateBody(&tBodyDef);
-        tId = reinterpret_cast<size_t>(tBody);
-
-        m_bodyList[tId] = new Box2dBodyInfo();
-        m_bodyList[tId]->Body = tBody;
-        m_bodyList[tId]->Width = aMaterial.Width;
-        m_bodyList[tId]->Height = aMaterial.Height;
-        m_bodyList[tId]->HalfWidth = tHalfWidth;
-        m_bodyList[tId]->HalfHeight = tHalfHeight;
-
-        b2FixtureDef tFixtureDef;
-
-        if (aMaterial.Shape == RECTANGLE_SHAPE)
+        unsigned int tSlot;
+        if (m_freeSlots.empty())
+        {
+            tSlot = static_cast<unsigned int>(m_bodySlots.size());
+            m_bodySlots.push_back(0);
+            m_bodyGenerations.push_back(0);
+        }
+        else
         {
-            b2PolygonShape* tPolygonShape = new b2PolygonShape();
-            tPolygonShape->SetAsBox(tHalfWidth, tHalfHeight);
-            tFixtureDef.shape = tPolygonShape;
+            tSlot = m_freeSlots.back();
+            m_freeSlots.pop_back();
         }
-        else if (aMaterial.Shape == CIRCLE_SHAPE)
+
+        m_bodySlots[tSlot] = static_cast<unsigned int>(m_bodyList.size());
+        tId = static_cast<size_t>(m_bodyGenerations[tSlot]) << SLOT_BITS | (tSlot + 1);
+
+        // The id is valid right away, the Box2D body is created later when a step is running
+        Box2dBodyInfo tInfo;
+        tInfo.Body = nullptr;
+        tInfo.Fixture = nullptr;
+        tInfo.Width = aMaterial.Width;
+        tInfo.Height = aMaterial.Height;
+        tInfo.HalfWidth = ToPhysic(aMaterial.Width) * 0.5f;
+        tInfo.HalfHeight = ToPhysic(aMaterial.Height) * 0.5f;
+        tInfo.Slot = tSlot;
+        tInfo.CurrentX = ToPhysic(aMaterial.PosX) + tInfo.HalfWidth;
+        tInfo.CurrentY = -ToPhysic(aMaterial.PosY) - tInfo.HalfHeight;
+        tInfo.CurrentAngle = aMaterial.Angle;
+        tInfo.PreviousX = tInfo.CurrentX;
+        tInfo.PreviousY = tInfo.CurrentY;
+        tInfo.PreviousAngle = tInfo.CurrentAngle;
+        tInfo.VelocityX = aMaterial.VelocityX;
+        tInfo.VelocityY = aMaterial.VelocityY;
+        tInfo.AngularVelocity = aMaterial.AngularVelocity;
+        tInfo.Mass = 0.0f;
+        tInfo.Moving = false;
+        m_bodyList.push_back(tInfo);
+
+        if (!Defer([this, tId, aMaterial]() { BuildBody(tId, aMaterial); }))
         {
-            b2CircleShape* tCircleShape = new b2CircleShape();
-            tCircleShape->m_radius = std::max<float>(tHalfWidth, tHalfHeight);
-            tFixtureDef.shape = tCircleShape;
+            BuildBody(tId, aMaterial);
         }
+    }
 
-        tFixtureDef.userData = aMaterial.FixtureUserData;
-        tFixtureDef.friction = aMaterial.Friction;
-        tFixtureDef.restitution = aMaterial.Restitution;
-        tFixtureDef.density = aMaterial.Density;
-        tFixtureDef.isSensor = aMaterial.Sensor;
+    return tId;
+}
 
-        m_bodyList[tId]->Fixture = tBody->CreateFixture(&tFixtureDef);
+void bart::Box2dPhysicService::BuildBody(const size_t aId, const PhysicMaterial& aMaterial)
+{
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo == nullptr)
+    {
+        return;
+    }
 
-        SAFE_DELETE(tFixtureDef.shape);
+    b2BodyDef tBodyDef;
+    tBodyDef.userData = aMaterial.BodyUserData;
+    tBodyDef.position.x = tInfo->CurrentX;
+    tBodyDef.position.y = tInfo->CurrentY;
+    tBodyDef.angle = aMaterial.Angle;
+    tBodyDef.linearVelocity.Set(aMaterial.VelocityX, aMaterial.VelocityY);
+    tBodyDef.angularVelocity = aMaterial.AngularVelocity;
+    tBodyDef.linearDamping = aMaterial.Damping;
+    tBodyDef.angularDamping = aMaterial.AngularDamping;
+    tBodyDef.allowSleep = aMaterial.AllowSleep;
+    tBodyDef.awake = aMaterial.Awake;
+    tBodyDef.fixedRotation = aMaterial.FixedRotation;
+    tBodyDef.bullet = aMaterial.Bullet;
+    tBodyDef.type = GetB2DBodyType(aMaterial.BodyType);
+    tBodyDef.active = aMaterial.Active;
+    tBodyDef.gravityScale = aMaterial.GravityScale;
+
+    b2Body* tBody = m_physicWorld->CreateBody(&tBodyDef);
+
+    b2FixtureDef tFixtureDef;
+
+    if (aMaterial.Shape == RECTANGLE_SHAPE)
+    {
+        b2PolygonShape* tPolygonShape = new b2PolygonShape();
+        tPolygonShape->SetAsBox(tInfo->HalfWidth, tInfo->HalfHeight);
+        tFixtureDef.shape = tPolygonShape;
+    }
+    else if (aMaterial.Shape == CIRCLE_SHAPE)
+    {
+        b2CircleShape* tCircleShape = new b2CircleShape();
+        tCircleShape->m_radius = std::max<float>(tInfo->HalfWidth, tInfo->HalfHeight);
+        tFixtureDef.shape = tCircleShape;
     }
 
-    return tId;
+    tFixtureDef.userData = aMaterial.FixtureUserData;
+    tFixtureDef.friction = aMaterial.Friction;
+    tFixtureDef.restitution = aMaterial.Restitution;
+    tFixtureDef.density = aMaterial.Density;
+    tFixtureDef.isSensor = aMaterial.Sensor;
+
+    tInfo->Body = tBody;
+    tInfo->Fixture = tBody->CreateFixture(&tFixtureDef);
+
+    SAFE_DELETE(tFixtureDef.shape);
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -340,7 +366,7 @@ size_t bart::Box2dPhysicService::CreateBody(const PhysicMaterial& aMaterial)
 //  | |_| |  __/ |_ | || | | (_| | | | \__ \  _| (_) | |  | | | | | |
 //   \____|\___|\__||_||_|  \__,_|_| |_|___/_|  \___/|_|  |_| |_| |_|
 //                                                                   
-//  \brief Gets the body's transform. You need to update your visuals to fit Box2D's transforms
+//  \brief Gets the body's transform after the last step, the one to start from when the body is moved
 //  \param aId the body's id
 //  \param aX the body's x position
 //  \param aY the body's y position
@@ -348,16 +374,33 @@ size_t bart::Box2dPhysicService::CreateBody(const PhysicMaterial& aMaterial)
 //
 void bart::Box2dPhysicService::GetTransform(const size_t aId, float* aX, float* aY, float* aAngle)
 {
-    if (m_bodyList.count(aId) > 0)
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
-        b2Body* tBody = m_bodyList[aId]->Body;
-        if (tBody != nullptr)
-        {
-            const b2Vec2 tPosition = tBody->GetPosition();
-            *aX = ToWorld(tPosition.x - m_bodyList[aId]->HalfWidth);
-            *aY = -ToWorld(tPosition.y + m_bodyList[aId]->HalfHeight);
-            *aAngle = -tBody->GetAngle() * TO_DEGREES;
-        }
+        GetInterpolated(*tInfo, 1.0f, aX, aY, aAngle);
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+//    ____      _   ___       _                       _       _           _ _____                     __                      
+//   / ___| ___| |_|_ _|_ __ | |_ ___ _ __ _ __   ___ | | __ _| |_ ___  __| |_   _| __ __ _ _ __  ___ / _| ___  _ __ _ __ ___  
+//  | |  _ / _ \ __|| || '_ \| __/ _ \ '__| '_ \ / _ \| |/ _` | __/ _ \/ _` | | || '__/ _` | '_ \/ __| |_ / _ \| '__| '_ ` _ \ 
+//  | |_| |  __/ |_ | || | | | ||  __/ |  | |_) | (_) | | (_| | ||  __/ (_| | | || | | (_| | | | \__ \  _| (_) | |  | | | | | |
+//   \____|\___|\__|___|_| |_|\__\___|_|  | .__/ \___/|_|\__,_|\__\___|\__,_| |_||_|  \__,_|_| |_|___/_|  \___/|_|  |_| |_| |_|
+//                                        |_|                                                                                  
+//  \brief Gets the body's transform between the last two steps for the time left in the accumulator. You need to
+//         update your visuals to fit Box2D's transforms, setting it back on the body would slow the body down
+//  \param aId the body's id
+//  \param aX the body's x position
+//  \param aY the body's y position
+//  \param aAngle the body's rotation angle in degrees
+//
+void bart::Box2dPhysicService::GetInterpolatedTransform(const size_t aId, float* aX, float* aY, float* aAngle)
+{
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
+    {
+        GetInterpolated(*tInfo, m_interpolation, aX, aY, aAngle);
     }
 }
 
@@ -368,7 +411,8 @@ void bart::Box2dPhysicService::GetTransform(const size_t aId, float* aX, float*
 //   ___) |  __/ |_ | || | | (_| | | | \__ \  _| (_) | |  | | | | | |
 //  |____/ \___|\__||_||_|  \__,_|_| |_|___/_|  \___/|_|  |_| |_| |_|
 //                                                                   
-//  \brief Sets the body's transform.
+//  \brief Sets the body's transform. Called while the world steps on the physic thread, it is applied once the steps
+//         are over and replaces their result for this body
 //  \param aId the body's id
 //  \param aX the body's x position
 //  \param aY the body's y position
@@ -376,15 +420,64 @@ void bart::Box2dPhysicService::GetTransform(const size_t aId, float* aX, float*
 //
 void bart::Box2dPhysicService::SetTransform(const size_t aId, const float aX, const float aY, const float aAngle)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aX, aY, aAngle]() { SetTransform(aId, aX, aY, aAngle); }))
     {
-        const float tX = ToPhysic(aX) + m_bodyList[aId]->HalfWidth;
-        const float tY = ToPhysic(aY) + m_bodyList[aId]->HalfHeight;
-        m_bodyList[aId]->Body->SetTransform({tX, -tY}, aAngle * TO_RADIANS);
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
+    {
+        const float tX = ToPhysic(aX) + tInfo->HalfWidth;
+        const float tY = ToPhysic(aY) + tInfo->HalfHeight;
+        tInfo->Body->SetTransform({tX, -tY}, aAngle * TO_RADIANS);
+
+        // Moved, not simulated, there is nothing to interpolate from
+        tInfo->CurrentX = tInfo->PreviousX = tX;
+        tInfo->CurrentY = tInfo->PreviousY = -tY;
+        tInfo->CurrentAngle = tInfo->PreviousAngle = aAngle * TO_RADIANS;
 
         // https://github.com/erincatto/Box2D/issues/357
-        m_bodyList[aId]->Body->SetAwake(true);
+        tInfo->Body->SetAwake(true);
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+//   ____                  _____                     __                          
+//  / ___| _   _ _ __   __|_   _| __ __ _ _ __  ___ / _| ___  _ __ _ __ ___  ___ 
+//  \___ \| | | | '_ \ / __|| || '__/ _` | '_ \/ __| |_ / _ \| '__| '_ ` _ \/ __|
+//   ___) | |_| | | | | (__ | || | | (_| | | | \__ \  _| (_) | |  | | | | | \__ \
+//  |____/ \__, |_| |_|\___||_||_|  \__,_|_| |_|___/_|  \___/|_|  |_| |_| |_|___/
+//         |___/                                                                 
+//  \brief Gets the transforms of all the moving bodies in one pass, the awake dynamic and kinematic bodies and the ones
+//         that fell asleep during the last steps. The other bodies did not move
+//  \param aTransforms receives the ids and the transforms in world units, its arrays only grow
+//  \return the number of bodies written
+//
+size_t bart::Box2dPhysicService::SyncTransforms(BodyTransforms& aTransforms)
+{
+    if (aTransforms.Ids.size() < m_bodyList.size())
+    {
+        aTransforms.Ids.resize(m_bodyList.size());
+        aTransforms.X.resize(m_bodyList.size());
+        aTransforms.Y.resize(m_bodyList.size());
+        aTransforms.Angle.resize(m_bodyList.size());
+    }
+
+    size_t tCount = 0;
+
+    for (const Box2dBodyInfo& tInfo : m_bodyList)
+    {
+        if (tInfo.Moving)
+        {
+            aTransforms.Ids[tCount] = static_cast<size_t>(m_bodyGenerations[tInfo.Slot]) << SLOT_BITS | (tInfo.Slot + 1);
+            GetInterpolated(tInfo, m_interpolation, &aTransforms.X[tCount], &aTransforms.Y[tCount], &aTransforms.Angle[tCount]);
+            tCount++;
+        }
     }
+
+    aTransforms.Count = tCount;
+    return tCount;
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -403,18 +496,24 @@ void bart::Box2dPhysicService::SetTransform(const size_t aId, const float aX, co
 //
 void bart::Box2dPhysicService::ApplyImpulse(const size_t aId, const float aX, const float aY, const bool aWorld)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aX, aY, aWorld]() { ApplyImpulse(aId, aX, aY, aWorld); }))
+    {
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
         b2Vec2 tForce = {aX, -aY};
 
         if (aWorld)
         {
-            tForce = m_bodyList[aId]->Body->GetWorldVector(tForce);
+            tForce = tInfo->Body->GetWorldVector(tForce);
         }
 
-        if (m_bodyList[aId]->Body->GetType() != b2_staticBody)
+        if (tInfo->Body->GetType() != b2_staticBody)
         {
-            m_bodyList[aId]->Body->ApplyLinearImpulse(tForce, m_bodyList[aId]->Body->GetWorldCenter());
+            tInfo->Body->ApplyLinearImpulse(tForce, tInfo->Body->GetWorldCenter());
         }
     }
 }
@@ -435,18 +534,24 @@ void bart::Box2dPhysicService::ApplyImpulse(const size_t aId, const float aX, co
 //
 void bart::Box2dPhysicService::ApplyForce(const size_t aId, const float aX, const float aY, const bool aWorld)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aX, aY, aWorld]() { ApplyForce(aId, aX, aY, aWorld); }))
+    {
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
         b2Vec2 tForce = {aX, -aY};
 
         if (aWorld)
         {
-            tForce = m_bodyList[aId]->Body->GetWorldVector(tForce);
+            tForce = tInfo->Body->GetWorldVector(tForce);
         }
 
-        if (m_bodyList[aId]->Body->GetType() != b2_staticBody)
+        if (tInfo->Body->GetType() != b2_staticBody)
         {
-            m_bodyList[aId]->Body->ApplyForce(tForce, m_bodyList[aId]->Body->GetWorldCenter());
+            tInfo->Body->ApplyForce(tForce, tInfo->Body->GetWorldCenter());
         }
     }
 }
@@ -465,11 +570,17 @@ void bart::Box2dPhysicService::ApplyForce(const size_t aId, const float aX, cons
 //
 void bart::Box2dPhysicService::ApplyTorque(const size_t aId, const float aTorque)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aTorque]() { ApplyTorque(aId, aTorque); }))
+    {
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
-        if (m_bodyList[aId]->Body->GetType() != b2_staticBody)
+        if (tInfo->Body->GetType() != b2_staticBody)
         {
-            m_bodyList[aId]->Body->ApplyTorque(aTorque);
+            tInfo->Body->ApplyTorque(aTorque);
         }
     }
 }
@@ -489,11 +600,17 @@ void bart::Box2dPhysicService::ApplyTorque(const size_t aId, const float aTorque
 //
 void bart::Box2dPhysicService::ApplyAngularImpulse(const size_t aId, const float aImpulse)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aImpulse]() { ApplyAngularImpulse(aId, aImpulse); }))
     {
-        if (m_bodyList[aId]->Body->GetType() != b2_staticBody)
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
+    {
+        if (tInfo->Body->GetType() != b2_staticBody)
         {
-            m_bodyList[aId]->Body->ApplyAngularImpulse(aImpulse);
+            tInfo->Body->ApplyAngularImpulse(aImpulse);
         }
     }
 }
@@ -511,12 +628,27 @@ void bart::Box2dPhysicService::ApplyAngularImpulse(const size_t aId, const float
 //
 void bart::Box2dPhysicService::DestroyBody(const size_t aId)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId]() { DestroyBody(aId); }))
+    {
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
-        b2Body* tBody = m_bodyList[aId]->Body;
-        delete m_bodyList[aId];
-        m_bodyList.erase(aId);
-        m_scheduledBodyRemoval.insert(tBody);
+        // The contacts already raised with this body are not dispatched, nor those its removal raises
+        tInfo->Body->SetUserData(nullptr);
+        m_scheduledBodyRemoval.insert(tInfo->Body);
+
+        // The last record takes the place of the destroyed one, the list stays packed
+        const unsigned int tSlot = tInfo->Slot;
+        const unsigned int tIndex = m_bodySlots[tSlot];
+        m_bodyList[tIndex] = m_bodyList.back();
+        m_bodySlots[m_bodyList[tIndex].Slot] = tIndex;
+        m_bodyList.pop_back();
+
+        m_bodyGenerations[tSlot] = (m_bodyGenerations[tSlot] + 1) & (~0u >> SLOT_BITS);
+        m_freeSlots.push_back(tSlot);
     }
 }
 
@@ -532,10 +664,17 @@ void bart::Box2dPhysicService::DestroyBody(const size_t aId)
 //
 void bart::Box2dPhysicService::DestroyFixture(const size_t aId)
 {
-    if (m_bodyList.count(aId))
+    // In order with the commands before it, a body created or a fixture changed during the frame is there
+    if (Defer([this, aId]() { DestroyFixture(aId); }))
     {
-        m_scheduledFixtureRemoval.insert(m_bodyList[aId]->Fixture);
-        m_bodyList[aId]->Fixture = nullptr;
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr && tInfo->Fixture != nullptr)
+    {
+        m_scheduledFixtureRemoval.insert(tInfo->Fixture);
+        tInfo->Fixture = nullptr;
     }
 }
 
@@ -552,6 +691,11 @@ void bart::Box2dPhysicService::DestroyFixture(const size_t aId)
 //
 size_t bart::Box2dPhysicService::GetBodyCount()
 {
+    if (m_stepping)
+    {
+        return m_bodyCount;
+    }
+
     if (m_physicWorld != nullptr)
     {
         return m_physicWorld->GetBodyCount();
@@ -568,60 +712,205 @@ size_t bart::Box2dPhysicService::GetBodyCount()
 //   \___/| .__/ \__,_|\__,_|\__\___|
 //        |_|                        
 //  
-//  \brief Updates the physic world
+//  \brief Updates the physic world in fixed steps, as many as the elapsed time holds up to the max substeps. The
+//         time left is kept for the next Update and interpolates the transforms. On the physic thread the steps run
+//         until the next Update, the transforms and the contacts are one frame behind
+//  \param aDelta the elapsed time in seconds
 //
-void bart::Box2dPhysicService::Update()
+void bart::Box2dPhysicService::Update(const float aDelta)
 {
     if (m_running)
     {
-        m_physicWorld->Step(TIME_STEP, VELOCITY_ITERATION, POSITION_ITERATION);
+        // The steps started by the last Update are over before the game touches the world again
+        if (m_stepping)
+        {
+            FinishStep();
+        }
+        else
+        {
+            m_lastStepMilliseconds = 0.0f;
+        }
+
+        m_accumulator += aDelta;
 
-        for (std::list<ContactInfo*>::iterator tItr = m_contactList.begin(); tItr != m_contactList.end(); ++tItr)
+        // Slower than real time rather than more steps on a frame already late
+        const float tMaxTime = m_timeStep * static_cast<float>(m_maxSubsteps);
+        if (m_accumulator > tMaxTime)
         {
-            if ((*tItr)->ContactType == BEGIN_CONTACT)
+            m_accumulator = tMaxTime;
+        }
+
+        const int tSteps = static_cast<int>(m_accumulator / m_timeStep);
+        m_accumulator -= m_timeStep * static_cast<float>(tSteps);
+        m_interpolation = m_accumulator / m_timeStep;
+        m_droppedContacts = 0;
+        m_stepMilliseconds = 0.0f;
+        m_stepBroadPhase = BroadPhaseStats();
+
+        if (m_worker.joinable())
+        {
+            if (tSteps > 0)
             {
-                (*tItr)->EntityA->OnCollisionEnter((*tItr)->EntityB, (*tItr)->ContactPoints, (*tItr)->NormalX, (*tItr)->NormalY);
+                StartStep(tSteps);
             }
-            else if ((*tItr)->ContactType == END_CONTACT)
+        }
+        else
+        {
+            for (int i = 0; i < tSteps; i++)
             {
-                (*tItr)->EntityA->OnCollisionExit((*tItr)->EntityB);
+                StorePreviousStates();
+                m_physicWorld->Step(m_timeStep, m_velocityIterations, m_positionIterations);
+                m_stepMilliseconds += m_physicWorld->GetProfile().step;
+                AddBroadPhaseCounters();
             }
 
-            delete (*tItr);
+            StoreCurrentStates();
+            EndStep();
         }
+    }
+}
 
-        m_contactList.clear();
+// --------------------------------------------------------------------------------------------------------------------
+//   ____       _   _____ _                        _          _ 
+//  / ___|  ___| |_|_   _| |__  _ __ ___  __ _  __| | ___  __| |
+//  \___ \ / _ \ __| | | | '_ \| '__/ _ \/ _` |/ _` |/ _ \/ _` |
+//   ___) |  __/ |_  | | | | | | | |  __/ (_| | (_| |  __/ (_| |
+//  |____/ \___|\__| |_| |_| |_|_|  \___|\__,_|\__,_|\___|\__,_|
+//                                                              
+//  \brief Steps the world on a thread of its own while the frame is updated and rendered. The changes to the bodies
+//         made meanwhile are queued and applied in order at the next Update
+//  \param aThreaded true to start the physic thread, false to step on the calling thread again
+//
+void bart::Box2dPhysicService::SetThreaded(const bool aThreaded)
+{
+    if (aThreaded == m_worker.joinable())
+    {
+        return;
+    }
 
-        if (m_scheduledFixtureRemoval.size() > 0)
-        {
-            std::set<b2Fixture*>::iterator _itt = m_scheduledFixtureRemoval.begin();
-            const std::set<b2Fixture*>::iterator _end = m_scheduledFixtureRemoval.end();
+    if (aThreaded)
+    {
+        // The worker waits for the batch after the last one stepped, a worker started again does not step it twice
+        m_stopping = false;
+        m_worker = std::thread(&Box2dPhysicService::WorkerLoop, this, m_generation);
+    }
+    else
+    {
+        StopWorker();
+    }
+}
 
-            while (_itt != _end)
-            {
-                (*_itt)->GetBody()->DestroyFixture(*_itt);
-                ++_itt;
-            }
+// --------------------------------------------------------------------------------------------------------------------
+//   ____       _   ____        _               _____ _                        _     
+//  / ___|  ___| |_/ ___|  ___ | |_   _____ _ _|_   _| |__  _ __ ___  __ _  __| |___ 
+//  \___ \ / _ \ __\___ \ / _ \| \ \ / / _ \ '__|| | | '_ \| '__/ _ \/ _` |/ _` / __|
+//   ___) |  __/ |_ ___) | (_) | |\ V /  __/ |   | | | | | | | |  __/ (_| | (_| \__ \
+//  |____/ \___|\__|____/ \___/|_| \_/ \___|_|   |_| |_| |_|_|  \___|\__,_|\__,_|___/
+//
+//  \brief Solves the islands of a step, the groups of bodies touching or jointed together, on several threads. The
+//         bodies end up in the same state whatever the count, the contact callbacks are raised in the same order
+//  \param aThreads the threads solving the islands, the stepping one included. 1 solves them one after the other
+//
+void bart::Box2dPhysicService::SetSolverThreads(const int aThreads)
+{
+    if (Defer([this, aThreads]() { SetSolverThreads(aThreads); }))
+    {
+        return;
+    }
 
-            m_scheduledFixtureRemoval.clear();
-        }
+    m_physicWorld->SetThreadCount(std::max(aThreads, 1));
+}
 
-        if (m_scheduledBodyRemoval.size() > 0)
-        {
-            std::set<b2Body*>::iterator _itt = m_scheduledBodyRemoval.begin();
-            const std::set<b2Body*>::iterator _end = m_scheduledBodyRemoval.end();
+// --------------------------------------------------------------------------------------------------------------------
+//   ____       _ __        ___     _      ____        _                
+//  / ___|  ___| |\ \      / (_) __| | ___/ ___|  ___ | |_   _____ _ __ 
+//  \___ \ / _ \ __\ \ /\ / /| |/ _` |/ _ \___ \ / _ \| \ \ / / _ \ '__|
+//   ___) |  __/ |_ \ V  V / | | (_| |  __/___) | (_) | |\ V /  __/ |   
+//  |____/ \___|\__| \_/\_/  |_|\__,_|\___|____/ \___/|_| \_/ \___|_|   
+//
+//  \brief Solves the contacts four at a time with SSE, disabled by default. The contacts are solved in another order so
+//         the bodies do not end up exactly where the one at a time solver puts them
+//  \param aWide true for the wide solver, false to solve the contacts one at a time
+//
+void bart::Box2dPhysicService::SetWideSolver(const bool aWide)
+{
+    if (Defer([this, aWide]() { SetWideSolver(aWide); }))
+    {
+        return;
+    }
 
-            while (_itt != _end)
-            {
-                m_physicWorld->DestroyBody(*_itt);
-                ++_itt;
-            }
+    m_physicWorld->SetWideSolver(aWide);
+}
 
-            m_scheduledBodyRemoval.clear();
-        }
+// --------------------------------------------------------------------------------------------------------------------
+//   ____       _ __        ___     _       ____      _ _ _     _      
+//  / ___|  ___| |\ \      / (_) __| | ___ / ___|___ | | (_) __| | ___ 
+//  \___ \ / _ \ __\ \ /\ / /| |/ _` |/ _ \ |   / _ \| | | |/ _` |/ _ \
+//   ___) |  __/ |_ \ V  V / | | (_| |  __/ |__| (_) | | | | (_| |  __/
+//  |____/ \___|\__| \_/\_/  |_|\__,_|\___|\____\___/|_|_|_|\__,_|\___|
+//
+//  \brief Computes the manifolds of the box contacts four at a time with SSE, disabled by default. The manifolds are
+//         the same as the ones computed one at a time
+//  \param aWide true for the wide manifolds, false to compute them one at a time
+//
+void bart::Box2dPhysicService::SetWideCollide(const bool aWide)
+{
+    if (Defer([this, aWide]() { SetWideCollide(aWide); }))
+    {
+        return;
+    }
+
+    m_physicWorld->SetWideCollide(aWide);
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+//   ____       _   ____  _             
+//  / ___|  ___| |_/ ___|| |_ ___ _ __  
+//  \___ \ / _ \ __\___ \| __/ _ \ '_ \ 
+//   ___) |  __/ |_ ___) | ||  __/ |_) |
+//  |____/ \___|\__|____/ \__\___| .__/ 
+//                              |_|    
+//  \brief Sets the fixed step of the simulation
+//  \param aStep the time simulated by a step in seconds
+//  \param aMaxSubsteps the steps at most per Update, the time over it is dropped to catch up with real time
+//
+void bart::Box2dPhysicService::SetStep(const float aStep, const int aMaxSubsteps)
+{
+    if (Defer([this, aStep, aMaxSubsteps]() { SetStep(aStep, aMaxSubsteps); }))
+    {
+        return;
+    }
+
+    if (aStep > 0.0f && aMaxSubsteps > 0)
+    {
+        m_timeStep = aStep;
+        m_maxSubsteps = aMaxSubsteps;
+        m_accumulator = 0.0f;
     }
 }
 
+// --------------------------------------------------------------------------------------------------------------------
+//   ____       _   ___ _                 _   _                 
+//  / ___|  ___| |_|_ _| |_ ___ _ __ __ _| |_(_) ___  _ __  ___ 
+//  \___ \ / _ \ __|| || __/ _ \ '__/ _` | __| |/ _ \| '_ \/ __|
+//   ___) |  __/ |_ | || ||  __/ | | (_| | |_| | (_) | | | \__ \
+//  |____/ \___|\__|___|\__\___|_|  \__,_|\__|_|\___/|_| |_|___/
+//                                                              
+//  \brief Sets the iterations of the constraint solvers, a scene with few stacked bodies can do with less
+//  \param aVelocity the iterations of the velocity solver, 8 by default
+//  \param aPosition the iterations of the position solver, 3 by default
+//
+void bart::Box2dPhysicService::SetIterations(const int aVelocity, const int aPosition)
+{
+    if (Defer([this, aVelocity, aPosition]() { SetIterations(aVelocity, aPosition); }))
+    {
+        return;
+    }
+
+    m_velocityIterations = std::max(aVelocity, 1);
+    m_positionIterations = std::max(aPosition, 1);
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 //   ____       _    ____                 _ _         ____            _      
 //  / ___|  ___| |_ / ___|_ __ __ ___   _(_) |_ _   _/ ___|  ___ __ _| | ___ 
@@ -632,9 +921,15 @@ void bart::Box2dPhysicService::Update()
 //  
 void bart::Box2dPhysicService::SetGravityScale(const size_t aId, const float aScale)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aScale]() { SetGravityScale(aId, aScale); }))
     {
-        b2Body* tBody = m_bodyList[aId]->Body;
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
+    {
+        b2Body* tBody = tInfo->Body;
         tBody->SetGravityScale(aScale);
         tBody->SetAwake(true);
     }
@@ -650,10 +945,10 @@ void bart::Box2dPhysicService::SetGravityScale(const size_t aId, const float aSc
 //  
 float bart::Box2dPhysicService::GetMass(const size_t aId)
 {
-    if (m_bodyList.count(aId))
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
-        b2Body* tBody = m_bodyList[aId]->Body;
-        return tBody->GetMass();
+        return m_stepping || tInfo->Body == nullptr ? tInfo->Mass : tInfo->Body->GetMass();
     }
 
     return 0.0f;
@@ -669,9 +964,15 @@ float bart::Box2dPhysicService::GetMass(const size_t aId)
 //  
 void bart::Box2dPhysicService::SetMass(const size_t aId, const float aMass)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aMass]() { SetMass(aId, aMass); }))
     {
-        b2Body* tBody = m_bodyList[aId]->Body;
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
+    {
+        b2Body* tBody = tInfo->Body;
         b2MassData* tMass = new b2MassData();
         tMass->center = tBody->GetWorldCenter();
         tMass->mass = aMass;
@@ -689,9 +990,15 @@ void bart::Box2dPhysicService::SetMass(const size_t aId, const float aMass)
 //  
 void bart::Box2dPhysicService::FixRotation(const size_t aId, const bool aFixed)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aFixed]() { FixRotation(aId, aFixed); }))
     {
-        b2Body* tBody = m_bodyList[aId]->Body;
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
+    {
+        b2Body* tBody = tInfo->Body;
         tBody->SetFixedRotation(aFixed);
     }
 }
@@ -706,12 +1013,20 @@ void bart::Box2dPhysicService::FixRotation(const size_t aId, const bool aFixed)
 //  
 void bart::Box2dPhysicService::GetVelocity(const size_t aId, float* aX, float* aY)
 {
-    if (m_bodyList.count(aId))
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
-        b2Body* tBody = m_bodyList[aId]->Body;
-        const b2Vec2 tVelociy = tBody->GetLinearVelocity();
-        *aX = tVelociy.x;
-        *aY = tVelociy.y;
+        if (m_stepping || tInfo->Body == nullptr)
+        {
+            *aX = tInfo->VelocityX;
+            *aY = tInfo->VelocityY;
+        }
+        else
+        {
+            const b2Vec2 tVelociy = tInfo->Body->GetLinearVelocity();
+            *aX = tVelociy.x;
+            *aY = tVelociy.y;
+        }
     }
 }
 
@@ -725,9 +1040,15 @@ void bart::Box2dPhysicService::GetVelocity(const size_t aId, float* aX, float* a
 //  
 void bart::Box2dPhysicService::SetVelocity(const size_t aId, const float aX, const float aY)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aX, aY]() { SetVelocity(aId, aX, aY); }))
     {
-        b2Body* tBody = m_bodyList[aId]->Body;
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
+    {
+        b2Body* tBody = tInfo->Body;
         tBody->SetLinearVelocity({aX, aY});
     }
 }
@@ -742,9 +1063,15 @@ void bart::Box2dPhysicService::SetVelocity(const size_t aId, const float aX, con
 //  
 void bart::Box2dPhysicService::SetFriction(const size_t aId, const float aFriction)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aFriction]() { SetFriction(aId, aFriction); }))
+    {
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
-        m_bodyList[aId]->Fixture->SetFriction(aFriction);
+        tInfo->Fixture->SetFriction(aFriction);
     }
 }
 
@@ -758,14 +1085,20 @@ void bart::Box2dPhysicService::SetFriction(const size_t aId, const float aFricti
 //  
 void bart::Box2dPhysicService::SetFiltering(const size_t aId, signed short aIndex, unsigned short aCategory, unsigned short aMask)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aIndex, aCategory, aMask]() { SetFiltering(aId, aIndex, aCategory, aMask); }))
+    {
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
         b2Filter tFilter;
         tFilter.categoryBits = aCategory;
         tFilter.maskBits = aMask;
         tFilter.groupIndex = aIndex;
 
-        m_bodyList[aId]->Fixture->SetFilterData(tFilter);
+        tInfo->Fixture->SetFilterData(tFilter);
     }
 }
 
@@ -779,9 +1112,15 @@ void bart::Box2dPhysicService::SetFiltering(const size_t aId, signed short aInde
 //  
 void bart::Box2dPhysicService::SetSensor(const size_t aId, bool aSensor)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aSensor]() { SetSensor(aId, aSensor); }))
     {
-        m_bodyList[aId]->Fixture->SetSensor(aSensor);
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
+    {
+        tInfo->Fixture->SetSensor(aSensor);
     }
 }
 
@@ -795,25 +1134,38 @@ void bart::Box2dPhysicService::SetSensor(const size_t aId, bool aSensor)
 //  
 void bart::Box2dPhysicService::SetRestitution(const size_t aId, float aRestitution)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aRestitution]() { SetRestitution(aId, aRestitution); }))
+    {
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
-        m_bodyList[aId]->Fixture->SetRestitution(aRestitution);
+        tInfo->Fixture->SetRestitution(aRestitution);
     }
 }
 
 void bart::Box2dPhysicService::SetAngularVelocity(const size_t aId, const float aVelocity)
 {
-    if (m_bodyList.count(aId))
+    if (Defer([this, aId, aVelocity]() { SetAngularVelocity(aId, aVelocity); }))
     {
-        m_bodyList[aId]->Body->SetAngularVelocity(aVelocity);
+        return;
+    }
+
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
+    {
+        tInfo->Body->SetAngularVelocity(aVelocity);
     }
 }
 
 float bart::Box2dPhysicService::GetAngularVelocity(const size_t aId)
 {
-    if (m_bodyList.count(aId))
+    Box2dBodyInfo* tInfo = FindBody(aId);
+    if (tInfo != nullptr)
     {
-        return m_bodyList[aId]->Body->GetAngularVelocity();
+        return m_stepping || tInfo->Body == nullptr ? tInfo->AngularVelocity : tInfo->Body->GetAngularVelocity();
     }
 
     return 0.0f;
@@ -821,18 +1173,385 @@ float bart::Box2dPhysicService::GetAngularVelocity(const size_t aId)
 
 void bart::Box2dPhysicService::ClearWorld()
 {
-    for (TBodyMap::iterator tItr = m_bodyList.begin(); tItr != m_bodyList.end(); ++tItr)
+    if (Defer([this]() { ClearWorld(); }))
+    {
+        return;
+    }
+
+    for (const Box2dBodyInfo& tInfo : m_bodyList)
     {
-        // tItr->second->Body->DestroyFixture(tItr->second->Fixture);
-        // m_physicWorld->DestroyBody(tItr->second->Body);
-        m_scheduledBodyRemoval.insert(tItr->second->Body);
-        delete tItr->second;
+        // tInfo.Body->DestroyFixture(tInfo.Fixture);
+        // m_physicWorld->DestroyBody(tInfo.Body);
+        tInfo.Body->SetUserData(nullptr);
+        m_scheduledBodyRemoval.insert(tInfo.Body);
+        m_bodyGenerations[tInfo.Slot] = (m_bodyGenerations[tInfo.Slot] + 1) & (~0u >> SLOT_BITS);
+        m_freeSlots.push_back(tInfo.Slot);
     }
 
     m_bodyList.clear();
 }
 
-void bart::Box2dPhysicService::AddContactInfo(ContactInfo* aContactInfo)
+// --------------------------------------------------------------------------------------------------------------------
+//      _       _     _  ____            _             _   
+//     / \   __| | __| |/ ___|___  _ __ | |_ __ _  ___| |_ 
+//    / _ \ / _` |/ _` | |   / _ \| '_ \| __/ _` |/ __| __|
+//   / ___ \ (_| | (_| | |__| (_) | | | | || (_| | (__| |_ 
+//  /_/   \_\__,_|\__,_|\____\___/|_| |_|\__\__,_|\___|\__|
+//                                                         
+//  \brief Keeps a contact until the step is over, in the ring buffer. Nothing is allocated, the events over the
+//         capacity are dropped and counted
+//  \param aType begins or ends
+//  \param aContact the contact raised by Box2D
+//
+void bart::Box2dPhysicService::AddContact(const EContactType aType, b2Contact* aContact)
+{
+    b2Body* tBodyA = aContact->GetFixtureA()->GetBody();
+    b2Body* tBodyB = aContact->GetFixtureB()->GetBody();
+
+    if (tBodyA->GetUserData() == nullptr || tBodyB->GetUserData() == nullptr)
+    {
+        return;
+    }
+
+    if (m_contactCount == m_contacts.size())
+    {
+        m_droppedContacts++;
+        return;
+    }
+
+    ContactEvent& tEvent = m_contacts[(m_contactHead + m_contactCount) % m_contacts.size()];
+    m_contactCount++;
+
+    tEvent.BodyA = tBodyA;
+    tEvent.BodyB = tBodyB;
+    tEvent.Type = aType;
+    tEvent.PointCount = 0;
+    tEvent.NormalX = 0.0f;
+    tEvent.NormalY = 0.0f;
+
+    if (aType == BEGIN_CONTACT)
+    {
+        b2WorldManifold tWorldManifold;
+        aContact->GetWorldManifold(&tWorldManifold);
+
+        const int tPointCount = aContact->GetManifold()->pointCount;
+        for (int i = 0; i < tPointCount; i++)
+        {
+            tEvent.PointsX[i] = ToWorld(tWorldManifold.points[i].x);
+            tEvent.PointsY[i] = ToWorld(-tWorldManifold.points[i].y);
+        }
+
+        tEvent.PointCount = static_cast<unsigned char>(tPointCount);
+        tEvent.NormalX = tWorldManifold.normal.x;
+        tEvent.NormalY = tWorldManifold.normal.y;
+    }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+//  \brief Calls the collision callbacks of the contacts raised since the last dispatch. The callbacks of an entity
+//         are grouped, the groups and the callbacks in a group in the order the contacts were raised, the same from
+//         one run to the next. A body destroyed by an earlier callback is skipped
+//
+void bart::Box2dPhysicService::DispatchContacts()
+{
+    m_contactOrder.clear();
+
+    for (size_t i = 0; i < m_contactCount; i++)
+    {
+        const size_t tIndex = (m_contactHead + i) % m_contacts.size();
+        Entity* tEntity = static_cast<Entity*>(m_contacts[tIndex].BodyA->GetUserData());
+
+        if (tEntity != nullptr)
+        {
+            m_contactOrder.push_back({tEntity, 0, i, tIndex});
+        }
+    }
+
+    // The contacts raised by the callbacks go after these ones, the ring is released before calling them
+    m_contactHead = (m_contactHead + m_contactCount) % m_contacts.size();
+    m_contactCount = 0;
+
+    // Together by entity, then each group takes the place of its first contact. The addresses only gather the groups
+    std::sort(m_contactOrder.begin(), m_contactOrder.end(), [](const ContactOrder& aLeft, const ContactOrder& aRight)
+    {
+        return aLeft.Target != aRight.Target ? std::less<Entity*>()(aLeft.Target, aRight.Target) : aLeft.Sequence < aRight.Sequence;
+    });
+
+    for (size_t i = 0; i < m_contactOrder.size(); i++)
+    {
+        const bool tFirst = i == 0 || m_contactOrder[i].Target != m_contactOrder[i - 1].Target;
+        m_contactOrder[i].Group = tFirst ? m_contactOrder[i].Sequence : m_contactOrder[i - 1].Group;
+    }
+
+    std::sort(m_contactOrder.begin(), m_contactOrder.end(), [](const ContactOrder& aLeft, const ContactOrder& aRight)
+    {
+        return aLeft.Group != aRight.Group ? aLeft.Group < aRight.Group : aLeft.Sequence < aRight.Sequence;
+    });
+
+    for (const ContactOrder& tOrder : m_contactOrder)
+    {
+        const ContactEvent& tEvent = m_contacts[tOrder.Event];
+        Entity* tEntityA = static_cast<Entity*>(tEvent.BodyA->GetUserData());
+        Entity* tEntityB = static_cast<Entity*>(tEvent.BodyB->GetUserData());
+
+        if (tEntityA == nullptr || tEntityB == nullptr)
+        {
+            continue;
+        }
+
+        if (tEvent.Type == BEGIN_CONTACT)
+        {
+            m_contactPoints.clear();
+            for (unsigned char i = 0; i < tEvent.PointCount; i++)
+            {
+                m_contactPoints.push_back({tEvent.PointsX[i], tEvent.PointsY[i]});
+            }
+
+            tEntityA->OnCollisionEnter(tEntityB, m_contactPoints, tEvent.NormalX, tEvent.NormalY);
+        }
+        else if (tEvent.Type == END_CONTACT)
+        {
+            tEntityA->OnCollisionExit(tEntityB);
+        }
+    }
+}
+
+void bart::Box2dPhysicService::StorePreviousStates()
+{
+    for (Box2dBodyInfo& tInfo : m_bodyList)
+    {
+        const b2Vec2& tPosition = tInfo.Body->GetPosition();
+        tInfo.PreviousX = tPosition.x;
+        tInfo.PreviousY = tPosition.y;
+        tInfo.PreviousAngle = tInfo.Body->GetAngle();
+    }
+}
+
+void bart::Box2dPhysicService::GetInterpolated(const Box2dBodyInfo& aInfo, const float aInterpolation, float* aX, float* aY,
+                                               float* aAngle)
+{
+    const float tX = aInfo.PreviousX + (aInfo.CurrentX - aInfo.PreviousX) * aInterpolation;
+    const float tY = aInfo.PreviousY + (aInfo.CurrentY - aInfo.PreviousY) * aInterpolation;
+    const float tAngle = aInfo.PreviousAngle + (aInfo.CurrentAngle - aInfo.PreviousAngle) * aInterpolation;
+
+    *aX = (tX - aInfo.HalfWidth) * WORLD_SCALE;
+    *aY = -(tY + aInfo.HalfHeight) * WORLD_SCALE;
+    *aAngle = -tAngle * TO_DEGREES;
+}
+
+bool bart::Box2dPhysicService::Defer(std::function<void()>&& aCommand)
 {
-    m_contactList.push_back(aContactInfo);
+    if (!m_stepping)
+    {
+        return false;
+    }
+
+    m_commands.push_back(std::move(aCommand));
+    return true;
+}
+
+void bart::Box2dPhysicService::StartStep(const int aSteps)
+{
+    // What the getters read while the worker steps, with the changes made since the last batch
+    m_bodyCount = static_cast<size_t>(m_physicWorld->GetBodyCount());
+    for (Box2dBodyInfo& tInfo : m_bodyList)
+    {
+        if (tInfo.Body != nullptr)
+        {
+            tInfo.Mass = tInfo.Body->GetMass();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> tLock(m_mutex);
+        m_pendingSteps = aSteps;
+        m_generation++;
+        m_busy = true;
+    }
+
+    m_stepping = true;
+    m_startSignal.notify_one();
+}
+
+void bart::Box2dPhysicService::FinishStep()
+{
+    {
+        std::unique_lock<std::mutex> tLock(m_mutex);
+        m_doneSignal.wait(tLock, [this]() { return !m_busy; });
+    }
+
+    m_stepping = false;
+
+    // The frame draws between the results of the last two batches, the worker does not touch the records
+    for (Box2dBodyInfo& tInfo : m_bodyList)
+    {
+        tInfo.PreviousX = tInfo.CurrentX;
+        tInfo.PreviousY = tInfo.CurrentY;
+        tInfo.PreviousAngle = tInfo.CurrentAngle;
+    }
+
+    // In the order they were issued, a body created during the frame exists before its commands run. A body moved
+    // meanwhile by SetTransform ends up where it was set, whatever the batch did to it
+    for (std::function<void()>& tCommand : m_commands)
+    {
+        tCommand();
+    }
+
+    m_commands.clear();
+    StoreCurrentStates();
+    EndStep();
+}
+
+void bart::Box2dPhysicService::WorkerLoop(const unsigned int aGeneration)
+{
+    unsigned int tGeneration = aGeneration;
+
+    for (;;)
+    {
+        std::unique_lock<std::mutex> tLock(m_mutex);
+        m_startSignal.wait(tLock, [this, tGeneration]() { return m_stopping || m_generation != tGeneration; });
+
+        if (m_stopping)
+        {
+            return;
+        }
+
+        tGeneration = m_generation;
+        const int tSteps = m_pendingSteps;
+        tLock.unlock();
+
+        for (int i = 0; i < tSteps; i++)
+        {
+            m_physicWorld->Step(m_timeStep, m_velocityIterations, m_positionIterations);
+            m_stepMilliseconds += m_physicWorld->GetProfile().step;
+            AddBroadPhaseCounters();
+        }
+
+        tLock.lock();
+        m_busy = false;
+        m_doneSignal.notify_one();
+    }
+}
+
+void bart::Box2dPhysicService::StopWorker()
+{
+    if (m_stepping)
+    {
+        FinishStep();
+    }
+
+    {
+        std::lock_guard<std::mutex> tLock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_startSignal.notify_one();
+
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+}
+
+void bart::Box2dPhysicService::EndStep()
+{
+    if (m_droppedContacts > 0)
+    {
+        Engine::Instance().GetLogger().Log("%d contacts dropped, over the capacity\n", static_cast<int>(m_droppedContacts));
+    }
+
+    DispatchContacts();
+    m_lastStepMilliseconds = m_stepMilliseconds;
+
+    if (m_scheduledFixtureRemoval.size() > 0)
+    {
+        std::set<b2Fixture*>::iterator _itt = m_scheduledFixtureRemoval.begin();
+        const std::set<b2Fixture*>::iterator _end = m_scheduledFixtureRemoval.end();
+
+        while (_itt != _end)
+        {
+            (*_itt)->GetBody()->DestroyFixture(*_itt);
+            ++_itt;
+        }
+
+        m_scheduledFixtureRemoval.clear();
+    }
+
+    if (m_scheduledBodyRemoval.size() > 0)
+    {
+        std::set<b2Body*>::iterator _itt = m_scheduledBodyRemoval.begin();
+        const std::set<b2Body*>::iterator _end = m_scheduledBodyRemoval.end();
+
+        while (_itt != _end)
+        {
+            m_physicWorld->DestroyBody(*_itt);
+            ++_itt;
+        }
+
+        m_scheduledBodyRemoval.clear();
+    }
+
+    UpdateBroadPhaseStats();
+}
+
+void bart::Box2dPhysicService::AddBroadPhaseCounters()
+{
+    const b2BroadPhaseCounters& tCounters = m_physicWorld->GetBroadPhaseCounters();
+    m_stepBroadPhase.StaticQueries += tCounters.staticQueries;
+    m_stepBroadPhase.DynamicQueries += tCounters.dynamicQueries;
+    m_stepBroadPhase.Pairs += tCounters.pairs;
+    m_stepBroadPhase.StaticRebuilds += tCounters.staticRebuilds;
+}
+
+void bart::Box2dPhysicService::UpdateBroadPhaseStats()
+{
+    const int tStaticProxies = m_physicWorld->GetStaticProxyCount();
+
+    // Going over the whole static tree only when it changed, a map holds a lot more static bodies than dynamic ones
+    if (m_stepBroadPhase.StaticRebuilds > 0 || tStaticProxies != m_broadPhaseStats.StaticProxies)
+    {
+        m_broadPhaseStats.StaticHeight = m_physicWorld->GetStaticTreeHeight();
+        m_broadPhaseStats.StaticQuality = m_physicWorld->GetStaticTreeQuality();
+    }
+
+    m_broadPhaseStats.StaticProxies = tStaticProxies;
+    m_broadPhaseStats.DynamicProxies = m_physicWorld->GetProxyCount() - tStaticProxies;
+    m_broadPhaseStats.DynamicHeight = m_physicWorld->GetTreeHeight();
+    m_broadPhaseStats.DynamicQuality = m_physicWorld->GetTreeQuality();
+    m_broadPhaseStats.StaticQueries = m_stepBroadPhase.StaticQueries;
+    m_broadPhaseStats.DynamicQueries = m_stepBroadPhase.DynamicQueries;
+    m_broadPhaseStats.Pairs = m_stepBroadPhase.Pairs;
+    m_broadPhaseStats.StaticRebuilds = m_stepBroadPhase.StaticRebuilds;
+
+    if (m_stepBroadPhase.StaticRebuilds > 0)
+    {
+        Engine::Instance().GetLogger().Log("Static tree built: %d proxies, height %d, quality %.2f\n",
+                                           tStaticProxies, m_broadPhaseStats.StaticHeight,
+                                           m_broadPhaseStats.StaticQuality);
+    }
+}
+
+void bart::Box2dPhysicService::StoreCurrentStates()
+{
+    // What the frame reads, the bodies themselves may be stepping on the physic thread
+    for (Box2dBodyInfo& tInfo : m_bodyList)
+    {
+        const b2Body* tBody = tInfo.Body;
+        if (tBody != nullptr)
+        {
+            const b2Vec2& tPosition = tBody->GetPosition();
+            const b2Vec2& tVelocity = tBody->GetLinearVelocity();
+            tInfo.CurrentX = tPosition.x;
+            tInfo.CurrentY = tPosition.y;
+            tInfo.CurrentAngle = tBody->GetAngle();
+            tInfo.VelocityX = tVelocity.x;
+            tInfo.VelocityY = tVelocity.y;
+            tInfo.AngularVelocity = tBody->GetAngularVelocity();
+
+            // A body asleep after the steps still has the way from its previous state to draw
+            tInfo.Moving = tBody->GetType() != b2_staticBody &&
+                (tBody->IsAwake() || tInfo.CurrentX != tInfo.PreviousX || tInfo.CurrentY != tInfo.PreviousY ||
+                 tInfo.CurrentAngle != tInfo.PreviousAngle);
+        }
+    }
 }
@@ -0,0 +1,101 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: CircleCache.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <CircleCache.h>
+#include <cmath>
+
+const size_t bart::CircleCache::MAX_RADII = 256;
+
+const std::vector<bart::Point>& bart::CircleCache::GetOutline(const float aRadius)
+{
+    std::map<float, std::vector<Point>>::iterator tItr = m_Outlines.find(aRadius);
+    if (tItr != m_Outlines.end())
+    {
+        return tItr->second;
+    }
+
+    if (m_Outlines.size() >= MAX_RADII)
+    {
+        m_Outlines.clear();
+    }
+
+    std::vector<Point>& tOutline = m_Outlines[aRadius];
+
+    // Midpoint circle, the same pixels the per point drawing used to plot
+    float tError = -aRadius;
+    float tX = aRadius - 0.5f;
+    float tY = 0.5f;
+
+    const auto tAdd = [&tOutline](const float aX, const float aY)
+    {
+        Point tPoint;
+        tPoint.Set(static_cast<int>(std::floor(aX - 0.5f)), static_cast<int>(std::floor(aY - 0.5f)));
+        tOutline.push_back(tPoint);
+    };
+
+    while (tX >= tY)
+    {
+        tAdd(tX, tY);
+        tAdd(tY, tX);
+
+        if (tX != 0)
+        {
+            tAdd(-tX, tY);
+            tAdd(tY, -tX);
+        }
+
+        if (tY != 0)
+        {
+            tAdd(tX, -tY);
+            tAdd(-tY, tX);
+        }
+
+        if (tX != 0 && tY != 0)
+        {
+            tAdd(-tX, -tY);
+            tAdd(-tY, -tX);
+        }
+
+        tError += tY;
+        ++tY;
+        tError += tY;
+
+        if (tError >= 0)
+        {
+            --tX;
+            tError -= tX;
+            tError -= tX;
+        }
+    }
+
+    return tOutline;
+}
+
+void bart::CircleCache::Clear()
+{
+    m_Outlines.clear();
+}
\ No newline at end of file
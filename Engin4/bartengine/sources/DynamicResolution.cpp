@@ -0,0 +1,188 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: DynamicResolution.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <DynamicResolution.h>
+#include <RenderGraph.h>
+#include <Engine.h>
+#include <algorithm>
+#include <cmath>
+
+const size_t bart::DynamicResolution::HISTORY_SIZE = 20;
+const float bart::DynamicResolution::SCALE_STEP = 0.05f;
+const float bart::DynamicResolution::HEADROOM = 0.85f;
+
+void bart::DynamicResolution::Initialize(RenderGraph& aGraph, const size_t aWorldPass)
+{
+    m_Graph = &aGraph;
+    m_WorldPass = aWorldPass;
+
+    // Resized when enabled, a transient target is only taken while the upscale pass runs
+    m_Scene = aGraph.AddResource("Scene", 1, 1, false);
+    m_UpscalePass = aGraph.AddPass("Upscale", [this](RenderGraph& aPassGraph) { Upscale(aPassGraph); });
+    aGraph.AddInput(m_UpscalePass, m_Scene);
+    aGraph.SetOutput(m_UpscalePass, RenderGraph::BACKBUFFER);
+    aGraph.SetEnabled(m_UpscalePass, false);
+}
+
+void bart::DynamicResolution::Enable(const float aBudget, const float aMinScale, const float aMaxScale)
+{
+    if (m_Graph == nullptr)
+    {
+        return;
+    }
+
+    m_Budget = aBudget;
+    m_MinScale = std::max(SCALE_STEP, std::min(aMinScale, 1.0f));
+    m_MaxScale = std::max(m_MinScale, std::min(aMaxScale, 1.0f));
+    m_Scale = m_MaxScale;
+    m_FrameTimes.clear();
+    ResizeScene();
+
+    m_Graph->SetOutput(m_WorldPass, m_Scene);
+    m_Graph->SetEnabled(m_UpscalePass, true);
+    m_Enabled = true;
+}
+
+void bart::DynamicResolution::Disable()
+{
+    if (m_Graph == nullptr)
+    {
+        return;
+    }
+
+    m_Graph->SetOutput(m_WorldPass, RenderGraph::BACKBUFFER);
+    m_Graph->SetEnabled(m_UpscalePass, false);
+    m_Enabled = false;
+    m_Scale = 1.0f;
+}
+
+void bart::DynamicResolution::BeginScene() const
+{
+    if (m_Enabled)
+    {
+        // The world keeps its coordinates, the scale of the target shrinks them to its size
+        IGraphic& tGraphic = Engine::Instance().GetGraphic();
+        tGraphic.Clear();
+        tGraphic.ScaleViewport(static_cast<float>(m_SceneWidth) / static_cast<float>(m_Width),
+                               static_cast<float>(m_SceneHeight) / static_cast<float>(m_Height));
+    }
+}
+
+void bart::DynamicResolution::EndScene() const
+{
+    if (m_Enabled)
+    {
+        Engine::Instance().GetGraphic().ScaleViewport(1.0f, 1.0f);
+    }
+}
+
+void bart::DynamicResolution::AddFrameTime(const float aMilliseconds)
+{
+    if (!m_Enabled)
+    {
+        return;
+    }
+
+    m_FrameTimes.push_back(aMilliseconds);
+    if (m_FrameTimes.size() < HISTORY_SIZE)
+    {
+        return;
+    }
+
+    float tAverage = 0.0f;
+    for (const float tTime : m_FrameTimes)
+    {
+        tAverage += tTime;
+    }
+
+    tAverage /= static_cast<float>(m_FrameTimes.size());
+    m_FrameTimes.clear();
+
+    // The cost follows the pixel count, the scale goes up only when the frames would still fit the budget
+    float tScale = m_Scale;
+    if (tAverage > m_Budget)
+    {
+        tScale = std::max(m_MinScale, m_Scale - SCALE_STEP);
+    }
+    else
+    {
+        const float tLarger = std::min(m_MaxScale, m_Scale + SCALE_STEP);
+        const float tRatio = tLarger / m_Scale;
+        if (tAverage * tRatio * tRatio < m_Budget * HEADROOM)
+        {
+            tScale = tLarger;
+        }
+    }
+
+    if (tScale != m_Scale)
+    {
+        m_Scale = tScale;
+        ResizeScene();
+    }
+}
+
+void bart::DynamicResolution::Upscale(RenderGraph& aGraph)
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    const size_t tTarget = aGraph.GetTarget(m_Scene);
+
+    if (tTarget == 0)
+    {
+        Engine::Instance().GetLogger().Log("No render target for the dynamic resolution, it is disabled\n");
+        Disable();
+        return;
+    }
+
+    Camera* tCamera = tGraphic.GetCamera();
+    tGraphic.SetCamera(nullptr);
+
+    // The scene covers the window, its pixels are copied without blending
+    Rectangle tSrc;
+    Rectangle tDst;
+    tSrc.Set(0, 0, m_SceneWidth, m_SceneHeight);
+    tDst.Set(0, 0, m_Width, m_Height);
+    tGraphic.SetBlending(false);
+    tGraphic.Draw(tTarget, tSrc, tDst, 0.0f, false, false, 255);
+    tGraphic.SetBlending(true);
+
+    tGraphic.SetCamera(tCamera);
+}
+
+void bart::DynamicResolution::ResizeScene()
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+
+    int tWidth, tHeight;
+    float tScaleX, tScaleY;
+    tGraphic.GetWindowSize(&tWidth, &tHeight);
+    tGraphic.GetViewportScale(&tScaleX, &tScaleY);
+
+    m_Width = std::max(1, static_cast<int>(static_cast<float>(tWidth) / tScaleX));
+    m_Height = std::max(1, static_cast<int>(static_cast<float>(tHeight) / tScaleY));
+    m_SceneWidth = std::max(1, static_cast<int>(std::ceil(static_cast<float>(m_Width) * m_Scale)));
+    m_SceneHeight = std::max(1, static_cast<int>(std::ceil(static_cast<float>(m_Height) * m_Scale)));
+    m_Graph->SetResourceSize(m_Scene, m_SceneWidth, m_SceneHeight);
+}
\ No newline at end of file
@@ -27,7 +27,10 @@
 
 #include <Engine.h>
 #include <Config.h>
+#include <OffscreenGraphics.h>
+#include <RenderComparison.h>
 #include <iostream>
+#include <chrono>
 
 // --------------------------------------------------------------------------------------------------------------------
 //   ___           _                       
@@ -74,14 +77,14 @@ bool bart::Engine::Initialize(const std::string& aTitle, const int aWidth, const
 //  \param aTitle the window's title
 //  \param aWidth the window's width
 //  \param aHeight the window's height
-//  \param aState the window's state can be windowed, border less or fullscreen
+//  \param aState the window's state can be windowed, border less, fullscreen or offscreen (no window)
 //  \return true if all sub-systems and the windows are created
 //
 bool bart::Engine::Initialize(const std::string& aTitle, const int aWidth, const int aHeight, const EWindowState aState)
 {
     if (!m_IsInitialized)
     {
-        CreateServices();
+        CreateServices(aState);
         if (InitializeServices())
         {
             if (!m_GraphicService->InitWindow(aTitle, aWidth, aHeight, aState))
@@ -89,6 +92,18 @@ bool bart::Engine::Initialize(const std::string& aTitle, const int aWidth, const
                 m_LoggerService->Log("Impossible to create a window\n");
                 return false;
             }
+
+            // The scene is the first pass, the passes added later draw over it
+            const size_t tWorld = m_RenderGraph.AddPass("World", [this](RenderGraph&)
+            {
+                m_Resolution.BeginScene();
+                m_SceneService->Draw();
+                m_Particles.Draw();
+                m_Resolution.EndScene();
+            });
+
+            m_RenderGraph.SetOutput(tWorld, RenderGraph::BACKBUFFER);
+            m_Resolution.Initialize(m_RenderGraph, tWorld);
         }
 
         m_IsInitialized = true;
@@ -110,6 +125,10 @@ void bart::Engine::Clean()
     SAFE_CLEAN(m_CollisionService);
     SAFE_CLEAN(m_SceneService);
     SAFE_CLEAN(m_PhysicService);
+    m_BodySync.Clean();
+    m_Particles.Clean();
+    m_Animations.Clean();
+    m_RenderGraph.Clean();
     SAFE_CLEAN(m_InputService);
     SAFE_CLEAN(m_AudioService);
     SAFE_CLEAN(m_GraphicService);
@@ -125,10 +144,20 @@ void bart::Engine::Clean()
 //   \____|_|  \___|\__,_|\__\___|____/ \___|_|    \_/ |_|\___\___||___/
 //                                                                      
 //  \brief Creates all the sub-services instances
-void bart::Engine::CreateServices()
+//  \param aState offscreen selects the window-less renderer
+void bart::Engine::CreateServices(const EWindowState aState)
 {
     CREATE_LOGGER(m_LoggerService);
-    CREATE_GRAPHIC(m_GraphicService);
+
+    if (aState == OFFSCREEN)
+    {
+        CREATE_OFFSCREEN_GRAPHIC(m_GraphicService);
+    }
+    else
+    {
+        CREATE_GRAPHIC(m_GraphicService);
+    }
+
     CREATE_AUDIO(m_AudioService);
     CREATE_INPUT(m_InputService);
     CREATE_TIMER(m_TimerService);
@@ -272,6 +301,79 @@ void bart::Engine::Start()
     Clean();
 }
 
+// --------------------------------------------------------------------------------------------------------------------
+//   ____                 _____
+//  |  _ \  _   _  _ __  |  ___|_ __  __ _  _ __ ___    ___  ___
+//  | |_) || | | || '_ \ | |_  | '__|/ _` || '_ ` _ \  / _ \/ __|
+//  |  _ < | |_| || | | ||  _| | |  | (_| || | | | | ||  __/\__ \
+//  |_| \_\ \__,_||_| |_||_|   |_|   \__,_||_| |_| |_| \___||___/
+//                                                               
+//  \brief Runs a number of frames as fast as possible with a fixed time step, for benchmarks and
+//         frame comparisons. The fixed step keeps the runs comparable with each other.
+//  \param aFrameCount the number of frames to run
+//  \param aDeltaTime the time step given to every update, in seconds
+//
+void bart::Engine::RunFrames(const int aFrameCount, const float aDeltaTime)
+{
+    if (m_IsInitialized && !m_IsRunning)
+    {
+        m_IsRunning = true;
+        const float tStart = m_TimerService->GetTime();
+        int tFrames = 0;
+
+        while (m_IsRunning && tFrames < aFrameCount)
+        {
+            ProcessInput();
+            Update(aDeltaTime);
+            Render();
+            tFrames++;
+        }
+
+        const float tElapsed = m_TimerService->GetTime() - tStart;
+        m_LoggerService->Log("Ran %d frames in %.1f ms, %.3f ms per frame\n", tFrames, tElapsed,
+                             tFrames > 0 ? tElapsed / static_cast<float>(tFrames) : 0.0f);
+
+        Stop();
+    }
+
+    Clean();
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+//   ____               ____                                _                 
+//  |  _ \ _   _ _ __  / ___|___  _ __ ___  _ __   __ _ _ __(_)___  ___  _ __  
+//  | |_) | | | | '_ \| |   / _ \| '_ ` _ \| '_ \ / _` | '__| / __|/ _ \| '_ \ 
+//  |  _ <| |_| | | | | |__| (_) | | | | | | |_) | (_| | |  | \__ \ (_) | | | |
+//  |_| \_\\__,_|_| |_|\____\___/|_| |_| |_| .__/ \__,_|_|  |_|___/\___/|_| |_|
+//                                         |_|                                 
+//
+//  \brief Draws test cases with the offscreen renderer and with SDL's software renderer and compares the frames, the
+//         engine must be initialized offscreen
+//  \param aTexture the image drawn by the cases
+//  \return true if every case matches
+//
+bool bart::Engine::RunComparison(const std::string& aTexture)
+{
+    bool tPassed = false;
+
+    if (m_IsInitialized && !m_IsRunning)
+    {
+        OffscreenGraphics* tSoftware = dynamic_cast<OffscreenGraphics*>(m_GraphicService);
+        if (tSoftware != nullptr)
+        {
+            RenderComparison tComparison;
+            tPassed = tComparison.Run(*tSoftware, aTexture);
+        }
+        else
+        {
+            m_LoggerService->Log("Compare: the engine is not initialized offscreen\n");
+        }
+    }
+
+    Clean();
+    return tPassed;
+}
+
 // --------------------------------------------------------------------------------------------------------------------
 //   ____  _              
 //  / ___|| |_ ___  _ __  
@@ -327,13 +429,17 @@ void bart::Engine::ProcessInput() const
 //   \___/| .__/ \__,_|\__,_|\__\___|
 //        |_|                        
 //  
-//  \brief Updates the game one frame
+//  \brief Updates the game one frame, the transforms of the bodies are synced together before the scene and the
+//         animations and the particles advance together after it
 //  \param aDeltaTime the time differences between frames
 //
-void bart::Engine::Update(const float aDeltaTime) const
+void bart::Engine::Update(const float aDeltaTime)
 {
-    m_PhysicService->Update();
+    m_PhysicService->Update(aDeltaTime);
+    m_BodySync.Update(*m_PhysicService);
     m_SceneService->Update(aDeltaTime);
+    m_Animations.Update(aDeltaTime);
+    m_Particles.Update(aDeltaTime);
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -343,11 +449,15 @@ void bart::Engine::Update(const float aDeltaTime) const
 //  |  _ <  __/ | | | (_| |  __/ |   
 //  |_| \_\___|_| |_|\__,_|\___|_|   
 //                                   
-//  \brief Renders a frame
+//  \brief Renders a frame, the passes of the render graph draw the scene and the layers over it
 //
-void bart::Engine::Render() const
+void bart::Engine::Render()
 {
+    const std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+
     m_GraphicService->Clear();
-    m_SceneService->Draw();
+    m_RenderGraph.Execute();
     m_GraphicService->Present();
+
+    m_Resolution.AddFrameTime(std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count());
 }
@@ -36,6 +36,11 @@ void bart::Entity::Draw()
 {
 }
 
+bool bart::Entity::GetBounds(Rectangle* /*aBounds*/) const
+{
+    return false;
+}
+
 void bart::Entity::OnCollisionEnter(Entity* /*aEntity*/, const vector<pair<float, float>>& /*aContactPoints*/, float /*aNormalX*/, float /*aNormalY*/)
 {
 }
@@ -46,6 +46,14 @@ void bart::NullGraphics::Clear()
 {
 }
 
+void bart::NullGraphics::Clear(const Color& /*aColor*/)
+{
+}
+
+void bart::NullGraphics::Clear(const Color& /*aColor*/, const Rectangle& /*aRegion*/)
+{
+}
+
 void bart::NullGraphics::Present()
 {
 }
@@ -103,6 +111,30 @@ void bart::NullGraphics::Draw(int /*aX*/, int /*aY*/)
 {
 }
 
+void bart::NullGraphics::DrawRects(const Rectangle* /*aRects*/, size_t /*aCount*/)
+{
+}
+
+void bart::NullGraphics::FillRects(const Rectangle* /*aRects*/, size_t /*aCount*/)
+{
+}
+
+void bart::NullGraphics::DrawPoints(const Point* /*aPoints*/, size_t /*aCount*/)
+{
+}
+
+void bart::NullGraphics::DrawLines(const Point* /*aPoints*/, size_t /*aCount*/)
+{
+}
+
+void bart::NullGraphics::DrawCircles(const Circle* /*aCircles*/, size_t /*aCount*/)
+{
+}
+
+void bart::NullGraphics::DrawSprites(size_t /*aTexture*/, const Rectangle& /*aSrc*/, const Rectangle* /*aDst*/, const Color* /*aTints*/, size_t /*aCount*/)
+{
+}
+
 void bart::NullGraphics::Draw(size_t /*aTexture*/,
                               const Rectangle& /*aSrc*/,
                               const Rectangle& /*aDst*/,
@@ -117,10 +149,27 @@ void bart::NullGraphics::Draw(size_t /*aFont*/, const string& /*aText*/, int /*a
 {
 }
 
+void bart::NullGraphics::Draw(size_t /*aFont*/, const string& /*aText*/, int /*aX*/, int /*aY*/, int /*aWrapWidth*/)
+{
+}
+
+void bart::NullGraphics::Draw(size_t /*aFont*/, const string& /*aText*/, int /*aX*/, int /*aY*/, const Color& /*aColor*/)
+{
+}
+
 void bart::NullGraphics::GetTextureSize(size_t /*aTextureId*/, int* /*aWidth*/, int* /*aHeight*/)
 {
 }
 
+bool bart::NullGraphics::IsRegionOpaque(size_t /*aTextureId*/, const Rectangle& /*aRegion*/)
+{
+    return false;
+}
+
+void bart::NullGraphics::SetBlending(bool /*aEnabled*/)
+{
+}
+
 void bart::NullGraphics::GetFontSize(size_t /*aFontId*/, const string& /*aText*/, int* /*aWidth*/, int* /*aHeight*/)
 {
 }
@@ -151,6 +200,11 @@ void bart::NullGraphics::SetCamera(Camera* /*aCamera*/)
 {
 }
 
+bart::Camera* bart::NullGraphics::GetCamera() const
+{
+    return nullptr;
+}
+
 void bart::NullGraphics::Fill(const Rectangle& /*aRect*/)
 {
 }
@@ -169,6 +223,27 @@ void bart::NullGraphics::ScaleViewport(float /*aX*/, float /*aY*/)
 
 }
 
+void bart::NullGraphics::GetViewportScale(float* aX, float* aY)
+{
+    *aX = 1.0f;
+    *aY = 1.0f;
+}
+
+size_t bart::NullGraphics::CreateRenderTarget(int /*aWidth*/, int /*aHeight*/)
+{
+    return 0;
+}
+
+bool bart::NullGraphics::SetRenderTarget(size_t /*aTarget*/)
+{
+    return false;
+}
+
+size_t bart::NullGraphics::GetRenderTarget() const
+{
+    return 0;
+}
+
 void bart::NullGraphics::SetWindowState(EWindowState /*aState*/)
 {
 }
@@ -176,3 +251,35 @@ void bart::NullGraphics::SetWindowState(EWindowState /*aState*/)
 void bart::NullGraphics::Draw(Transform* /*transform*/)
 {
 }
+
+bool bart::NullGraphics::LoadAtlas(const string& /*aManifest*/)
+{
+    return false;
+}
+
+bool bart::NullGraphics::BuildAtlas(const vector<string>& /*aFiles*/, int /*aPadding*/)
+{
+    return false;
+}
+
+void bart::NullGraphics::UnloadAtlas()
+{
+}
+
+bart::RenderStats& bart::NullGraphics::GetRenderStats()
+{
+    return m_Stats;
+}
+
+void bart::NullGraphics::ShowRenderStats(size_t /*aFont*/)
+{
+}
+
+bart::OverdrawAnalyzer& bart::NullGraphics::GetOverdrawAnalyzer()
+{
+    return m_Overdraw;
+}
+
+void bart::NullGraphics::ShowOverdraw(bool /*aEnabled*/)
+{
+}
\ No newline at end of file
@@ -63,10 +63,20 @@ void bart::NullPhysic::GetTransform(size_t /*aId*/, float* /*aX*/, float* /*aY*/
 {
 }
 
+void bart::NullPhysic::GetInterpolatedTransform(size_t /*aId*/, float* /*aX*/, float* /*aY*/, float* /*aAngle*/)
+{
+}
+
 void bart::NullPhysic::SetTransform(size_t /*aId*/, float /*aX*/, float /*aY*/, float /*aAngle*/)
 {
 }
 
+size_t bart::NullPhysic::SyncTransforms(BodyTransforms& aTransforms)
+{
+    aTransforms.Count = 0;
+    return 0;
+}
+
 void bart::NullPhysic::ApplyImpulse(size_t /*aId*/, float /*aX*/, float /*aY*/, bool /*aWorld*/)
 {
 }
@@ -92,7 +102,15 @@ size_t bart::NullPhysic::GetBodyCount()
     return 0;
 }
 
-void bart::NullPhysic::Update()
+void bart::NullPhysic::Update(float /*aDelta*/)
+{
+}
+
+void bart::NullPhysic::SetStep(float /*aStep*/, int /*aMaxSubsteps*/)
+{
+}
+
+void bart::NullPhysic::SetIterations(int /*aVelocity*/, int /*aPosition*/)
 {
 }
 
@@ -150,7 +168,19 @@ void bart::NullPhysic::ClearWorld()
 {
 }
 
-void bart::NullPhysic::AddContactInfo(ContactInfo* /*aContactInfo*/)
+void bart::NullPhysic::SetThreaded(bool /*aThreaded*/)
+{
+}
+
+void bart::NullPhysic::SetSolverThreads(int /*aThreads*/)
+{
+}
+
+void bart::NullPhysic::SetWideSolver(bool /*aWide*/)
+{
+}
+
+void bart::NullPhysic::SetWideCollide(bool /*aWide*/)
 {
 }
 
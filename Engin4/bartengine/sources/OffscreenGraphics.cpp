@@ -0,0 +1,144 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: OffscreenGraphics.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <OffscreenGraphics.h>
+#include <SDL.h>
+#include <Engine.h>
+#include <cstdio>
+
+bool bart::OffscreenGraphics::Initialize()
+{
+    // No display nor sound card on build machines, the dummy drivers let every SDL service start
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 0);
+    SDL_setenv("SDL_AUDIODRIVER", "dummy", 0);
+
+    m_FrameHash = 0;
+    m_SequenceHash = 14695981039346656037ULL;
+    m_PresentedFrames = 0;
+    return SoftwareGraphics::Initialize();
+}
+
+void bart::OffscreenGraphics::Clean()
+{
+    Engine::Instance().GetLogger().Log("Offscreen: %u frames, sequence hash %016llx\n", m_PresentedFrames, m_SequenceHash);
+    SoftwareGraphics::Clean();
+}
+
+void bart::OffscreenGraphics::GetScreenSize(int* aWidth, int* aHeight)
+{
+    *aWidth = m_ScreenWidth;
+    *aHeight = m_ScreenHeight;
+}
+
+void bart::OffscreenGraphics::GetWindowSize(int* aWidth, int* aHeight)
+{
+    *aWidth = m_ScreenWidth;
+    *aHeight = m_ScreenHeight;
+}
+
+void bart::OffscreenGraphics::SetHashLogging(const bool aEnabled)
+{
+    m_HashLogging = aEnabled;
+}
+
+void bart::OffscreenGraphics::SetFrameDumps(const string& aFolder, const unsigned int aInterval)
+{
+    m_DumpFolder = aFolder;
+    m_DumpInterval = aInterval;
+}
+
+void bart::OffscreenGraphics::DumpNextFrame(const string& aFilename)
+{
+    m_NextDump = aFilename;
+}
+
+bool bart::OffscreenGraphics::CreateOutput(const string& /*aTitle*/, int /*aWidth*/, int /*aHeight*/, EWindowState /*aState*/)
+{
+    return true;
+}
+
+void bart::OffscreenGraphics::PresentOutput()
+{
+    m_FrameHash = HashFrame(m_Frame);
+    m_SequenceHash = (m_SequenceHash ^ m_FrameHash) * 1099511628211ULL;
+
+    if (m_HashLogging)
+    {
+        Engine::Instance().GetLogger().Log("Frame %u: %016llx\n", m_PresentedFrames, m_FrameHash);
+    }
+
+    if (!m_NextDump.empty())
+    {
+        SaveFrame(m_NextDump);
+        m_NextDump.clear();
+    }
+
+    if (m_DumpInterval > 0 && m_PresentedFrames % m_DumpInterval == 0)
+    {
+        char tName[32];
+        snprintf(tName, sizeof(tName), "frame_%05u.bmp", m_PresentedFrames);
+        SaveFrame(m_DumpFolder + "/" + tName);
+    }
+
+    m_PresentedFrames++;
+}
+
+void bart::OffscreenGraphics::DestroyOutput()
+{
+}
+
+bool bart::OffscreenGraphics::SaveFrame(const string& aFilename) const
+{
+    SDL_Surface* tSurface = SDL_CreateRGBSurfaceWithFormatFrom(
+        const_cast<unsigned int*>(m_Frame.Pixels.data()), m_Frame.Width, m_Frame.Height, 32, m_Frame.Width * 4,
+        SDL_PIXELFORMAT_ARGB8888);
+
+    if (tSurface == nullptr || SDL_SaveBMP(tSurface, aFilename.c_str()) != 0)
+    {
+        Engine::Instance().GetLogger().Log("Cannot save frame: %s\n", aFilename.c_str());
+        SDL_FreeSurface(tSurface);
+        return false;
+    }
+
+    SDL_FreeSurface(tSurface);
+    return true;
+}
+
+unsigned long long bart::OffscreenGraphics::HashFrame(const SoftwareSurface& aFrame)
+{
+    // FNV-1a over the pixels, the size is part of the hash
+    unsigned long long tHash = 14695981039346656037ULL;
+    tHash = (tHash ^ static_cast<unsigned int>(aFrame.Width)) * 1099511628211ULL;
+    tHash = (tHash ^ static_cast<unsigned int>(aFrame.Height)) * 1099511628211ULL;
+
+    for (const unsigned int tPixel : aFrame.Pixels)
+    {
+        tHash = (tHash ^ tPixel) * 1099511628211ULL;
+    }
+
+    return tHash;
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: OverdrawAnalyzer.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <OverdrawAnalyzer.h>
+#include <algorithm>
+#include <cstdio>
+
+void bart::OverdrawAnalyzer::SetEnabled(const bool aEnabled)
+{
+    m_Enabled = aEnabled;
+
+    if (!m_Enabled)
+    {
+        m_Counts.clear();
+        m_LastCounts.clear();
+        m_Scopes.clear();
+        m_LastScopes.clear();
+        m_ScopeStats = nullptr;
+        m_Width = 0;
+        m_Height = 0;
+    }
+}
+
+void bart::OverdrawAnalyzer::Resize(const int aWidth, const int aHeight)
+{
+    if (aWidth != m_Width || aHeight != m_Height)
+    {
+        m_Width = std::max(aWidth, 0);
+        m_Height = std::max(aHeight, 0);
+        m_Counts.assign(static_cast<size_t>(m_Width) * m_Height, 0);
+        m_LastCounts.assign(m_Counts.size(), 0);
+    }
+}
+
+void bart::OverdrawAnalyzer::SetScope(const std::string& aScope)
+{
+    if (m_Enabled && aScope != m_Scope)
+    {
+        m_Scope = aScope;
+        m_ScopeStats = &m_Scopes[m_Scope];
+    }
+}
+
+void bart::OverdrawAnalyzer::Add(const int aX, const int aY, const int aWidth, const int aHeight)
+{
+    if (!m_Enabled)
+    {
+        return;
+    }
+
+    const int tLeft = std::max(aX, 0);
+    const int tTop = std::max(aY, 0);
+    const int tRight = std::min(aX + aWidth, m_Width);
+    const int tBottom = std::min(aY + aHeight, m_Height);
+
+    if (tRight <= tLeft || tBottom <= tTop)
+    {
+        return;
+    }
+
+    if (m_ScopeStats == nullptr)
+    {
+        m_ScopeStats = &m_Scopes[m_Scope];
+    }
+
+    unsigned long long tOverdrawn = 0;
+    for (int y = tTop; y < tBottom; y++)
+    {
+        unsigned short* tRow = &m_Counts[static_cast<size_t>(y) * m_Width];
+        for (int x = tLeft; x < tRight; x++)
+        {
+            if (tRow[x] > 0)
+            {
+                tOverdrawn++;
+            }
+
+            if (tRow[x] < 0xFFFF)
+            {
+                tRow[x]++;
+            }
+        }
+    }
+
+    m_ScopeStats->Written += static_cast<unsigned long long>(tRight - tLeft) * (tBottom - tTop);
+    m_ScopeStats->Overdrawn += tOverdrawn;
+}
+
+void bart::OverdrawAnalyzer::EndFrame()
+{
+    if (!m_Enabled)
+    {
+        return;
+    }
+
+    m_LastWritten = 0;
+    m_LastCovered = 0;
+
+    for (unsigned short tCount : m_Counts)
+    {
+        m_LastWritten += tCount;
+        if (tCount > 0)
+        {
+            m_LastCovered++;
+        }
+    }
+
+    m_LastCounts.swap(m_Counts);
+    std::fill(m_Counts.begin(), m_Counts.end(), static_cast<unsigned short>(0));
+
+    m_LastScopes.swap(m_Scopes);
+    m_Scopes.clear();
+    m_ScopeStats = nullptr;
+}
+
+float bart::OverdrawAnalyzer::GetOverdrawRatio() const
+{
+    if (m_LastCovered == 0)
+    {
+        return 0.0f;
+    }
+
+    return static_cast<float>(m_LastWritten) / static_cast<float>(m_LastCovered);
+}
+
+void bart::OverdrawAnalyzer::GetHeatmap(std::vector<unsigned int>* aPixels) const
+{
+    // ARGB, nothing written is transparent, then blue, green, yellow, orange and red from 5 writes
+    static const unsigned int HEAT_COLORS[] = {
+        0x00000000, 0xFF0000FF, 0xFF00C000, 0xFFFFFF00, 0xFFFF8000, 0xFFFF0000
+    };
+
+    aPixels->resize(m_LastCounts.size());
+    for (size_t i = 0; i < m_LastCounts.size(); i++)
+    {
+        (*aPixels)[i] = HEAT_COLORS[std::min(static_cast<int>(m_LastCounts[i]), 5)];
+    }
+}
+
+std::string bart::OverdrawAnalyzer::ToString() const
+{
+    char tLine[160];
+    snprintf(tLine, sizeof(tLine), "Overdraw: %.2fx (%llu written, %llu covered)\n", GetOverdrawRatio(), m_LastWritten,
+             m_LastCovered);
+    std::string tResult = tLine;
+
+    for (TScopeMap::const_iterator tItr = m_LastScopes.begin(); tItr != m_LastScopes.end(); ++tItr)
+    {
+        const ScopeStats& tStats = tItr->second;
+        const float tRatio = tStats.Written > 0 ? static_cast<float>(tStats.Overdrawn) / static_cast<float>(tStats.Written) : 0.0f;
+
+        snprintf(tLine, sizeof(tLine), "  %s: %llu written, %.0f%% over\n",
+                 tItr->first.empty() ? "(none)" : tItr->first.c_str(), tStats.Written, tRatio * 100.0f);
+        tResult += tLine;
+    }
+
+    return tResult;
+}
\ No newline at end of file
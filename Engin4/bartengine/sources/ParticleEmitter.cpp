@@ -0,0 +1,262 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: ParticleEmitter.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <ParticleEmitter.h>
+#include <Engine.h>
+#include <Transform.h>
+#include <MathHelper.h>
+#include <algorithm>
+#include <cmath>
+#include <emmintrin.h>
+
+bart::ParticleEmitter::ParticleEmitter(const ParticleSettings& aSettings, const unsigned int aSeed)
+    : m_Settings(aSettings), m_Seed(aSeed != 0 ? aSeed : 1)
+{
+    Resize();
+}
+
+bool bart::ParticleEmitter::Load(const std::string& aFilename)
+{
+    Unload();
+
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    m_Texture = tGraphic.LoadTexture(aFilename);
+
+    if (m_Texture == 0)
+    {
+        return false;
+    }
+
+    int tWidth, tHeight;
+    tGraphic.GetTextureSize(m_Texture, &tWidth, &tHeight);
+    m_Source.Set(0, 0, tWidth, tHeight);
+    return true;
+}
+
+void bart::ParticleEmitter::Unload()
+{
+    if (m_Texture != 0)
+    {
+        Engine::Instance().GetGraphic().UnloadTexture(m_Texture);
+        m_Texture = 0;
+    }
+}
+
+void bart::ParticleEmitter::SetSettings(const ParticleSettings& aSettings)
+{
+    const bool tResize = aSettings.Capacity != m_Settings.Capacity;
+    m_Settings = aSettings;
+
+    if (tResize)
+    {
+        Resize();
+    }
+}
+
+void bart::ParticleEmitter::SetPosition(const float aX, const float aY)
+{
+    m_X = aX;
+    m_Y = aY;
+}
+
+void bart::ParticleEmitter::Attach(const Transform* aTransform)
+{
+    m_Transform = aTransform;
+}
+
+void bart::ParticleEmitter::Burst(const size_t aCount)
+{
+    m_Bursts += aCount;
+}
+
+size_t bart::ParticleEmitter::Update(const float aDelta, const size_t aBudget)
+{
+    if (m_Transform != nullptr)
+    {
+        m_X = m_Transform->X + m_Transform->Width * 0.5f;
+        m_Y = m_Transform->Y + m_Transform->Height * 0.5f;
+    }
+
+    // Velocity, position and age of 4 particles at a time, the padding lanes are never read back
+    const __m128 tDelta = _mm_set1_ps(aDelta);
+    const __m128 tGravityX = _mm_set1_ps(m_Settings.GravityX * aDelta);
+    const __m128 tGravityY = _mm_set1_ps(m_Settings.GravityY * aDelta);
+    const __m128 tOne = _mm_set1_ps(1.0f);
+    int tDead = 0;
+
+    for (size_t i = 0; i < m_Count; i += 4)
+    {
+        const __m128 tVelX = _mm_add_ps(_mm_loadu_ps(&m_VelX[i]), tGravityX);
+        const __m128 tVelY = _mm_add_ps(_mm_loadu_ps(&m_VelY[i]), tGravityY);
+        const __m128 tAge = _mm_add_ps(_mm_loadu_ps(&m_Age[i]), tDelta);
+
+        _mm_storeu_ps(&m_VelX[i], tVelX);
+        _mm_storeu_ps(&m_VelY[i], tVelY);
+        _mm_storeu_ps(&m_PosX[i], _mm_add_ps(_mm_loadu_ps(&m_PosX[i]), _mm_mul_ps(tVelX, tDelta)));
+        _mm_storeu_ps(&m_PosY[i], _mm_add_ps(_mm_loadu_ps(&m_PosY[i]), _mm_mul_ps(tVelY, tDelta)));
+        _mm_storeu_ps(&m_Age[i], tAge);
+
+        // The padding lanes of the last group may hold particles removed earlier, their ages do not count
+        const int tLanes = m_Count - i < 4 ? (1 << (m_Count - i)) - 1 : 0xF;
+        tDead |= _mm_movemask_ps(_mm_cmpge_ps(_mm_mul_ps(tAge, _mm_loadu_ps(&m_InvLife[i])), tOne)) & tLanes;
+    }
+
+    // The last particle takes the place of a dead one, the arrays stay packed
+    if (tDead != 0)
+    {
+        for (size_t i = 0; i < m_Count;)
+        {
+            if (m_Age[i] * m_InvLife[i] >= 1.0f)
+            {
+                m_Count--;
+                m_PosX[i] = m_PosX[m_Count];
+                m_PosY[i] = m_PosY[m_Count];
+                m_VelX[i] = m_VelX[m_Count];
+                m_VelY[i] = m_VelY[m_Count];
+                m_Age[i] = m_Age[m_Count];
+                m_InvLife[i] = m_InvLife[m_Count];
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+
+    size_t tWanted = m_Bursts;
+    m_Bursts = 0;
+
+    if (m_Emitting)
+    {
+        m_Debt += m_Settings.Rate * aDelta;
+        const size_t tEmitted = static_cast<size_t>(m_Debt);
+        m_Debt -= static_cast<float>(tEmitted);
+        tWanted += tEmitted;
+    }
+
+    const size_t tSpawned = Spawn(std::min(tWanted, aBudget));
+    m_Dropped = tWanted - tSpawned;
+    return tSpawned;
+}
+
+void bart::ParticleEmitter::Draw()
+{
+    if (m_Count == 0 || m_Texture == 0)
+    {
+        return;
+    }
+
+    m_Destinations.resize(m_Count);
+    m_Tints.resize(m_Count);
+
+    // Size, color and alpha over the life, 4 particles at a time
+    const __m128 tOne = _mm_set1_ps(1.0f);
+    const __m128 tHalf = _mm_set1_ps(0.5f);
+    const __m128 tStartSize = _mm_set1_ps(m_Settings.StartSize);
+    const __m128 tSizeRange = _mm_set1_ps(m_Settings.EndSize - m_Settings.StartSize);
+    const Color& tStart = m_Settings.StartColor;
+    const Color& tEnd = m_Settings.EndColor;
+    const __m128 tStartColor[4] = {_mm_set1_ps(tStart.R), _mm_set1_ps(tStart.G), _mm_set1_ps(tStart.B), _mm_set1_ps(tStart.A)};
+    const __m128 tColorRange[4] = {_mm_set1_ps(static_cast<float>(tEnd.R - tStart.R)), _mm_set1_ps(static_cast<float>(tEnd.G - tStart.G)),
+                                   _mm_set1_ps(static_cast<float>(tEnd.B - tStart.B)), _mm_set1_ps(static_cast<float>(tEnd.A - tStart.A))};
+
+    alignas(16) int tX[4];
+    alignas(16) int tY[4];
+    alignas(16) int tSize[4];
+    alignas(16) int tChannels[4][4];
+
+    for (size_t i = 0; i < m_Count; i += 4)
+    {
+        const __m128 tLife = _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(&m_Age[i]), _mm_loadu_ps(&m_InvLife[i])), tOne);
+        const __m128 tSide = _mm_add_ps(tStartSize, _mm_mul_ps(tSizeRange, tLife));
+        const __m128 tHalfSide = _mm_mul_ps(tSide, tHalf);
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(tX), _mm_cvtps_epi32(_mm_sub_ps(_mm_loadu_ps(&m_PosX[i]), tHalfSide)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(tY), _mm_cvtps_epi32(_mm_sub_ps(_mm_loadu_ps(&m_PosY[i]), tHalfSide)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(tSize), _mm_cvtps_epi32(tSide));
+
+        for (int c = 0; c < 4; c++)
+        {
+            const __m128 tChannel = _mm_add_ps(tStartColor[c], _mm_mul_ps(tColorRange[c], tLife));
+            _mm_store_si128(reinterpret_cast<__m128i*>(tChannels[c]), _mm_cvtps_epi32(tChannel));
+        }
+
+        const size_t tLanes = std::min<size_t>(4, m_Count - i);
+        for (size_t j = 0; j < tLanes; j++)
+        {
+            m_Destinations[i + j].Set(tX[j], tY[j], tSize[j], tSize[j]);
+            m_Tints[i + j].Set(static_cast<unsigned char>(tChannels[0][j]), static_cast<unsigned char>(tChannels[1][j]),
+                               static_cast<unsigned char>(tChannels[2][j]), static_cast<unsigned char>(tChannels[3][j]));
+        }
+    }
+
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    tGraphic.DrawSprites(m_Texture, m_Source, m_Destinations.data(), m_Tints.data(), m_Count);
+    tGraphic.GetRenderStats().Add(PARTICLES_DRAWN, m_Count);
+}
+
+size_t bart::ParticleEmitter::Spawn(const size_t aCount)
+{
+    const size_t tCount = std::min(aCount, m_Settings.Capacity - m_Count);
+
+    for (size_t i = 0; i < tCount; i++, m_Count++)
+    {
+        const float tAngle = (m_Settings.Direction + Random(-0.5f, 0.5f) * m_Settings.Spread) * TO_RADIANS;
+        const float tSpeed = Random(m_Settings.MinSpeed, m_Settings.MaxSpeed);
+        const float tLife = Random(m_Settings.MinLife, m_Settings.MaxLife);
+
+        m_PosX[m_Count] = m_X;
+        m_PosY[m_Count] = m_Y;
+        m_VelX[m_Count] = std::cos(tAngle) * tSpeed;
+        m_VelY[m_Count] = std::sin(tAngle) * tSpeed;
+        m_Age[m_Count] = 0.0f;
+        m_InvLife[m_Count] = 1.0f / std::max(tLife, 0.001f);
+    }
+
+    return tCount;
+}
+
+float bart::ParticleEmitter::Random(const float aMin, const float aMax)
+{
+    // Xorshift, each emitter has its own sequence and the runs are reproducible
+    m_Seed ^= m_Seed << 13;
+    m_Seed ^= m_Seed >> 17;
+    m_Seed ^= m_Seed << 5;
+    return aMin + (aMax - aMin) * static_cast<float>(m_Seed >> 8) * (1.0f / 16777216.0f);
+}
+
+void bart::ParticleEmitter::Resize()
+{
+    // The kernels read 4 particles at a time, the last block is padded
+    const size_t tPadded = (m_Settings.Capacity + 3) & ~static_cast<size_t>(3);
+    m_PosX.resize(tPadded, 0.0f);
+    m_PosY.resize(tPadded, 0.0f);
+    m_VelX.resize(tPadded, 0.0f);
+    m_VelY.resize(tPadded, 0.0f);
+    m_Age.resize(tPadded, 0.0f);
+    m_InvLife.resize(tPadded, 0.0f);
+    m_Count = std::min(m_Count, m_Settings.Capacity);
+}
\ No newline at end of file
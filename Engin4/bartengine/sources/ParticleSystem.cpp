@@ -0,0 +1,103 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: ParticleSystem.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <ParticleSystem.h>
+#include <algorithm>
+#include <chrono>
+
+const size_t bart::ParticleSystem::DEFAULT_MAX_PARTICLES = 65536;
+
+bart::ParticleEmitter* bart::ParticleSystem::CreateEmitter(const ParticleSettings& aSettings)
+{
+    // Knuth's multiplier spreads the seeds, the emitters created together do not look alike
+    ParticleEmitter* tEmitter = new ParticleEmitter(aSettings, m_NextSeed++ * 2654435761u);
+    m_Emitters.push_back(tEmitter);
+    return tEmitter;
+}
+
+void bart::ParticleSystem::DestroyEmitter(ParticleEmitter* aEmitter)
+{
+    const std::vector<ParticleEmitter*>::iterator tItr = std::find(m_Emitters.begin(), m_Emitters.end(), aEmitter);
+
+    if (tItr != m_Emitters.end())
+    {
+        (*tItr)->Unload();
+        delete *tItr;
+        m_Emitters.erase(tItr);
+    }
+}
+
+void bart::ParticleSystem::Clean()
+{
+    for (ParticleEmitter* tEmitter : m_Emitters)
+    {
+        tEmitter->Unload();
+        delete tEmitter;
+    }
+
+    m_Emitters.clear();
+    m_Stats = Stats();
+}
+
+void bart::ParticleSystem::Update(const float aDelta)
+{
+    const std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+
+    size_t tAlive = 0;
+    for (ParticleEmitter* tEmitter : m_Emitters)
+    {
+        tAlive += tEmitter->GetCount();
+    }
+
+    // The emitters share what is left under the bound, in the order they were created
+    size_t tBudget = m_MaxParticles > tAlive ? m_MaxParticles - tAlive : 0;
+    m_Stats.Spawned = 0;
+    m_Stats.Dropped = 0;
+    m_Stats.Alive = 0;
+
+    for (ParticleEmitter* tEmitter : m_Emitters)
+    {
+        const size_t tBefore = tEmitter->GetCount();
+        const size_t tSpawned = tEmitter->Update(aDelta, tBudget);
+
+        // The particles dying this frame give their room back to the next emitters
+        tBudget = std::min(tBudget - tSpawned + (tBefore + tSpawned - tEmitter->GetCount()), m_MaxParticles);
+        m_Stats.Spawned += tSpawned;
+        m_Stats.Dropped += tEmitter->GetDropped();
+        m_Stats.Alive += tEmitter->GetCount();
+    }
+
+    m_Stats.Emitters = m_Emitters.size();
+    m_Stats.UpdateMilliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - tStart).count();
+}
+
+void bart::ParticleSystem::Draw()
+{
+    for (ParticleEmitter* tEmitter : m_Emitters)
+    {
+        tEmitter->Draw();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,240 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: RenderComparison.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <RenderComparison.h>
+#include <OffscreenGraphics.h>
+#include <SdlGraphics.h>
+#include <Engine.h>
+#include <Camera.h>
+#include <Color.h>
+#include <SDL.h>
+#include <algorithm>
+
+const bart::RenderComparison::DrawCase bart::RenderComparison::CASES[] =
+{
+    {"Fills", &RenderComparison::DrawFills, 0.0f},
+    {"Copies", &RenderComparison::DrawCopies, 0.0f},
+    {"Camera", &RenderComparison::DrawCamera, 0.0f},
+    {"Flips", &RenderComparison::DrawFlips, 0.0f},
+    {"Alpha", &RenderComparison::DrawAlpha, 0.0f},
+    {"Rotations", &RenderComparison::DrawRotations, 0.01f},
+    {"Stretch", &RenderComparison::DrawStretch, 0.002f}
+};
+
+const int bart::RenderComparison::CASE_COUNT = sizeof(CASES) / sizeof(CASES[0]);
+const int bart::RenderComparison::CHANNEL_TOLERANCE = 2;
+
+bool bart::RenderComparison::Run(OffscreenGraphics& aSoftware, const string& aTexture)
+{
+    ILogger& tLogger = Engine::Instance().GetLogger();
+    Camera tCamera;
+
+    int tWidth, tHeight;
+    aSoftware.GetScreenSize(&tWidth, &tHeight);
+
+    // The software renderer first, the reference quits SDL when it is cleaned
+    vector<vector<unsigned int>> tFrames(CASE_COUNT);
+    const size_t tSoftwareTexture = aSoftware.LoadTexture(aTexture);
+    for (int i = 0; i < CASE_COUNT; i++)
+    {
+        CASES[i].Draw(aSoftware, tSoftwareTexture, tCamera);
+        aSoftware.Present();
+        tFrames[i] = aSoftware.GetFrame().Pixels;
+    }
+
+    aSoftware.UnloadTexture(tSoftwareTexture);
+
+    SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    SdlGraphics tReference;
+    if (!tReference.Initialize() || !tReference.InitWindow("Reference", tWidth, tHeight, WINDOWED))
+    {
+        tLogger.Log("Compare: cannot create the SDL reference renderer\n");
+        tReference.Clean();
+        return false;
+    }
+
+    bool tPassed = true;
+    vector<unsigned int> tPixels;
+    const size_t tReferenceTexture = tReference.LoadTexture(aTexture);
+    for (int i = 0; i < CASE_COUNT; i++)
+    {
+        CASES[i].Draw(tReference, tReferenceTexture, tCamera);
+        const bool tRead = tReference.ReadPixels(tPixels);
+        tReference.Present();
+
+        int tMaxDelta = 0;
+        const int tMismatches = tRead ? CountMismatches(tFrames[i], tPixels, &tMaxDelta) : tWidth * tHeight;
+        const bool tCasePassed = static_cast<float>(tMismatches) <= CASES[i].MaxMismatch * static_cast<float>(tWidth * tHeight);
+
+        tLogger.Log("Compare %s: %d pixels differ, largest difference %d, %s\n", CASES[i].Name, tMismatches, tMaxDelta,
+                    tCasePassed ? "passed" : "FAILED");
+        tPassed = tPassed && tCasePassed;
+    }
+
+    tReference.UnloadTexture(tReferenceTexture);
+    tReference.Clean();
+
+    tLogger.Log("Compare: %s\n", tPassed ? "all cases passed" : "some cases FAILED");
+    return tPassed;
+}
+
+void bart::RenderComparison::DrawFills(IGraphic& aGraphic, size_t /*aTexture*/, Camera& /*aCamera*/)
+{
+    aGraphic.SetCamera(nullptr);
+    aGraphic.SetClearColor(30, 40, 50);
+    aGraphic.Clear();
+
+    aGraphic.SetColor(200, 60, 20, 255);
+    aGraphic.Fill(10, 10, 200, 120);
+    aGraphic.SetColor(20, 200, 90, 128);
+    aGraphic.Fill(110, 70, 200, 120);
+    aGraphic.SetColor(255, 255, 255, 255);
+    aGraphic.Draw(Rectangle{330, 10, 150, 90});
+}
+
+void bart::RenderComparison::DrawCopies(IGraphic& aGraphic, const size_t aTexture, Camera& /*aCamera*/)
+{
+    aGraphic.SetCamera(nullptr);
+    aGraphic.Clear();
+
+    int tWidth, tHeight;
+    aGraphic.GetTextureSize(aTexture, &tWidth, &tHeight);
+
+    aGraphic.Draw(aTexture, {0, 0, tWidth, tHeight}, {20, 20, tWidth, tHeight}, 0.0f, false, false, 255);
+    aGraphic.Draw(aTexture, {tWidth / 4, tHeight / 4, tWidth / 2, tHeight / 2}, {40 + tWidth, 20, tWidth / 2, tHeight / 2},
+                  0.0f, false, false, 255);
+}
+
+void bart::RenderComparison::DrawCamera(IGraphic& aGraphic, const size_t aTexture, Camera& aCamera)
+{
+    aGraphic.Clear();
+
+    int tWidth, tHeight;
+    aGraphic.GetTextureSize(aTexture, &tWidth, &tHeight);
+
+    // Partly out of the screen on the left and the top
+    aCamera.SetPosition(tWidth / 2, tHeight / 3);
+    aGraphic.SetCamera(&aCamera);
+    aGraphic.Draw(aTexture, {0, 0, tWidth, tHeight}, {0, 0, tWidth, tHeight}, 0.0f, false, false, 255);
+    aGraphic.SetColor(90, 90, 220, 255);
+    aGraphic.Fill(tWidth, tHeight, 80, 60);
+    aGraphic.SetCamera(nullptr);
+}
+
+void bart::RenderComparison::DrawFlips(IGraphic& aGraphic, const size_t aTexture, Camera& /*aCamera*/)
+{
+    aGraphic.SetCamera(nullptr);
+    aGraphic.Clear();
+
+    int tWidth, tHeight;
+    aGraphic.GetTextureSize(aTexture, &tWidth, &tHeight);
+
+    const Rectangle tSrc = {0, 0, tWidth, tHeight};
+    aGraphic.Draw(aTexture, tSrc, {10, 10, tWidth, tHeight}, 0.0f, true, false, 255);
+    aGraphic.Draw(aTexture, tSrc, {20 + tWidth, 10, tWidth, tHeight}, 0.0f, false, true, 255);
+    aGraphic.Draw(aTexture, tSrc, {30 + tWidth * 2, 10, tWidth, tHeight}, 0.0f, true, true, 255);
+}
+
+void bart::RenderComparison::DrawAlpha(IGraphic& aGraphic, const size_t aTexture, Camera& /*aCamera*/)
+{
+    aGraphic.SetCamera(nullptr);
+    aGraphic.Clear();
+
+    int tWidth, tHeight;
+    aGraphic.GetTextureSize(aTexture, &tWidth, &tHeight);
+
+    aGraphic.SetColor(240, 200, 40, 255);
+    aGraphic.Fill(0, 0, tWidth * 3 + 40, tHeight + 20);
+
+    const Rectangle tSrc = {0, 0, tWidth, tHeight};
+    aGraphic.Draw(aTexture, tSrc, {10, 10, tWidth, tHeight}, 0.0f, false, false, 200);
+    aGraphic.Draw(aTexture, tSrc, {20 + tWidth, 10, tWidth, tHeight}, 0.0f, false, false, 96);
+
+    aGraphic.SetBlending(false);
+    aGraphic.Draw(aTexture, tSrc, {30 + tWidth * 2, 10, tWidth, tHeight}, 0.0f, false, false, 255);
+    aGraphic.SetBlending(true);
+}
+
+void bart::RenderComparison::DrawRotations(IGraphic& aGraphic, const size_t aTexture, Camera& /*aCamera*/)
+{
+    aGraphic.SetCamera(nullptr);
+    aGraphic.Clear();
+
+    int tWidth, tHeight;
+    aGraphic.GetTextureSize(aTexture, &tWidth, &tHeight);
+
+    const Rectangle tSrc = {0, 0, tWidth, tHeight};
+    const int tStep = std::max(tWidth, tHeight) + 20;
+    aGraphic.Draw(aTexture, tSrc, {20, 20, tWidth, tHeight}, 90.0f, false, false, 255);
+    aGraphic.Draw(aTexture, tSrc, {20 + tStep, 20, tWidth, tHeight}, 180.0f, false, false, 255);
+    aGraphic.Draw(aTexture, tSrc, {20 + tStep * 2, 20, tWidth, tHeight}, 30.0f, false, false, 255);
+    aGraphic.Draw(aTexture, tSrc, {20 + tStep * 3, 20, tWidth, tHeight}, 45.0f, true, false, 160);
+}
+
+void bart::RenderComparison::DrawStretch(IGraphic& aGraphic, const size_t aTexture, Camera& /*aCamera*/)
+{
+    aGraphic.SetCamera(nullptr);
+    aGraphic.Clear();
+
+    int tWidth, tHeight;
+    aGraphic.GetTextureSize(aTexture, &tWidth, &tHeight);
+
+    const Rectangle tSrc = {0, 0, tWidth, tHeight};
+    aGraphic.Draw(aTexture, tSrc, {10, 10, tWidth * 2, tHeight * 3}, 0.0f, false, false, 255);
+    aGraphic.Draw(aTexture, tSrc, {20 + tWidth * 2, 10, tWidth / 2, tHeight / 2}, 0.0f, false, false, 255);
+}
+
+int bart::RenderComparison::CountMismatches(const vector<unsigned int>& aFrame, const vector<unsigned int>& aReference,
+                                            int* aMaxDelta)
+{
+    if (aFrame.size() != aReference.size())
+    {
+        *aMaxDelta = 255;
+        return static_cast<int>(std::max(aFrame.size(), aReference.size()));
+    }
+
+    // The window of the reference has no alpha, only the colors are compared
+    int tMismatches = 0;
+    for (size_t i = 0; i < aFrame.size(); i++)
+    {
+        int tDelta = 0;
+        for (int tShift = 0; tShift < 24; tShift += 8)
+        {
+            const int tChannel = static_cast<int>((aFrame[i] >> tShift) & 0xFF);
+            const int tReference = static_cast<int>((aReference[i] >> tShift) & 0xFF);
+            tDelta = std::max(tDelta, std::abs(tChannel - tReference));
+        }
+
+        *aMaxDelta = std::max(*aMaxDelta, tDelta);
+        if (tDelta > CHANNEL_TOLERANCE)
+        {
+            tMismatches++;
+        }
+    }
+
+    return tMismatches;
+}
\ No newline at end of file
@@ -0,0 +1,392 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: RenderGraph.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <RenderGraph.h>
+#include <Engine.h>
+#include <Color.h>
+#include <chrono>
+#include <cstdio>
+
+const size_t bart::RenderGraph::BACKBUFFER = 0;
+const unsigned int bart::RenderGraph::POOL_LIFETIME = 120;
+
+void bart::RenderGraph::Clean()
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    for (PooledTarget& tPooled : m_Pool)
+    {
+        tGraphic.UnloadTexture(tPooled.Target);
+    }
+
+    m_Pool.clear();
+    m_Resources.clear();
+    m_Passes.clear();
+    m_Stats.clear();
+}
+
+size_t bart::RenderGraph::AddResource(const std::string& aName, const int aWidth, const int aHeight, const bool aPersistent)
+{
+    Resource tResource;
+    tResource.Name = aName;
+    tResource.Width = aWidth;
+    tResource.Height = aHeight;
+    tResource.Persistent = aPersistent;
+
+    for (size_t i = 0; i < m_Resources.size(); i++)
+    {
+        if (m_Resources[i].Removed)
+        {
+            m_Resources[i] = tResource;
+            return i + 1;
+        }
+    }
+
+    m_Resources.push_back(tResource);
+    return m_Resources.size();
+}
+
+void bart::RenderGraph::RemoveResource(const size_t aResource)
+{
+    if (aResource == BACKBUFFER || aResource > m_Resources.size())
+    {
+        return;
+    }
+
+    Resource& tResource = m_Resources[aResource - 1];
+    Release(tResource);
+    tResource = Resource();
+    tResource.Removed = true;
+}
+
+void bart::RenderGraph::SetResourceSize(const size_t aResource, const int aWidth, const int aHeight)
+{
+    if (aResource == BACKBUFFER || aResource > m_Resources.size())
+    {
+        return;
+    }
+
+    Resource& tResource = m_Resources[aResource - 1];
+    if (tResource.Width != aWidth || tResource.Height != aHeight)
+    {
+        Release(tResource);
+        tResource.Width = aWidth;
+        tResource.Height = aHeight;
+    }
+}
+
+size_t bart::RenderGraph::AddPass(const std::string& aName, const TPassFunction& aExecute)
+{
+    Pass tPass;
+    tPass.Name = aName;
+    tPass.Execute = aExecute;
+    m_Passes.push_back(tPass);
+    return m_Passes.size();
+}
+
+void bart::RenderGraph::RemovePass(const size_t aPass)
+{
+    if (aPass == 0 || aPass > m_Passes.size())
+    {
+        return;
+    }
+
+    Pass& tPass = m_Passes[aPass - 1];
+    tPass = Pass();
+    tPass.Removed = true;
+
+    // The slots keep the execution order, only the removed ones at the end can be reused
+    while (!m_Passes.empty() && m_Passes.back().Removed)
+    {
+        m_Passes.pop_back();
+    }
+}
+
+void bart::RenderGraph::SetOutput(const size_t aPass, const size_t aResource)
+{
+    if (aPass > 0 && aPass <= m_Passes.size())
+    {
+        m_Passes[aPass - 1].Output = aResource;
+    }
+}
+
+void bart::RenderGraph::AddInput(const size_t aPass, const size_t aResource)
+{
+    if (aPass > 0 && aPass <= m_Passes.size() && aResource != BACKBUFFER)
+    {
+        m_Passes[aPass - 1].Inputs.push_back(aResource);
+    }
+}
+
+void bart::RenderGraph::SetEnabled(const size_t aPass, const bool aEnabled)
+{
+    if (aPass > 0 && aPass <= m_Passes.size())
+    {
+        m_Passes[aPass - 1].Enabled = aEnabled;
+    }
+}
+
+void bart::RenderGraph::Execute()
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    m_Backbuffer = tGraphic.GetRenderTarget();
+    m_FrameCount++;
+
+    Cull();
+    m_Stats.clear();
+
+    for (size_t i = 0; i < m_Passes.size(); i++)
+    {
+        Pass& tPass = m_Passes[i];
+        if (tPass.Removed)
+        {
+            continue;
+        }
+
+        PassStats tStats;
+        tStats.Name = tPass.Name;
+
+        if (!tPass.Culled)
+        {
+            const std::chrono::high_resolution_clock::time_point tStart = std::chrono::high_resolution_clock::now();
+
+            bool tBound = true;
+            if (tPass.Output != BACKBUFFER)
+            {
+                Resource& tOutput = m_Resources[tPass.Output - 1];
+                if (tOutput.Target == 0)
+                {
+                    Acquire(tOutput);
+                }
+
+                tBound = tOutput.Target != 0 && tGraphic.SetRenderTarget(tOutput.Target);
+
+                // A pooled target holds what its previous user drew
+                if (tBound && tOutput.NewTarget)
+                {
+                    tGraphic.Clear(Color(0, 0, 0, 0));
+                }
+            }
+
+            if (tBound)
+            {
+                tPass.Execute(*this);
+
+                if (tPass.Output != BACKBUFFER)
+                {
+                    m_Resources[tPass.Output - 1].NewTarget = false;
+                    tGraphic.SetRenderTarget(m_Backbuffer);
+                }
+            }
+
+            tStats.Culled = !tBound;
+            tStats.Milliseconds = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
+
+            // The transient targets go back to the pool after their last use, a later pass can take them
+            for (Resource& tResource : m_Resources)
+            {
+                if (!tResource.Persistent && tResource.LastUse == static_cast<int>(i))
+                {
+                    Release(tResource);
+                }
+            }
+        }
+        else
+        {
+            tStats.Culled = true;
+        }
+
+        m_Stats.push_back(tStats);
+    }
+
+    TrimPool();
+}
+
+size_t bart::RenderGraph::GetTarget(const size_t aResource) const
+{
+    if (aResource == BACKBUFFER || aResource > m_Resources.size())
+    {
+        return m_Backbuffer;
+    }
+
+    return m_Resources[aResource - 1].Target;
+}
+
+bool bart::RenderGraph::IsNewTarget(const size_t aResource) const
+{
+    if (aResource == BACKBUFFER || aResource > m_Resources.size())
+    {
+        return false;
+    }
+
+    return m_Resources[aResource - 1].NewTarget;
+}
+
+std::string bart::RenderGraph::ToString() const
+{
+    char tLine[128];
+    std::string tText;
+
+    for (const PassStats& tStats : m_Stats)
+    {
+        if (tStats.Culled)
+        {
+            snprintf(tLine, sizeof(tLine), "%s: culled\n", tStats.Name.c_str());
+        }
+        else
+        {
+            snprintf(tLine, sizeof(tLine), "%s: %.3f ms\n", tStats.Name.c_str(), tStats.Milliseconds);
+        }
+
+        tText += tLine;
+    }
+
+    snprintf(tLine, sizeof(tLine), "Pooled targets: %u", static_cast<unsigned int>(m_Pool.size()));
+    tText += tLine;
+    return tText;
+}
+
+void bart::RenderGraph::Cull()
+{
+    for (Resource& tResource : m_Resources)
+    {
+        tResource.Needed = false;
+        tResource.LastUse = -1;
+    }
+
+    // From the last pass, a pass is kept when it draws to the window or to a resource read by a kept pass
+    for (size_t i = m_Passes.size(); i-- > 0;)
+    {
+        Pass& tPass = m_Passes[i];
+        if (tPass.Removed)
+        {
+            continue;
+        }
+
+        tPass.Culled = !tPass.Enabled;
+        if (!tPass.Culled && tPass.Output != BACKBUFFER)
+        {
+            const Resource& tOutput = m_Resources[tPass.Output - 1];
+            tPass.Culled = tOutput.Removed || !tOutput.Needed;
+        }
+
+        if (!tPass.Culled)
+        {
+            for (const size_t tInput : tPass.Inputs)
+            {
+                m_Resources[tInput - 1].Needed = true;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < m_Passes.size(); i++)
+    {
+        Pass& tPass = m_Passes[i];
+        if (tPass.Removed || tPass.Culled)
+        {
+            continue;
+        }
+
+        if (tPass.Output != BACKBUFFER)
+        {
+            m_Resources[tPass.Output - 1].LastUse = static_cast<int>(i);
+        }
+
+        for (const size_t tInput : tPass.Inputs)
+        {
+            m_Resources[tInput - 1].LastUse = static_cast<int>(i);
+        }
+    }
+}
+
+void bart::RenderGraph::Acquire(Resource& aResource)
+{
+    for (PooledTarget& tPooled : m_Pool)
+    {
+        if (!tPooled.InUse && tPooled.Width == aResource.Width && tPooled.Height == aResource.Height)
+        {
+            tPooled.InUse = true;
+            tPooled.LastUsedFrame = m_FrameCount;
+            aResource.Target = tPooled.Target;
+            aResource.NewTarget = true;
+            return;
+        }
+    }
+
+    const size_t tTarget = Engine::Instance().GetGraphic().CreateRenderTarget(aResource.Width, aResource.Height);
+    if (tTarget == 0)
+    {
+        return;
+    }
+
+    PooledTarget tPooled;
+    tPooled.Target = tTarget;
+    tPooled.Width = aResource.Width;
+    tPooled.Height = aResource.Height;
+    tPooled.InUse = true;
+    tPooled.LastUsedFrame = m_FrameCount;
+    m_Pool.push_back(tPooled);
+
+    aResource.Target = tTarget;
+    aResource.NewTarget = true;
+}
+
+void bart::RenderGraph::Release(Resource& aResource)
+{
+    if (aResource.Target == 0)
+    {
+        return;
+    }
+
+    for (PooledTarget& tPooled : m_Pool)
+    {
+        if (tPooled.Target == aResource.Target)
+        {
+            tPooled.InUse = false;
+            tPooled.LastUsedFrame = m_FrameCount;
+            break;
+        }
+    }
+
+    aResource.Target = 0;
+}
+
+void bart::RenderGraph::TrimPool()
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+
+    for (std::vector<PooledTarget>::iterator tItr = m_Pool.begin(); tItr != m_Pool.end();)
+    {
+        if (!tItr->InUse && m_FrameCount - tItr->LastUsedFrame > POOL_LIFETIME)
+        {
+            tGraphic.UnloadTexture(tItr->Target);
+            tItr = m_Pool.erase(tItr);
+        }
+        else
+        {
+            ++tItr;
+        }
+    }
+}
\ No newline at end of file
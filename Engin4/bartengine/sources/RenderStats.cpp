@@ -0,0 +1,172 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: RenderStats.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <RenderStats.h>
+#include <cstring>
+
+bart::RenderStats::RenderStats()
+{
+    Reset();
+}
+
+void bart::RenderStats::Add(const ERenderCounter aCounter, const unsigned long long aValue)
+{
+    m_Current[aCounter] += aValue;
+}
+
+void bart::RenderStats::NextFrame()
+{
+    // The oldest frame leaves the running sum before being overwritten
+    for (int i = 0; i < RENDER_COUNTER_COUNT; i++)
+    {
+        m_Sum[i] -= m_History[m_HistoryIndex][i];
+        m_History[m_HistoryIndex][i] = m_Current[i];
+        m_Sum[i] += m_Current[i];
+        m_Current[i] = 0;
+    }
+
+    m_HistoryIndex = (m_HistoryIndex + 1) % HISTORY_SIZE;
+
+    if (m_HistoryCount < HISTORY_SIZE)
+    {
+        m_HistoryCount++;
+    }
+
+    m_FrameCount++;
+}
+
+void bart::RenderStats::Reset()
+{
+    memset(m_Current, 0, sizeof(m_Current));
+    memset(m_History, 0, sizeof(m_History));
+    memset(m_Sum, 0, sizeof(m_Sum));
+    m_HistoryIndex = 0;
+    m_HistoryCount = 0;
+    m_FrameCount = 0;
+}
+
+unsigned long long bart::RenderStats::GetCurrent(const ERenderCounter aCounter) const
+{
+    return m_Current[aCounter];
+}
+
+unsigned long long bart::RenderStats::GetLast(const ERenderCounter aCounter) const
+{
+    if (m_HistoryCount == 0)
+    {
+        return 0;
+    }
+
+    const int tLast = (m_HistoryIndex + HISTORY_SIZE - 1) % HISTORY_SIZE;
+    return m_History[tLast][aCounter];
+}
+
+float bart::RenderStats::GetAverage(const ERenderCounter aCounter) const
+{
+    if (m_HistoryCount == 0)
+    {
+        return 0.0f;
+    }
+
+    return static_cast<float>(m_Sum[aCounter]) / static_cast<float>(m_HistoryCount);
+}
+
+unsigned long long bart::RenderStats::GetDrawCalls() const
+{
+    unsigned long long tTotal = 0;
+    for (int i = DRAW_RECTANGLE; i <= DRAW_TRANSFORM; i++)
+    {
+        tTotal += GetLast(static_cast<ERenderCounter>(i));
+    }
+
+    return tTotal;
+}
+
+float bart::RenderStats::GetAverageDrawCalls() const
+{
+    float tTotal = 0.0f;
+    for (int i = DRAW_RECTANGLE; i <= DRAW_TRANSFORM; i++)
+    {
+        tTotal += GetAverage(static_cast<ERenderCounter>(i));
+    }
+
+    return tTotal;
+}
+
+std::string bart::RenderStats::ToString() const
+{
+    std::string tResult = "Draw calls: " + std::to_string(GetDrawCalls()) + " (avg " + std::to_string(
+        static_cast<int>(GetAverageDrawCalls())) + ")\n";
+
+    for (int i = 0; i < RENDER_COUNTER_COUNT; i++)
+    {
+        const ERenderCounter tCounter = static_cast<ERenderCounter>(i);
+        tResult += std::string(GetName(tCounter)) + ": " + std::to_string(GetLast(tCounter)) + " (avg " +
+            std::to_string(static_cast<long long>(GetAverage(tCounter))) + ")\n";
+    }
+
+    return tResult;
+}
+
+const char* bart::RenderStats::GetName(const ERenderCounter aCounter)
+{
+    switch (aCounter)
+    {
+    case DRAW_RECTANGLE:
+        return "Rectangles";
+    case FILL_RECTANGLE:
+        return "Filled rectangles";
+    case DRAW_POINT:
+        return "Points";
+    case DRAW_LINE:
+        return "Lines";
+    case DRAW_TEXTURE:
+        return "Textures";
+    case DRAW_TEXT:
+        return "Texts";
+    case DRAW_TRANSFORM:
+        return "Transforms";
+    case TEXTURE_SWITCHES:
+        return "Texture switches";
+    case STATE_CHANGES:
+        return "State changes";
+    case PIXELS_FILLED:
+        return "Pixels filled";
+    case TEXT_RASTERIZED:
+        return "Texts rasterized";
+    case PRIMITIVES_BATCHED:
+        return "Primitives batched";
+    case ENTITIES_DRAWN:
+        return "Entities drawn";
+    case ENTITIES_CULLED:
+        return "Entities culled";
+    case PARTICLES_DRAWN:
+        return "Particles drawn";
+    default:
+        return "Unknown";
+    }
+}
\ No newline at end of file
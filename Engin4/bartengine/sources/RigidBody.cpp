@@ -33,6 +33,12 @@ bart::RigidBody::RigidBody(Entity* aParent)
     m_ParentObject = aParent;
 }
 
+bart::RigidBody::~RigidBody()
+{
+    // The transform may be deleted with the body still in the world
+    Engine::Instance().GetBodySync().Unbind(m_bodyId);
+}
+
 void bart::RigidBody::Create(Transform* aTransform)
 {
     Create(DYNAMIC_BODY, RECTANGLE_SHAPE, aTransform);
@@ -54,11 +60,12 @@ void bart::RigidBody::Create(const EBodyType aBody, const EShapeType aShape, Tra
     tPhysicMaterial.PosY = aTransform->Y;
     tPhysicMaterial.BodyUserData = m_ParentObject;
     Create(tPhysicMaterial);
+    Engine::Instance().GetBodySync().Bind(m_bodyId, aTransform);
 }
 
-void bart::RigidBody::Update(Transform* aTransform, float /*aDelta*/)
+void bart::RigidBody::Update(Transform* /*aTransform*/, float /*aDelta*/)
 {
-    Engine::Instance().GetPhysic().GetTransform(m_bodyId, &aTransform->X, &aTransform->Y, &aTransform->Angle);
+    // The engine copies the pose to draw to the transform given to Create, all the bodies at once
 }
 
 void bart::RigidBody::SetTransform(Transform* aTransform) const
@@ -148,5 +155,6 @@ void bart::RigidBody::SetRestitution(const float aRestitution) const
 
 void bart::RigidBody::Clean() const
 {
+    Engine::Instance().GetBodySync().Unbind(m_bodyId);
     Engine::Instance().GetPhysic().DestroyBody(m_bodyId);
 }
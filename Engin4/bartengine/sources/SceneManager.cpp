@@ -27,6 +27,7 @@
 
 #include <SceneManager.h>
 #include <Engine.h>
+#include <Config.h>
 
 bool bart::SceneManager::Initialize()
 {
@@ -107,7 +108,12 @@ void bart::SceneManager::LoadNextScene()
     {
         m_World.Unload(false);
 
-        Engine::Instance().GetGraphic().SetCamera(nullptr);
+        IGraphic& tGraphic = Engine::Instance().GetGraphic();
+        tGraphic.SetCamera(nullptr);
+
+        // Each scene can pack its images in atlas pages before its entities load their textures
+        tGraphic.UnloadAtlas();
+        tGraphic.LoadAtlas(ATLAS_FOLDER + m_StateName + ".xml");
 
         m_NextState->Load();
         m_NextState = nullptr;
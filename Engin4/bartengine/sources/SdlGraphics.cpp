@@ -33,6 +33,20 @@
 #include <Camera.h>
 #include <iostream>
 #include <SDL_FontCache.h>
+#include <AtlasPacker.h>
+#include <tinyxml2.h>
+#include <algorithm>
+
+using namespace tinyxml2;
+
+// The batches hand the engine types to SDL as they are
+static_assert(sizeof(bart::Point) == sizeof(SDL_Point), "Point must have the layout of SDL_Point");
+static_assert(sizeof(bart::Rectangle) == sizeof(SDL_Rect), "Rectangle must have the layout of SDL_Rect");
+static_assert(sizeof(SDL_FRect) == sizeof(float) * 4, "SDL_FRect must be four floats");
+
+const int bart::SdlGraphics::ATLAS_PAGE_SIZE = 2048;
+const int bart::SdlGraphics::ATLAS_PADDING = 2;
+const unsigned int bart::SdlGraphics::TEXT_CACHE_LIFETIME = 120;
 
 bool bart::SdlGraphics::Initialize()
 {
@@ -61,19 +75,10 @@ bool bart::SdlGraphics::Initialize()
 
 void bart::SdlGraphics::Clean()
 {
-    if (m_FontBuffer[0] != nullptr)
-    {
-        SDL_DestroyTexture(m_FontBuffer[0]);
-        m_FontBuffer[0] = nullptr;
-    }
-
-    if (m_FontBuffer[1] != nullptr)
-    {
-        SDL_DestroyTexture(m_FontBuffer[1]);
-        m_FontBuffer[1] = nullptr;
-    }
-
-    m_FontBuffer.clear();
+    EvictCachedText(true, 0);
+    ShowOverdraw(false);
+    m_Circles.Clear();
+    m_Outlines.clear();
 
     SDL_DestroyRenderer(m_Renderer);
     SDL_DestroyWindow(m_Window);
@@ -82,19 +87,40 @@ void bart::SdlGraphics::Clean()
     m_Window = nullptr;
 
     for (TTexMap::iterator it = m_TexCache.begin(); it != m_TexCache.end(); ++it)
+    {
+        if (it->second->Page == 0)
+        {
+            SDL_DestroyTexture(it->second->Data);
+        }
+
+        delete it->second;
+    }
+
+    for (TTexMap::iterator it = m_AtlasPages.begin(); it != m_AtlasPages.end(); ++it)
     {
         SDL_DestroyTexture(it->second->Data);
         delete it->second;
     }
 
-    //for (TFontMap::iterator it = m_FntCache.begin(); it != m_FntCache.end(); ++it)
-    //{
-    //    TTF_CloseFont(it->second->Data);
-    //    delete it->second;
-    //}
+    m_AtlasPages.clear();
+    m_AtlasRegions.clear();
+    m_AtlasOwnedPages.clear();
+    m_OpacityMasks.clear();
+
+    for (TFontMap::iterator it = m_FntCache.begin(); it != m_FntCache.end(); ++it)
+    {
+        delete it->second;
+    }
+
+    for (TFaceMap::iterator it = m_FaceCache.begin(); it != m_FaceCache.end(); ++it)
+    {
+        FC_FreeFont(it->second->Data);
+        delete it->second;
+    }
 
     m_TexCache.clear();
     m_FntCache.clear();
+    m_FaceCache.clear();
 
     /*TTF_Quit();*/
     SDL_Quit();
@@ -140,11 +166,59 @@ void bart::SdlGraphics::Clear()
     SDL_RenderClear(m_Renderer);
 
     SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 255);
+    m_DrawColor.Set(0, 0, 0, 255);
+    m_Stats.Add(PIXELS_FILLED, static_cast<unsigned long long>(m_ScreenWidth) * m_ScreenHeight);
+}
+
+void bart::SdlGraphics::Clear(const Color& aColor)
+{
+    SDL_SetRenderDrawColor(m_Renderer, aColor.R, aColor.G, aColor.B, aColor.A);
+    SDL_RenderClear(m_Renderer);
+
+    SDL_SetRenderDrawColor(m_Renderer, m_DrawColor.R, m_DrawColor.G, m_DrawColor.B, m_DrawColor.A);
+}
+
+void bart::SdlGraphics::Clear(const Color& aColor, const Rectangle& aRegion)
+{
+    const SDL_Rect tRect = {aRegion.X, aRegion.Y, aRegion.W, aRegion.H};
+
+    // A fill without blending writes the alpha too, transparent clears included
+    SDL_SetRenderDrawBlendMode(m_Renderer, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(m_Renderer, aColor.R, aColor.G, aColor.B, aColor.A);
+    SDL_RenderFillRect(m_Renderer, &tRect);
+
+    SDL_SetRenderDrawBlendMode(m_Renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(m_Renderer, m_DrawColor.R, m_DrawColor.G, m_DrawColor.B, m_DrawColor.A);
+    CountPixels(aRegion.X, aRegion.Y, aRegion.W, aRegion.H);
 }
 
 void bart::SdlGraphics::Present()
 {
+    DrawOutlines();
+
+    if (m_Overdraw.IsEnabled())
+    {
+        m_Overdraw.EndFrame();
+        DrawOverdraw();
+        m_Overdraw.Resize(static_cast<int>(static_cast<float>(m_ScreenWidth) / m_ScaleX),
+                          static_cast<int>(static_cast<float>(m_ScreenHeight) / m_ScaleY));
+    }
+
+    if (m_StatsFont != 0)
+    {
+        DrawRenderStats();
+    }
+
     SDL_RenderPresent(m_Renderer);
+
+    m_Stats.NextFrame();
+    m_LastTexture = nullptr;
+
+    m_FrameCount++;
+    if (m_FrameCount % TEXT_CACHE_LIFETIME == 0)
+    {
+        EvictCachedText(false, 0);
+    }
 }
 
 void bart::SdlGraphics::SetColor(const unsigned char aRed,
@@ -152,6 +226,12 @@ void bart::SdlGraphics::SetColor(const unsigned char aRed,
                                  const unsigned char aBlue,
                                  const unsigned char aAlpha)
 {
+    if (m_DrawColor.R != aRed || m_DrawColor.G != aGreen || m_DrawColor.B != aBlue || m_DrawColor.A != aAlpha)
+    {
+        m_Stats.Add(STATE_CHANGES);
+        m_DrawColor.Set(aRed, aGreen, aBlue, aAlpha);
+    }
+
     SDL_SetRenderDrawColor(m_Renderer, aRed, aGreen, aBlue, aAlpha);
 }
 
@@ -170,18 +250,48 @@ size_t bart::SdlGraphics::LoadTexture(const string& aFilename)
         return tHashKey;
     }
 
+    TRegionMap::iterator tRegion = m_AtlasRegions.find(tHashKey);
+    if (tRegion != m_AtlasRegions.end())
+    {
+        // The image was packed in an atlas page, the texture is a view in that page
+        TextureInfo* tPage = m_AtlasPages[tRegion->second.Page];
+        tPage->Count++;
+
+        TextureInfo* tInfo = new TextureInfo();
+        tInfo->Data = tPage->Data;
+        tInfo->Count = 1;
+        tInfo->Page = tRegion->second.Page;
+        tInfo->OffsetX = tRegion->second.Bounds.X;
+        tInfo->OffsetY = tRegion->second.Bounds.Y;
+        tInfo->Width = tRegion->second.Bounds.W;
+        tInfo->Height = tRegion->second.Bounds.H;
+        m_TexCache[tHashKey] = tInfo;
+        return tHashKey;
+    }
+
     SDL_Surface* tSurface = IMG_Load(aFilename.c_str());
     if (tSurface != nullptr)
     {
         SDL_Texture* tTex = nullptr;
         tTex = SDL_CreateTextureFromSurface(m_Renderer, tSurface);
+        const int tWidth = tSurface->w;
+        const int tHeight = tSurface->h;
+
+        if (tTex != nullptr)
+        {
+            BuildOpacityMask(tTex, tSurface);
+        }
+
         SDL_FreeSurface(tSurface);
 
         if (tTex != nullptr)
         {
-            m_TexCache[tHashKey] = new Resource<SDL_Texture>();
-            m_TexCache[tHashKey]->Data = tTex;
-            m_TexCache[tHashKey]->Count = 1;
+            TextureInfo* tInfo = new TextureInfo();
+            tInfo->Data = tTex;
+            tInfo->Count = 1;
+            tInfo->Width = tWidth;
+            tInfo->Height = tHeight;
+            m_TexCache[tHashKey] = tInfo;
             return tHashKey;
         }
     }
@@ -194,11 +304,20 @@ void bart::SdlGraphics::UnloadTexture(size_t aTextureId)
 {
     if (m_TexCache.count(aTextureId) > 0)
     {
-        m_TexCache[aTextureId]->Count--;
-        if (m_TexCache[aTextureId]->Count <= 0)
+        TextureInfo* tInfo = m_TexCache[aTextureId];
+        tInfo->Count--;
+        if (tInfo->Count <= 0)
         {
-            SDL_DestroyTexture(m_TexCache[aTextureId]->Data);
-            delete m_TexCache[aTextureId];
+            if (tInfo->Page != 0)
+            {
+                ReleasePage(tInfo->Page);
+            }
+            else
+            {
+                DestroyTexture(tInfo->Data);
+            }
+
+            delete tInfo;
             m_TexCache.erase(aTextureId);
         }
     }
@@ -218,22 +337,35 @@ size_t bart::SdlGraphics::LoadFont(const string& aFilename, int aFontSize, const
         return tHashKey;
     }
 
-    //TTF_Font* tFont = TTF_OpenFont(aFilename.c_str(), aFontSize * 2);
-
-    FC_Font* tFont = FC_CreateFont();
-    FC_LoadFont(
-        tFont, m_Renderer, aFilename.c_str(), aFontSize * 2, FC_MakeColor(aColor.R, aColor.G, aColor.B, aColor.A),
-        TTF_STYLE_NORMAL);
+    // The glyphs are rasterized once per file and size in white, the color is applied when drawing
+    const size_t tFaceKey = std::hash<std::string>()(aFilename + "_" + std::to_string(aFontSize));
 
-    if (tFont != nullptr)
+    if (m_FaceCache.count(tFaceKey) > 0)
     {
-        m_FntCache[tHashKey] = new Resource<FC_Font>();
-        m_FntCache[tHashKey]->Data = tFont;
-        m_FntCache[tHashKey]->Count = 1;
-        return tHashKey;
+        m_FaceCache[tFaceKey]->Count++;
+    }
+    else
+    {
+        FC_Font* tFont = FC_CreateFont();
+        if (FC_LoadFont(tFont, m_Renderer, aFilename.c_str(), aFontSize * 2, FC_MakeColor(255, 255, 255, 255), TTF_STYLE_NORMAL) == 0)
+        {
+            Engine::Instance().GetLogger().Log("Cannot load font: %s\n", aFilename.c_str());
+            FC_FreeFont(tFont);
+            return 0;
+        }
+
+        m_FaceCache[tFaceKey] = new Resource<FC_Font>();
+        m_FaceCache[tFaceKey]->Data = tFont;
+        m_FaceCache[tFaceKey]->Count = 1;
     }
 
-    return 0;
+    FontInfo* tInfo = new FontInfo();
+    tInfo->Data = m_FaceCache[tFaceKey]->Data;
+    tInfo->Count = 1;
+    tInfo->Face = tFaceKey;
+    tInfo->Tint = aColor;
+    m_FntCache[tHashKey] = tInfo;
+    return tHashKey;
 }
 
 void bart::SdlGraphics::UnloadFont(size_t aFontId)
@@ -243,9 +375,18 @@ void bart::SdlGraphics::UnloadFont(size_t aFontId)
         m_FntCache[aFontId]->Count--;
         if (m_FntCache[aFontId]->Count <= 0)
         {
-            FC_FreeFont(m_FntCache[aFontId]->Data);
+            const size_t tFaceKey = m_FntCache[aFontId]->Face;
             delete m_FntCache[aFontId];
             m_FntCache.erase(aFontId);
+
+            m_FaceCache[tFaceKey]->Count--;
+            if (m_FaceCache[tFaceKey]->Count <= 0)
+            {
+                EvictCachedText(false, tFaceKey);
+                FC_FreeFont(m_FaceCache[tFaceKey]->Data);
+                delete m_FaceCache[tFaceKey];
+                m_FaceCache.erase(tFaceKey);
+            }
         }
     }
 }
@@ -268,6 +409,8 @@ void bart::SdlGraphics::Draw(const int aX, const int aY, const int aWidth, const
     }
 
     SDL_RenderDrawRect(m_Renderer, &tRect);
+    m_Stats.Add(DRAW_RECTANGLE);
+    m_Stats.Add(PIXELS_FILLED, 2ULL * (aWidth > 0 ? aWidth : 0) + 2ULL * (aHeight > 0 ? aHeight : 0));
 }
 
 void bart::SdlGraphics::Draw(const Circle& aCircle)
@@ -280,71 +423,159 @@ void bart::SdlGraphics::Draw(const Circle& aCircle)
 
 void bart::SdlGraphics::Draw(const int aX, const int aY, const float aRadius)
 {
-    float tError = -aRadius;
-    float tX = aRadius - 0.5f;
-    float tY = 0.5f;
-    float tCx = aX - 0.5f;
-    float tCy = aY - 0.5f;
+    const Circle tCircle(aX, aY, aRadius);
+    DrawCircles(&tCircle, 1);
+}
+
+void bart::SdlGraphics::Draw(const Point& aPoint)
+{
+    Draw(aPoint.X, aPoint.Y);
+}
+
+void bart::SdlGraphics::Draw(const int aX, const int aY)
+{
+    int tX = aX;
+    int tY = aY;
 
     if (m_Camera != nullptr)
     {
-        tCx = aX - m_Camera->GetX() - 0.5f;
-        tCy = aY - m_Camera->GetY() - 0.5f;
+        tX -= m_Camera->GetX();
+        tY -= m_Camera->GetY();
     }
 
-    while (tX >= tY)
+    SDL_RenderDrawPoint(m_Renderer, tX, tY);
+    CountDraw(DRAW_POINT, tX, tY, 1, 1);
+}
+
+void bart::SdlGraphics::DrawRects(const Rectangle* aRects, const size_t aCount)
+{
+    if (aCount == 0)
     {
-        Draw(static_cast<int>(tCx + tX), static_cast<int>(tCy + tY));
-        Draw(static_cast<int>(tCx + tY), static_cast<int>(tCy + tX));
+        return;
+    }
 
-        if (tX != 0)
-        {
-            Draw(static_cast<int>(tCx - tX), static_cast<int>(tCy + tY));
-            Draw(static_cast<int>(tCx + tY), static_cast<int>(tCy - tX));
-        }
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+    unsigned long long tPixels = 0;
 
-        if (tY != 0)
-        {
-            Draw(static_cast<int>(tCx + tX), static_cast<int>(tCy - tY));
-            Draw(static_cast<int>(tCx - tY), static_cast<int>(tCy + tX));
-        }
+    m_RectBatch.assign(aRects, aRects + aCount);
+    for (Rectangle& tRect : m_RectBatch)
+    {
+        tRect.X -= tOffsetX;
+        tRect.Y -= tOffsetY;
+        tPixels += 2ULL * (tRect.W > 0 ? tRect.W : 0) + 2ULL * (tRect.H > 0 ? tRect.H : 0);
+    }
 
-        if (tX != 0 && tY != 0)
-        {
-            Draw(static_cast<int>(tCx - tX), static_cast<int>(tCy - tY));
-            Draw(static_cast<int>(tCx - tY), static_cast<int>(tCy - tX));
-        }
+    SDL_RenderDrawRects(m_Renderer, reinterpret_cast<const SDL_Rect*>(m_RectBatch.data()), static_cast<int>(aCount));
+    m_Stats.Add(DRAW_RECTANGLE);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount);
+    m_Stats.Add(PIXELS_FILLED, tPixels);
+}
 
-        tError += tY;
-        ++tY;
-        tError += tY;
+void bart::SdlGraphics::FillRects(const Rectangle* aRects, const size_t aCount)
+{
+    if (aCount == 0)
+    {
+        return;
+    }
 
-        if (tError >= 0)
-        {
-            --tX;
-            tError -= tX;
-            tError -= tX;
-        }
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+
+    m_RectBatch.assign(aRects, aRects + aCount);
+    for (Rectangle& tRect : m_RectBatch)
+    {
+        tRect.X -= tOffsetX;
+        tRect.Y -= tOffsetY;
+        CountPixels(tRect.X, tRect.Y, tRect.W, tRect.H);
     }
+
+    SDL_RenderFillRects(m_Renderer, reinterpret_cast<const SDL_Rect*>(m_RectBatch.data()), static_cast<int>(aCount));
+    m_Stats.Add(FILL_RECTANGLE);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount);
 }
 
-void bart::SdlGraphics::Draw(const Point& aPoint)
+void bart::SdlGraphics::DrawPoints(const Point* aPoints, const size_t aCount)
 {
-    Draw(aPoint.X, aPoint.Y);
+    if (aCount == 0)
+    {
+        return;
+    }
+
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+
+    m_PointBatch.assign(aPoints, aPoints + aCount);
+    for (Point& tPoint : m_PointBatch)
+    {
+        tPoint.X -= tOffsetX;
+        tPoint.Y -= tOffsetY;
+        CountPixels(tPoint.X, tPoint.Y, 1, 1);
+    }
+
+    SDL_RenderDrawPoints(m_Renderer, reinterpret_cast<const SDL_Point*>(m_PointBatch.data()), static_cast<int>(aCount));
+    m_Stats.Add(DRAW_POINT);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount);
 }
 
-void bart::SdlGraphics::Draw(const int aX, const int aY)
+void bart::SdlGraphics::DrawLines(const Point* aPoints, const size_t aCount)
 {
-    int tX = aX;
-    int tY = aY;
+    if (aCount < 2)
+    {
+        return;
+    }
 
-    if (m_Camera != nullptr)
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+    unsigned long long tPixels = 0;
+
+    m_PointBatch.assign(aPoints, aPoints + aCount);
+    for (size_t i = 0; i < aCount; i++)
     {
-        tX -= m_Camera->GetX();
-        tY -= m_Camera->GetY();
+        m_PointBatch[i].X -= tOffsetX;
+        m_PointBatch[i].Y -= tOffsetY;
+
+        if (i > 0)
+        {
+            const int tDx = std::abs(m_PointBatch[i].X - m_PointBatch[i - 1].X);
+            const int tDy = std::abs(m_PointBatch[i].Y - m_PointBatch[i - 1].Y);
+            tPixels += static_cast<unsigned long long>(std::max(tDx, tDy));
+        }
     }
 
-    SDL_RenderDrawPoint(m_Renderer, tX, tY);
+    SDL_RenderDrawLines(m_Renderer, reinterpret_cast<const SDL_Point*>(m_PointBatch.data()), static_cast<int>(aCount));
+    m_Stats.Add(DRAW_LINE);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount - 1);
+    m_Stats.Add(PIXELS_FILLED, tPixels + 1);
+}
+
+void bart::SdlGraphics::DrawCircles(const Circle* aCircles, const size_t aCount)
+{
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+
+    // Every outline pixel of every circle goes in a single point batch
+    m_PointBatch.clear();
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const int tCx = aCircles[i].X - tOffsetX;
+        const int tCy = aCircles[i].Y - tOffsetY;
+
+        for (const Point& tOffset : m_Circles.GetOutline(aCircles[i].R))
+        {
+            Point tPoint;
+            tPoint.Set(tCx + tOffset.X, tCy + tOffset.Y);
+            m_PointBatch.push_back(tPoint);
+            CountPixels(tPoint.X, tPoint.Y, 1, 1);
+        }
+    }
+
+    if (!m_PointBatch.empty())
+    {
+        SDL_RenderDrawPoints(m_Renderer, reinterpret_cast<const SDL_Point*>(m_PointBatch.data()), static_cast<int>(m_PointBatch.size()));
+        m_Stats.Add(DRAW_POINT);
+        m_Stats.Add(PRIMITIVES_BATCHED, aCount);
+    }
 }
 
 void bart::SdlGraphics::Draw(size_t aTexture,
@@ -374,7 +605,10 @@ void bart::SdlGraphics::Draw(size_t aTexture,
 
         const SDL_RendererFlip tFlip = static_cast<SDL_RendererFlip>(tFlipValue);
 
-        SDL_Texture* tTex = m_TexCache[aTexture]->Data;
+        const TextureInfo* tInfo = m_TexCache[aTexture];
+        SDL_Texture* tTex = tInfo->Data;
+        tSrcRect.x += tInfo->OffsetX;
+        tSrcRect.y += tInfo->OffsetY;
 
         if (m_Camera != nullptr)
         {
@@ -382,17 +616,93 @@ void bart::SdlGraphics::Draw(size_t aTexture,
             tDstRect.y -= m_Camera->GetY();
         }
 
-        SDL_SetTextureBlendMode(tTex, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureBlendMode(tTex, m_Blending || aAlpha != 255 ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
         SDL_SetTextureAlphaMod(tTex, aAlpha);
         SDL_SetTextureColorMod(tTex, 255, 255, 255);
         SDL_RenderCopyEx(m_Renderer, tTex, &tSrcRect, &tDstRect, aAngle, nullptr, tFlip);
+
+        CountTexture(tTex);
+        CountDraw(DRAW_TEXTURE, tDstRect.x, tDstRect.y, tDstRect.w, tDstRect.h);
+    }
+}
+
+void bart::SdlGraphics::DrawSprites(const size_t aTexture, const Rectangle& aSrc, const Rectangle* aDst, const Color* aTints,
+                                    const size_t aCount)
+{
+    const TTexMap::const_iterator tItr = m_TexCache.find(aTexture);
+    if (aCount == 0 || tItr == m_TexCache.end())
+    {
+        return;
+    }
+
+    const TextureInfo* tInfo = tItr->second;
+    SDL_Texture* tTex = tInfo->Data;
+    const SDL_Rect tSrcRect = {aSrc.X + tInfo->OffsetX, aSrc.Y + tInfo->OffsetY, aSrc.W, aSrc.H};
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+
+    // SDL batches the copies of a texture, only the modulation changes between them
+    SDL_SetTextureBlendMode(tTex, SDL_BLENDMODE_BLEND);
+    Color tTint = aTints[0];
+    SDL_SetTextureColorMod(tTex, tTint.R, tTint.G, tTint.B);
+    SDL_SetTextureAlphaMod(tTex, tTint.A);
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const Color& tColor = aTints[i];
+        if (tColor.R != tTint.R || tColor.G != tTint.G || tColor.B != tTint.B)
+        {
+            SDL_SetTextureColorMod(tTex, tColor.R, tColor.G, tColor.B);
+        }
+
+        if (tColor.A != tTint.A)
+        {
+            SDL_SetTextureAlphaMod(tTex, tColor.A);
+        }
+
+        tTint = tColor;
+
+        const SDL_Rect tDstRect = {aDst[i].X - tOffsetX, aDst[i].Y - tOffsetY, aDst[i].W, aDst[i].H};
+        SDL_RenderCopy(m_Renderer, tTex, &tSrcRect, &tDstRect);
+        CountPixels(tDstRect.x, tDstRect.y, tDstRect.w, tDstRect.h);
+    }
+
+    CountTexture(tTex);
+    m_Stats.Add(DRAW_TEXTURE);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount);
+}
+
+void bart::SdlGraphics::Draw(const size_t aFont, const std::string& aText, const int aX, const int aY)
+{
+    if (m_FntCache.count(aFont) > 0)
+    {
+        DrawString(aFont, aText, aX, aY, 0, m_FntCache[aFont]->Tint);
+    }
+}
+
+void bart::SdlGraphics::Draw(const size_t aFont, const std::string& aText, const int aX, const int aY, const int aWrapWidth)
+{
+    if (m_FntCache.count(aFont) > 0)
+    {
+        DrawString(aFont, aText, aX, aY, aWrapWidth, m_FntCache[aFont]->Tint);
     }
 }
 
-void bart::SdlGraphics::Draw(size_t aFont, const std::string& aText, int aX, int aY)
+void bart::SdlGraphics::Draw(const size_t aFont, const std::string& aText, const int aX, const int aY, const Color& aColor)
 {
-    FC_Font* tFont = m_FntCache[aFont]->Data;
+    if (m_FntCache.count(aFont) > 0)
+    {
+        DrawString(aFont, aText, aX, aY, 0, aColor);
+    }
+}
 
+void bart::SdlGraphics::DrawString(const size_t aFont,
+                                   const string& aText,
+                                   const int aX,
+                                   const int aY,
+                                   const int aWrapWidth,
+                                   const Color& aColor)
+{
     int tX = aX;
     int tY = aY;
 
@@ -402,15 +712,47 @@ void bart::SdlGraphics::Draw(size_t aFont, const std::string& aText, int aX, int
         tY -= m_Camera->GetY();
     }
 
-    FC_Draw(tFont, m_Renderer, static_cast<float>(tX), static_cast<float>(tY), aText.c_str());
+    CachedText* tText = GetCachedText(m_FntCache[aFont]->Face, aText, aWrapWidth);
+
+    if (tText == nullptr)
+    {
+        // No render target on this renderer, lay out the string every frame
+        FC_Font* tFont = m_FntCache[aFont]->Data;
+        const SDL_Color tColor = {aColor.R, aColor.G, aColor.B, aColor.A};
+
+        FC_Rect tBounds;
+        if (aWrapWidth > 0)
+        {
+            tBounds = FC_DrawColumnColor(tFont, m_Renderer, static_cast<float>(tX), static_cast<float>(tY), static_cast<Uint16>(aWrapWidth), tColor, "%s", aText.c_str());
+        }
+        else
+        {
+            tBounds = FC_DrawColor(tFont, m_Renderer, static_cast<float>(tX), static_cast<float>(tY), tColor, "%s", aText.c_str());
+        }
+
+        // Every glyph is its own copy from the glyph cache
+        m_LastTexture = nullptr;
+        m_Stats.Add(TEXTURE_SWITCHES);
+        CountDraw(DRAW_TEXT, tBounds.x, tBounds.y, tBounds.w, tBounds.h);
+    }
+    else if (tText->Texture != nullptr)
+    {
+        const SDL_Rect tDstRect = {tX, tY, tText->Width, tText->Height};
+        SDL_SetTextureColorMod(tText->Texture, aColor.R, aColor.G, aColor.B);
+        SDL_SetTextureAlphaMod(tText->Texture, aColor.A);
+        SDL_RenderCopy(m_Renderer, tText->Texture, nullptr, &tDstRect);
+
+        CountTexture(tText->Texture);
+        CountDraw(DRAW_TEXT, tDstRect.x, tDstRect.y, tDstRect.w, tDstRect.h);
+    }
 }
 
 void bart::SdlGraphics::GetTextureSize(size_t aTextureId, int* aWidth, int* aHeight)
 {
     if (m_TexCache.count(aTextureId) > 0)
     {
-        SDL_Texture* tTexture = m_TexCache[aTextureId]->Data;
-        SDL_QueryTexture(tTexture, nullptr, nullptr, aWidth, aHeight);
+        *aWidth = m_TexCache[aTextureId]->Width;
+        *aHeight = m_TexCache[aTextureId]->Height;
     }
     else
     {
@@ -419,14 +761,77 @@ void bart::SdlGraphics::GetTextureSize(size_t aTextureId, int* aWidth, int* aHei
     }
 }
 
+bool bart::SdlGraphics::IsRegionOpaque(const size_t aTextureId, const Rectangle& aRegion)
+{
+    TTexMap::iterator tItr = m_TexCache.find(aTextureId);
+    if (tItr == m_TexCache.end())
+    {
+        return false;
+    }
+
+    TMaskMap::iterator tMask = m_OpacityMasks.find(tItr->second->Data);
+    if (tMask == m_OpacityMasks.end())
+    {
+        return false;
+    }
+
+    const OpacityMask& tOpacity = tMask->second;
+    const int tLeft = aRegion.X + tItr->second->OffsetX;
+    const int tTop = aRegion.Y + tItr->second->OffsetY;
+
+    if (aRegion.W <= 0 || aRegion.H <= 0 || tLeft < 0 || tTop < 0 || tLeft + aRegion.W > tOpacity.Width ||
+        tTop + aRegion.H > tOpacity.Height)
+    {
+        return false;
+    }
+
+    if (tOpacity.AllOpaque)
+    {
+        return true;
+    }
+
+    for (int y = tTop; y < tTop + aRegion.H; y++)
+    {
+        for (int x = tLeft; x < tLeft + aRegion.W; x++)
+        {
+            const int tBit = y * tOpacity.Width + x;
+            if ((tOpacity.Bits[tBit >> 3] & (1 << (tBit & 7))) == 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void bart::SdlGraphics::SetBlending(const bool aEnabled)
+{
+    if (m_Blending != aEnabled)
+    {
+        m_Blending = aEnabled;
+        m_Stats.Add(STATE_CHANGES);
+    }
+}
+
 void bart::SdlGraphics::GetFontSize(size_t aFontId, const string& aText, int* aWidth, int* aHeight)
 {
     if (m_FntCache.count(aFontId) > 0)
     {
-        const FC_Scale tScale = {1.0f, 1.0f};
-        const SDL_Rect tBounds = FC_GetBounds(m_FntCache[aFontId]->Data, 0, 0, FC_ALIGN_LEFT, tScale, aText.c_str());
-        *aWidth = tBounds.w;
-        *aHeight = tBounds.h;
+        const CachedText* tText = GetCachedText(m_FntCache[aFontId]->Face, aText, 0);
+
+        if (tText != nullptr)
+        {
+            *aWidth = tText->Width;
+            *aHeight = tText->Height;
+        }
+        else
+        {
+            const FC_Scale tScale = {1.0f, 1.0f};
+            const SDL_Rect tBounds = FC_GetBounds(m_FntCache[aFontId]->Data, 0, 0, FC_ALIGN_LEFT, tScale, "%s", aText.c_str());
+            *aWidth = tBounds.w;
+            *aHeight = tBounds.h;
+        }
     }
     else
     {
@@ -463,6 +868,11 @@ void bart::SdlGraphics::SetCamera(Camera* aCamera)
     m_Camera = aCamera;
 }
 
+bart::Camera* bart::SdlGraphics::GetCamera() const
+{
+    return m_Camera;
+}
+
 void bart::SdlGraphics::Fill(const Rectangle& aRect)
 {
     int x, y, w, h;
@@ -481,44 +891,807 @@ void bart::SdlGraphics::Fill(int aX, int aY, int aWidth, int aHeight)
     }
 
     SDL_RenderFillRect(m_Renderer, &tRect);
+    CountDraw(FILL_RECTANGLE, tRect.x, tRect.y, tRect.w, tRect.h);
 }
 
 void bart::SdlGraphics::SetViewport(const int aX, const int aY, const int aWidth, const int aHeight)
 {
+    DrawOutlines();
+
     SDL_Rect tViewPortRect = {aX, aY, aWidth, aHeight};
     SDL_RenderSetViewport(m_Renderer, &tViewPortRect);
+    m_Stats.Add(STATE_CHANGES);
 }
 
 void bart::SdlGraphics::ScaleViewport(const float aX, const float aY)
 {
+    DrawOutlines();
+
     SDL_RenderSetScale(m_Renderer, aX, aY);
+    m_Stats.Add(STATE_CHANGES);
+
+    // SDL keeps the scale of the window aside while a target is bound and restores it when the target is unbound,
+    // the scale of a target is lost on any switch so it is kept with the target
+    if (m_RenderTarget != 0)
+    {
+        TextureInfo* tInfo = m_TexCache[m_RenderTarget];
+        tInfo->ScaleX = aX;
+        tInfo->ScaleY = aY;
+        return;
+    }
+
+    m_ScaleX = aX;
+    m_ScaleY = aY;
 }
 
-void bart::SdlGraphics::SetWindowState(const EWindowState aState)
+void bart::SdlGraphics::GetViewportScale(float* aX, float* aY)
 {
-    switch (aState)
+    *aX = m_ScaleX;
+    *aY = m_ScaleY;
+}
+
+size_t bart::SdlGraphics::CreateRenderTarget(const int aWidth, const int aHeight)
+{
+    if (!SDL_RenderTargetSupported(m_Renderer))
     {
-    case BORDERLESS:
-        SDL_SetWindowFullscreen(m_Window, SDL_WINDOW_FULLSCREEN_DESKTOP);
-        break;
-    case FULLSCREEN:
-        SDL_SetWindowFullscreen(m_Window, SDL_WINDOW_FULLSCREEN);
-        break;
+        return 0;
+    }
 
-    default:
-        SDL_SetWindowFullscreen(m_Window, 0);
+    SDL_Texture* tTex = SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, aWidth, aHeight);
+    if (tTex == nullptr)
+    {
+        Engine::Instance().GetLogger().Log("Cannot create render target: %s\n", SDL_GetError());
+        return 0;
     }
+
+    SDL_SetTextureBlendMode(tTex, SDL_BLENDMODE_BLEND);
+
+    // Render targets are not files, they get a name of their own in the texture cache
+    m_TargetCount++;
+    const size_t tHashKey = std::hash<std::string>()("RenderTarget_" + std::to_string(m_TargetCount));
+
+    TextureInfo* tInfo = new TextureInfo();
+    tInfo->Data = tTex;
+    tInfo->Count = 1;
+    tInfo->Width = aWidth;
+    tInfo->Height = aHeight;
+    m_TexCache[tHashKey] = tInfo;
+
+    // The content of a new target is undefined
+    SDL_Texture* tPrevious = SDL_GetRenderTarget(m_Renderer);
+    SDL_SetRenderTarget(m_Renderer, tTex);
+    Clear(Color(0, 0, 0, 0));
+    SDL_SetRenderTarget(m_Renderer, tPrevious);
+    ApplyTargetScale();
+
+    return tHashKey;
 }
 
-void bart::SdlGraphics::Draw(Transform* transform)
+bool bart::SdlGraphics::SetRenderTarget(const size_t aTarget)
 {
-    SDL_FRect tRect = {transform->X, transform->Y, transform->Width, transform->Height};
+    SDL_Texture* tTex = nullptr;
 
-    if (m_Camera != nullptr)
+    if (aTarget != 0)
     {
-        tRect.x -= static_cast<float>(m_Camera->GetX());
-        tRect.y -= static_cast<float>(m_Camera->GetY());
+        TTexMap::iterator tItr = m_TexCache.find(aTarget);
+        if (tItr == m_TexCache.end() || tItr->second->Page != 0)
+        {
+            return false;
+        }
+
+        tTex = tItr->second->Data;
     }
 
-    SDL_RenderDrawRectF(m_Renderer, &tRect);
+    if (SDL_SetRenderTarget(m_Renderer, tTex) != 0)
+    {
+        Engine::Instance().GetLogger().Log("Cannot set render target: %s\n", SDL_GetError());
+        return false;
+    }
+
+    m_RenderTarget = aTarget;
+    m_LastTexture = nullptr;
+    ApplyTargetScale();
+    m_Stats.Add(STATE_CHANGES);
+    return true;
+}
+
+void bart::SdlGraphics::ApplyTargetScale() const
+{
+    // SDL binds a texture at a scale of 1, the window gets its own scale back by itself
+    if (m_RenderTarget == 0)
+    {
+        return;
+    }
+
+    const TTexMap::const_iterator tItr = m_TexCache.find(m_RenderTarget);
+    if (tItr != m_TexCache.end())
+    {
+        SDL_RenderSetScale(m_Renderer, tItr->second->ScaleX, tItr->second->ScaleY);
+    }
+}
+
+size_t bart::SdlGraphics::GetRenderTarget() const
+{
+    return m_RenderTarget;
+}
+
+void bart::SdlGraphics::SetWindowState(const EWindowState aState)
+{
+    switch (aState)
+    {
+    case BORDERLESS:
+        SDL_SetWindowFullscreen(m_Window, SDL_WINDOW_FULLSCREEN_DESKTOP);
+        break;
+    case FULLSCREEN:
+        SDL_SetWindowFullscreen(m_Window, SDL_WINDOW_FULLSCREEN);
+        break;
+
+    default:
+        SDL_SetWindowFullscreen(m_Window, 0);
+    }
+}
+
+void bart::SdlGraphics::Draw(Transform* transform)
+{
+    SDL_FRect tRect = {transform->X, transform->Y, transform->Width, transform->Height};
+
+    if (m_Camera != nullptr)
+    {
+        tRect.x -= static_cast<float>(m_Camera->GetX());
+        tRect.y -= static_cast<float>(m_Camera->GetY());
+    }
+
+    m_Stats.Add(PIXELS_FILLED, static_cast<unsigned long long>(2.0f * (tRect.w + tRect.h)));
+
+    if (m_RenderTarget != 0)
+    {
+        SDL_RenderDrawRectF(m_Renderer, &tRect);
+        m_Stats.Add(DRAW_TRANSFORM);
+        return;
+    }
+
+    // Debug outlines of thousands of bodies, one draw call per color at the end of the frame
+    OutlineBatch* tBatch = nullptr;
+    for (OutlineBatch& tOutlines : m_Outlines)
+    {
+        if (tOutlines.Tint.R == m_DrawColor.R && tOutlines.Tint.G == m_DrawColor.G && tOutlines.Tint.B == m_DrawColor.B &&
+            tOutlines.Tint.A == m_DrawColor.A)
+        {
+            tBatch = &tOutlines;
+            break;
+        }
+    }
+
+    if (tBatch == nullptr)
+    {
+        m_Outlines.push_back(OutlineBatch());
+        tBatch = &m_Outlines.back();
+        tBatch->Tint = m_DrawColor;
+    }
+
+    tBatch->Rects.push_back(tRect.x);
+    tBatch->Rects.push_back(tRect.y);
+    tBatch->Rects.push_back(tRect.w);
+    tBatch->Rects.push_back(tRect.h);
+}
+
+void bart::SdlGraphics::DrawOutlines()
+{
+    if (m_RenderTarget != 0)
+    {
+        return;
+    }
+
+    for (OutlineBatch& tBatch : m_Outlines)
+    {
+        const int tCount = static_cast<int>(tBatch.Rects.size() / 4);
+        if (tCount == 0)
+        {
+            continue;
+        }
+
+        SDL_SetRenderDrawColor(m_Renderer, tBatch.Tint.R, tBatch.Tint.G, tBatch.Tint.B, tBatch.Tint.A);
+        SDL_RenderDrawRectsF(m_Renderer, reinterpret_cast<const SDL_FRect*>(tBatch.Rects.data()), tCount);
+        m_Stats.Add(DRAW_TRANSFORM);
+        m_Stats.Add(PRIMITIVES_BATCHED, static_cast<unsigned long long>(tCount));
+
+        // The color stays in the list, the same outlines come back next frame
+        tBatch.Rects.clear();
+    }
+
+    SDL_SetRenderDrawColor(m_Renderer, m_DrawColor.R, m_DrawColor.G, m_DrawColor.B, m_DrawColor.A);
+}
+
+bool bart::SdlGraphics::LoadAtlas(const string& aManifest)
+{
+    XMLDocument tDocument;
+    if (tDocument.LoadFile(aManifest.c_str()) != XML_SUCCESS)
+    {
+        // Atlases are optional, a scene without manifest uses its textures as is
+        return false;
+    }
+
+    XMLElement* tAtlasElement = tDocument.FirstChildElement("atlas");
+    if (tAtlasElement == nullptr)
+    {
+        Engine::Instance().GetLogger().Log("Invalid atlas manifest: %s\n", aManifest.c_str());
+        return false;
+    }
+
+    const int tPadding = tAtlasElement->IntAttribute("padding", ATLAS_PADDING);
+
+    vector<string> tFiles;
+    XMLElement* tImageElement = tAtlasElement->FirstChildElement("image");
+    while (tImageElement != nullptr)
+    {
+        const char* tSource = tImageElement->Attribute("source");
+        if (tSource != nullptr)
+        {
+            tFiles.push_back(tSource);
+        }
+
+        tImageElement = tImageElement->NextSiblingElement("image");
+    }
+
+    return BuildAtlas(tFiles, tPadding);
+}
+
+bool bart::SdlGraphics::BuildAtlas(const vector<string>& aFiles, const int aPadding)
+{
+    struct PackedImage
+    {
+        size_t Id;
+        SDL_Surface* Surface;
+        Rectangle Bounds;
+        size_t PageIndex;
+    };
+
+    vector<PackedImage> tImages;
+    for (const string& tFile : aFiles)
+    {
+        const size_t tHashKey = std::hash<std::string>()(tFile);
+
+        if (m_TexCache.count(tHashKey) > 0 || m_AtlasRegions.count(tHashKey) > 0)
+        {
+            // Already loaded on its own or in another atlas, keep it where it is
+            continue;
+        }
+
+        SDL_Surface* tSurface = IMG_Load(tFile.c_str());
+        if (tSurface == nullptr)
+        {
+            Engine::Instance().GetLogger().Log("Cannot load atlas image: %s\n", tFile.c_str());
+            continue;
+        }
+
+        SDL_Surface* tConverted = SDL_ConvertSurfaceFormat(tSurface, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(tSurface);
+
+        if (tConverted != nullptr)
+        {
+            tImages.push_back({tHashKey, tConverted, {}, 0});
+        }
+    }
+
+    if (tImages.empty())
+    {
+        return false;
+    }
+
+    int tPageSize = ATLAS_PAGE_SIZE;
+    SDL_RendererInfo tRendererInfo;
+    if (SDL_GetRendererInfo(m_Renderer, &tRendererInfo) == 0 && tRendererInfo.max_texture_width > 0)
+    {
+        tPageSize = std::min(tPageSize, std::min(tRendererInfo.max_texture_width, tRendererInfo.max_texture_height));
+    }
+
+    // Tallest first gives the skyline much less wasted space
+    std::stable_sort(tImages.begin(), tImages.end(), [](const PackedImage& aLeft, const PackedImage& aRight)
+    {
+        return aLeft.Surface->h > aRight.Surface->h;
+    });
+
+    vector<AtlasPacker> tPackers;
+    vector<PackedImage*> tPacked;
+
+    for (PackedImage& tImage : tImages)
+    {
+        const int tWidth = tImage.Surface->w + aPadding * 2;
+        const int tHeight = tImage.Surface->h + aPadding * 2;
+
+        if (tWidth > tPageSize || tHeight > tPageSize)
+        {
+            SDL_FreeSurface(tImage.Surface);
+            tImage.Surface = nullptr;
+            continue;
+        }
+
+        bool tFound = false;
+        for (size_t i = 0; i < tPackers.size() && !tFound; i++)
+        {
+            if (tPackers[i].Pack(tWidth, tHeight, &tImage.Bounds))
+            {
+                tImage.PageIndex = i;
+                tFound = true;
+            }
+        }
+
+        if (!tFound)
+        {
+            tPackers.push_back(AtlasPacker());
+            tPackers.back().Init(tPageSize, tPageSize);
+            tPackers.back().Pack(tWidth, tHeight, &tImage.Bounds);
+            tImage.PageIndex = tPackers.size() - 1;
+        }
+
+        tPacked.push_back(&tImage);
+    }
+
+    for (size_t tPageIndex = 0; tPageIndex < tPackers.size(); tPageIndex++)
+    {
+        SDL_Surface* tPage = SDL_CreateRGBSurfaceWithFormat(0, tPageSize, tPageSize, 32, SDL_PIXELFORMAT_RGBA32);
+        if (tPage == nullptr)
+        {
+            Engine::Instance().GetLogger().Log("Cannot create atlas page\n");
+            continue;
+        }
+
+        SDL_FillRect(tPage, nullptr, 0);
+        Uint32* tPagePixels = static_cast<Uint32*>(tPage->pixels);
+        const int tPagePitch = tPage->pitch / 4;
+
+        vector<PackedImage*> tPageImages;
+        for (PackedImage* tImage : tPacked)
+        {
+            if (tImage->PageIndex != tPageIndex)
+            {
+                continue;
+            }
+
+            // Copy the image and extrude its border pixels in the padding to avoid bleeding when filtering
+            SDL_Surface* tSurface = tImage->Surface;
+            const Uint32* tPixels = static_cast<const Uint32*>(tSurface->pixels);
+            const int tPitch = tSurface->pitch / 4;
+
+            for (int y = 0; y < tImage->Bounds.H; y++)
+            {
+                const int tSrcY = std::min(std::max(y - aPadding, 0), tSurface->h - 1);
+                Uint32* tDstRow = tPagePixels + (tImage->Bounds.Y + y) * tPagePitch + tImage->Bounds.X;
+                const Uint32* tSrcRow = tPixels + tSrcY * tPitch;
+
+                for (int x = 0; x < tImage->Bounds.W; x++)
+                {
+                    const int tSrcX = std::min(std::max(x - aPadding, 0), tSurface->w - 1);
+                    tDstRow[x] = tSrcRow[tSrcX];
+                }
+            }
+
+            tPageImages.push_back(tImage);
+        }
+
+        SDL_Texture* tTexture = SDL_CreateTextureFromSurface(m_Renderer, tPage);
+
+        if (tTexture == nullptr)
+        {
+            SDL_FreeSurface(tPage);
+            Engine::Instance().GetLogger().Log("Cannot create atlas page texture\n");
+            continue;
+        }
+
+        BuildOpacityMask(tTexture, tPage);
+        SDL_FreeSurface(tPage);
+
+        const string tPageName = "atlas_" + std::to_string(m_AtlasCount++);
+        const size_t tPageId = std::hash<std::string>()(tPageName);
+
+        // The atlas keeps one reference on its pages until UnloadAtlas is called
+        TextureInfo* tPageInfo = new TextureInfo();
+        tPageInfo->Data = tTexture;
+        tPageInfo->Count = 1;
+        tPageInfo->Width = tPageSize;
+        tPageInfo->Height = tPageSize;
+        m_AtlasPages[tPageId] = tPageInfo;
+        m_AtlasOwnedPages.push_back(tPageId);
+
+        for (PackedImage* tImage : tPageImages)
+        {
+            Rectangle tBounds;
+            tBounds.Set(tImage->Bounds.X + aPadding, tImage->Bounds.Y + aPadding, tImage->Surface->w, tImage->Surface->h);
+            m_AtlasRegions[tImage->Id] = {tPageId, tBounds};
+        }
+
+        Engine::Instance().GetLogger().Log(
+            "Atlas page %s: %d images, %.0f%% used\n", tPageName.c_str(), static_cast<int>(tPageImages.size()),
+            tPackers[tPageIndex].GetOccupancy() * 100.0f);
+    }
+
+    for (PackedImage& tImage : tImages)
+    {
+        if (tImage.Surface != nullptr)
+        {
+            SDL_FreeSurface(tImage.Surface);
+        }
+    }
+
+    return !tPackers.empty();
+}
+
+void bart::SdlGraphics::UnloadAtlas()
+{
+    m_AtlasRegions.clear();
+
+    // Pages still used by loaded textures are destroyed with their last texture
+    for (size_t tPageId : m_AtlasOwnedPages)
+    {
+        ReleasePage(tPageId);
+    }
+
+    m_AtlasOwnedPages.clear();
+}
+
+bool bart::SdlGraphics::ReadPixels(vector<unsigned int>& aPixels)
+{
+    DrawOutlines();
+
+    aPixels.resize(static_cast<size_t>(m_ScreenWidth) * m_ScreenHeight);
+    if (SDL_RenderReadPixels(m_Renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, aPixels.data(), m_ScreenWidth * 4) != 0)
+    {
+        Engine::Instance().GetLogger().Log("Cannot read the window: %s\n", SDL_GetError());
+        return false;
+    }
+
+    return true;
+}
+
+void bart::SdlGraphics::DestroyTexture(SDL_Texture* aTexture)
+{
+    m_OpacityMasks.erase(aTexture);
+    SDL_DestroyTexture(aTexture);
+}
+
+void bart::SdlGraphics::BuildOpacityMask(SDL_Texture* aTexture, SDL_Surface* aSurface)
+{
+    OpacityMask& tMask = m_OpacityMasks[aTexture];
+    tMask.Width = aSurface->w;
+    tMask.Height = aSurface->h;
+
+    Uint32 tColorKey;
+    if (!SDL_ISPIXELFORMAT_ALPHA(aSurface->format->format) && aSurface->format->palette == nullptr &&
+        SDL_GetColorKey(aSurface, &tColorKey) != 0)
+    {
+        // Nothing in the format can be transparent
+        tMask.AllOpaque = true;
+        return;
+    }
+
+    SDL_Surface* tConverted = SDL_ConvertSurfaceFormat(aSurface, SDL_PIXELFORMAT_RGBA32, 0);
+    if (tConverted == nullptr)
+    {
+        m_OpacityMasks.erase(aTexture);
+        return;
+    }
+
+    SDL_LockSurface(tConverted);
+
+    tMask.AllOpaque = true;
+    tMask.Bits.assign((static_cast<size_t>(tMask.Width) * tMask.Height + 7) / 8, 0);
+
+    for (int y = 0; y < tConverted->h; y++)
+    {
+        // RGBA32 is the byte order R, G, B, A whatever the endianness
+        const unsigned char* tRow = static_cast<const unsigned char*>(tConverted->pixels) + y * tConverted->pitch;
+
+        for (int x = 0; x < tConverted->w; x++)
+        {
+            const int tBit = y * tMask.Width + x;
+            if (tRow[x * 4 + 3] == 255)
+            {
+                tMask.Bits[tBit >> 3] |= static_cast<unsigned char>(1 << (tBit & 7));
+            }
+            else
+            {
+                tMask.AllOpaque = false;
+            }
+        }
+    }
+
+    SDL_UnlockSurface(tConverted);
+    SDL_FreeSurface(tConverted);
+
+    if (tMask.AllOpaque)
+    {
+        tMask.Bits.clear();
+    }
+}
+
+void bart::SdlGraphics::ReleasePage(const size_t aPageId)
+{
+    if (m_AtlasPages.count(aPageId) > 0)
+    {
+        m_AtlasPages[aPageId]->Count--;
+        if (m_AtlasPages[aPageId]->Count <= 0)
+        {
+            DestroyTexture(m_AtlasPages[aPageId]->Data);
+            delete m_AtlasPages[aPageId];
+            m_AtlasPages.erase(aPageId);
+        }
+    }
+}
+
+bart::SdlGraphics::CachedText* bart::SdlGraphics::GetCachedText(const size_t aFace, const string& aText, const int aWrapWidth)
+{
+    if (!SDL_RenderTargetSupported(m_Renderer))
+    {
+        return nullptr;
+    }
+
+    size_t tHashKey = std::hash<std::string>()(aText);
+    tHashKey ^= aFace + 0x9e3779b9 + (tHashKey << 6) + (tHashKey >> 2);
+    tHashKey ^= static_cast<size_t>(aWrapWidth) + 0x9e3779b9 + (tHashKey << 6) + (tHashKey >> 2);
+
+    CachedText* tText = nullptr;
+    TTextMap::iterator tItr = m_TextCache.find(tHashKey);
+
+    if (tItr != m_TextCache.end())
+    {
+        tText = tItr->second;
+        if (tText->Face == aFace && tText->WrapWidth == aWrapWidth && tText->Text == aText)
+        {
+            tText->LastUsedFrame = m_FrameCount;
+            return tText;
+        }
+
+        // Hash collision, the slot is reused for the new string
+        if (tText->Texture != nullptr)
+        {
+            SDL_DestroyTexture(tText->Texture);
+            tText->Texture = nullptr;
+        }
+    }
+    else
+    {
+        tText = new CachedText();
+        m_TextCache[tHashKey] = tText;
+    }
+
+    tText->Face = aFace;
+    tText->Text = aText;
+    tText->WrapWidth = aWrapWidth;
+    tText->LastUsedFrame = m_FrameCount;
+
+    RenderCachedText(tText, m_FaceCache[aFace]->Data);
+    m_Stats.Add(TEXT_RASTERIZED);
+    return tText;
+}
+
+void bart::SdlGraphics::RenderCachedText(CachedText* aText, FC_Font* aFont) const
+{
+    if (aText->WrapWidth > 0)
+    {
+        aText->Width = aText->WrapWidth;
+        aText->Height = FC_GetColumnHeight(aFont, static_cast<Uint16>(aText->WrapWidth), "%s", aText->Text.c_str());
+    }
+    else
+    {
+        const FC_Scale tScale = {1.0f, 1.0f};
+        const SDL_Rect tBounds = FC_GetBounds(aFont, 0, 0, FC_ALIGN_LEFT, tScale, "%s", aText->Text.c_str());
+        aText->Width = tBounds.w;
+        aText->Height = tBounds.h;
+    }
+
+    if (aText->Width <= 0 || aText->Height <= 0)
+    {
+        return;
+    }
+
+    aText->Texture = SDL_CreateTexture(
+        m_Renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, aText->Width, aText->Height);
+
+    if (aText->Texture == nullptr)
+    {
+        return;
+    }
+
+    SDL_SetTextureBlendMode(aText->Texture, SDL_BLENDMODE_BLEND);
+
+    SDL_Texture* tPreviousTarget = SDL_GetRenderTarget(m_Renderer);
+    Uint8 tR, tG, tB, tA;
+    SDL_GetRenderDrawColor(m_Renderer, &tR, &tG, &tB, &tA);
+
+    SDL_SetRenderTarget(m_Renderer, aText->Texture);
+    SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 0);
+    SDL_RenderClear(m_Renderer);
+
+    // Glyphs are copied as is so the cached texture keeps straight (not premultiplied) alpha
+    const int tLevels = FC_GetNumCacheLevels(aFont);
+    for (int i = 0; i < tLevels; i++)
+    {
+        SDL_SetTextureBlendMode(FC_GetGlyphCacheLevel(aFont, i), SDL_BLENDMODE_NONE);
+    }
+
+    if (aText->WrapWidth > 0)
+    {
+        FC_DrawColumn(aFont, m_Renderer, 0.0f, 0.0f, static_cast<Uint16>(aText->WrapWidth), "%s", aText->Text.c_str());
+    }
+    else
+    {
+        FC_Draw(aFont, m_Renderer, 0.0f, 0.0f, "%s", aText->Text.c_str());
+    }
+
+    const int tNewLevels = FC_GetNumCacheLevels(aFont);
+    for (int i = 0; i < tNewLevels; i++)
+    {
+        SDL_SetTextureBlendMode(FC_GetGlyphCacheLevel(aFont, i), SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_SetRenderTarget(m_Renderer, tPreviousTarget);
+    SDL_SetRenderDrawColor(m_Renderer, tR, tG, tB, tA);
+    ApplyTargetScale();
+}
+
+void bart::SdlGraphics::EvictCachedText(const bool aAll, const size_t aFace)
+{
+    for (TTextMap::iterator tItr = m_TextCache.begin(); tItr != m_TextCache.end();)
+    {
+        CachedText* tText = tItr->second;
+        const bool tExpired = m_FrameCount - tText->LastUsedFrame > TEXT_CACHE_LIFETIME;
+
+        if (aAll || tText->Face == aFace || (aFace == 0 && tExpired))
+        {
+            if (tText->Texture != nullptr)
+            {
+                SDL_DestroyTexture(tText->Texture);
+            }
+
+            delete tText;
+            tItr = m_TextCache.erase(tItr);
+        }
+        else
+        {
+            ++tItr;
+        }
+    }
+}
+
+bart::RenderStats& bart::SdlGraphics::GetRenderStats()
+{
+    return m_Stats;
+}
+
+void bart::SdlGraphics::ShowRenderStats(const size_t aFont)
+{
+    m_StatsFont = aFont;
+}
+
+void bart::SdlGraphics::CountDraw(const ERenderCounter aCounter, const int aX, const int aY, const int aWidth, const int aHeight)
+{
+    m_Stats.Add(aCounter);
+    CountPixels(aX, aY, aWidth, aHeight);
+}
+
+void bart::SdlGraphics::CountPixels(const int aX, const int aY, const int aWidth, const int aHeight)
+{
+    // Estimated in window pixels: the part of the rectangle inside the logical screen, times the render scale
+    const int tScreenWidth = static_cast<int>(static_cast<float>(m_ScreenWidth) / m_ScaleX);
+    const int tScreenHeight = static_cast<int>(static_cast<float>(m_ScreenHeight) / m_ScaleY);
+    const int tLeft = std::max(aX, 0);
+    const int tTop = std::max(aY, 0);
+    const int tRight = std::min(aX + aWidth, tScreenWidth);
+    const int tBottom = std::min(aY + aHeight, tScreenHeight);
+
+    if (tRight > tLeft && tBottom > tTop)
+    {
+        const float tArea = static_cast<float>(tRight - tLeft) * static_cast<float>(tBottom - tTop);
+        m_Stats.Add(PIXELS_FILLED, static_cast<unsigned long long>(tArea * m_ScaleX * m_ScaleY));
+
+        if (m_RenderTarget == 0)
+        {
+            m_Overdraw.Add(tLeft, tTop, tRight - tLeft, tBottom - tTop);
+        }
+    }
+}
+
+void bart::SdlGraphics::CountTexture(SDL_Texture* aTexture)
+{
+    if (aTexture != m_LastTexture)
+    {
+        m_Stats.Add(TEXTURE_SWITCHES);
+        m_LastTexture = aTexture;
+    }
+}
+
+void bart::SdlGraphics::DrawRenderStats()
+{
+    if (m_FntCache.count(m_StatsFont) == 0)
+    {
+        return;
+    }
+
+    // Drawn straight with the font cache, the overlay stays out of the counters and of the text cache
+    FC_Font* tFont = m_FntCache[m_StatsFont]->Data;
+    std::string tText = m_Stats.ToString();
+    if (m_Overdraw.IsEnabled())
+    {
+        tText += m_Overdraw.ToString();
+    }
+
+    const SDL_Color tColor = {255, 255, 0, 255};
+    const FC_Scale tScale = {1.0f, 1.0f};
+    const SDL_Rect tBounds = FC_GetBounds(tFont, 0, 0, FC_ALIGN_LEFT, tScale, "%s", tText.c_str());
+    const SDL_Rect tBackground = {0, 0, tBounds.w + 20, tBounds.h + 20};
+
+    // The background only shows the frame through it with blending, the game may have left it off
+    SDL_BlendMode tBlendMode;
+    SDL_GetRenderDrawBlendMode(m_Renderer, &tBlendMode);
+    SDL_SetRenderDrawBlendMode(m_Renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(m_Renderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(m_Renderer, &tBackground);
+    SDL_SetRenderDrawBlendMode(m_Renderer, tBlendMode);
+    SDL_SetRenderDrawColor(m_Renderer, m_DrawColor.R, m_DrawColor.G, m_DrawColor.B, m_DrawColor.A);
+
+    FC_DrawColor(tFont, m_Renderer, 10.0f, 10.0f, tColor, "%s", tText.c_str());
 }
+
+bart::OverdrawAnalyzer& bart::SdlGraphics::GetOverdrawAnalyzer()
+{
+    return m_Overdraw;
+}
+
+void bart::SdlGraphics::ShowOverdraw(const bool aEnabled)
+{
+    m_Overdraw.SetEnabled(aEnabled);
+
+    if (aEnabled)
+    {
+        m_Overdraw.Resize(static_cast<int>(static_cast<float>(m_ScreenWidth) / m_ScaleX),
+                          static_cast<int>(static_cast<float>(m_ScreenHeight) / m_ScaleY));
+    }
+    else if (m_HeatmapTexture != nullptr)
+    {
+        SDL_DestroyTexture(m_HeatmapTexture);
+        m_HeatmapTexture = nullptr;
+        m_HeatmapPixels.clear();
+    }
+}
+
+void bart::SdlGraphics::DrawOverdraw()
+{
+    const int tWidth = m_Overdraw.GetWidth();
+    const int tHeight = m_Overdraw.GetHeight();
+
+    if (tWidth <= 0 || tHeight <= 0)
+    {
+        return;
+    }
+
+    int tTexWidth = 0;
+    int tTexHeight = 0;
+    if (m_HeatmapTexture != nullptr)
+    {
+        SDL_QueryTexture(m_HeatmapTexture, nullptr, nullptr, &tTexWidth, &tTexHeight);
+    }
+
+    if (tTexWidth != tWidth || tTexHeight != tHeight)
+    {
+        if (m_HeatmapTexture != nullptr)
+        {
+            SDL_DestroyTexture(m_HeatmapTexture);
+        }
+
+        m_HeatmapTexture = SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, tWidth, tHeight);
+        if (m_HeatmapTexture == nullptr)
+        {
+            return;
+        }
+
+        SDL_SetTextureBlendMode(m_HeatmapTexture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureAlphaMod(m_HeatmapTexture, 220);
+    }
+
+    // Pixels never written stay transparent so the scene shows through
+    m_Overdraw.GetHeatmap(&m_HeatmapPixels);
+    SDL_UpdateTexture(m_HeatmapTexture, nullptr, m_HeatmapPixels.data(), tWidth * 4);
+
+    const SDL_Rect tDstRect = {0, 0, tWidth, tHeight};
+    SDL_RenderCopy(m_Renderer, m_HeatmapTexture, nullptr, &tDstRect);
+}
\ No newline at end of file
@@ -0,0 +1,1453 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: SoftwareGraphics.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <SoftwareGraphics.h>
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include <Engine.h>
+#include <Camera.h>
+#include <Config.h>
+#include <algorithm>
+#include <cmath>
+
+const unsigned int bart::SoftwareGraphics::TEXT_CACHE_LIFETIME = 120;
+
+bool bart::SoftwareGraphics::Initialize()
+{
+    if (SDL_Init(SDL_INIT_EVERYTHING) < 0)
+    {
+        Engine::Instance().GetLogger().Log("Cannot initialize SDL\n");
+        return false;
+    }
+
+    const int imgFlags = IMG_INIT_PNG;
+    if (!(IMG_Init(imgFlags) & imgFlags))
+    {
+        Engine::Instance().GetLogger().Log("Cannot initialize SDL_image\n");
+        return false;
+    }
+
+    if (TTF_Init() < 0)
+    {
+        Engine::Instance().GetLogger().Log("Cannot initialize SDL_ttf\n");
+        return false;
+    }
+
+    m_Rasterizer.Start(SOFTWARE_RENDER_THREADS);
+    Engine::Instance().GetLogger().Log("Software renderer: %d threads\n", m_Rasterizer.GetThreadCount());
+
+    m_ClearColor.Set(0, 0, 0, 255);
+    m_DrawColor.Set(0, 0, 0, 255);
+    return true;
+}
+
+void bart::SoftwareGraphics::Clean()
+{
+    m_Rasterizer.Stop();
+    m_Rasterizer.SetTarget(nullptr);
+
+    EvictCachedText(true, 0);
+    ShowOverdraw(false);
+    DestroyOutput();
+    m_Circles.Clear();
+    m_Outlines.clear();
+
+    for (TTexMap::iterator it = m_TexCache.begin(); it != m_TexCache.end(); ++it)
+    {
+        delete it->second->Data;
+        delete it->second;
+    }
+
+    for (TFontMap::iterator it = m_FntCache.begin(); it != m_FntCache.end(); ++it)
+    {
+        delete it->second;
+    }
+
+    for (TFaceMap::iterator it = m_FaceCache.begin(); it != m_FaceCache.end(); ++it)
+    {
+        TTF_CloseFont(it->second->Data);
+        delete it->second;
+    }
+
+    m_TexCache.clear();
+    m_TargetScales.clear();
+    m_FntCache.clear();
+    m_FaceCache.clear();
+    m_Frame.Pixels.clear();
+    m_StatsSurface.Pixels.clear();
+
+    /*TTF_Quit();*/
+    SDL_Quit();
+}
+
+bool bart::SoftwareGraphics::InitWindow(const string& aTitle, const int aWidth, const int aHeight, const EWindowState aState)
+{
+    if (!CreateOutput(aTitle, aWidth, aHeight, aState))
+    {
+        return false;
+    }
+
+    m_ScreenWidth = aWidth;
+    m_ScreenHeight = aHeight;
+
+    m_Frame.Width = aWidth;
+    m_Frame.Height = aHeight;
+    m_Frame.Pixels.assign(static_cast<size_t>(aWidth) * aHeight, 0xFF000000);
+    m_Rasterizer.SetTarget(&m_Frame);
+    return true;
+}
+
+bool bart::SoftwareGraphics::CreateOutput(const string& aTitle, const int aWidth, const int aHeight, const EWindowState aState)
+{
+    m_Window = SDL_CreateWindow(aTitle.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, aWidth, aHeight, 0);
+
+    if (m_Window == nullptr)
+    {
+        Engine::Instance().GetLogger().Log("Cannot initialize SDL window\n");
+        return false;
+    }
+
+    // Only used to show the frame, any renderer will do
+    m_Renderer = SDL_CreateRenderer(m_Window, -1, 0);
+
+    if (m_Renderer == nullptr)
+    {
+        Engine::Instance().GetLogger().Log("Cannot initialize SDL renderer\n");
+        return false;
+    }
+
+    m_FrameTexture = SDL_CreateTexture(m_Renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, aWidth, aHeight);
+
+    if (m_FrameTexture == nullptr)
+    {
+        Engine::Instance().GetLogger().Log("Cannot create the frame texture: %s\n", SDL_GetError());
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(m_FrameTexture, SDL_BLENDMODE_NONE);
+    SetWindowState(aState);
+    return true;
+}
+
+void bart::SoftwareGraphics::PresentOutput()
+{
+    if (m_FrameTexture != nullptr)
+    {
+        SDL_UpdateTexture(m_FrameTexture, nullptr, m_Frame.Pixels.data(), m_Frame.Width * 4);
+        SDL_RenderCopy(m_Renderer, m_FrameTexture, nullptr, nullptr);
+        SDL_RenderPresent(m_Renderer);
+    }
+}
+
+void bart::SoftwareGraphics::DestroyOutput()
+{
+    if (m_FrameTexture != nullptr)
+    {
+        SDL_DestroyTexture(m_FrameTexture);
+    }
+
+    if (m_Renderer != nullptr)
+    {
+        SDL_DestroyRenderer(m_Renderer);
+    }
+
+    if (m_Window != nullptr)
+    {
+        SDL_DestroyWindow(m_Window);
+    }
+
+    m_FrameTexture = nullptr;
+    m_Renderer = nullptr;
+    m_Window = nullptr;
+}
+
+void bart::SoftwareGraphics::Clear()
+{
+    Clear(m_ClearColor);
+
+    m_DrawColor.Set(0, 0, 0, 255);
+    m_Stats.Add(PIXELS_FILLED, static_cast<unsigned long long>(m_ScreenWidth) * m_ScreenHeight);
+}
+
+void bart::SoftwareGraphics::Clear(const Color& aColor)
+{
+    SoftwareSurface* tTarget = m_Rasterizer.GetTarget();
+    if (tTarget == nullptr)
+    {
+        return;
+    }
+
+    // Like SDL_RenderClear, the whole target is replaced whatever the viewport
+    RasterCommand tCommand;
+    tCommand.Color = static_cast<unsigned int>(aColor.A) << 24 | aColor.R << 16 | aColor.G << 8 | aColor.B;
+    tCommand.Blend = false;
+    tCommand.DstW = tTarget->Width;
+    tCommand.DstH = tTarget->Height;
+    tCommand.ClipW = tTarget->Width;
+    tCommand.ClipH = tTarget->Height;
+    m_Rasterizer.Submit(tCommand);
+}
+
+void bart::SoftwareGraphics::Clear(const Color& aColor, const Rectangle& aRegion)
+{
+    RasterCommand tCommand;
+    tCommand.Color = static_cast<unsigned int>(aColor.A) << 24 | aColor.R << 16 | aColor.G << 8 | aColor.B;
+    tCommand.Blend = false;
+    Submit(tCommand, static_cast<float>(aRegion.X), static_cast<float>(aRegion.Y), static_cast<float>(aRegion.W), static_cast<float>(aRegion.H));
+    CountPixels(aRegion.X, aRegion.Y, aRegion.W, aRegion.H);
+}
+
+void bart::SoftwareGraphics::Present()
+{
+    DrawOutlines();
+
+    if (m_Overdraw.IsEnabled())
+    {
+        m_Overdraw.EndFrame();
+        DrawOverdraw();
+        m_Overdraw.Resize(static_cast<int>(static_cast<float>(m_ScreenWidth) / m_ScaleX),
+                          static_cast<int>(static_cast<float>(m_ScreenHeight) / m_ScaleY));
+    }
+
+    if (m_StatsFont != 0)
+    {
+        DrawRenderStats();
+    }
+
+    m_Rasterizer.Flush();
+    PresentOutput();
+
+    m_Stats.NextFrame();
+
+    m_FrameCount++;
+    if (m_FrameCount % TEXT_CACHE_LIFETIME == 0)
+    {
+        EvictCachedText(false, 0);
+    }
+}
+
+void bart::SoftwareGraphics::SetColor(const unsigned char aRed,
+                                      const unsigned char aGreen,
+                                      const unsigned char aBlue,
+                                      const unsigned char aAlpha)
+{
+    if (m_DrawColor.R != aRed || m_DrawColor.G != aGreen || m_DrawColor.B != aBlue || m_DrawColor.A != aAlpha)
+    {
+        m_Stats.Add(STATE_CHANGES);
+        m_DrawColor.Set(aRed, aGreen, aBlue, aAlpha);
+    }
+}
+
+void bart::SoftwareGraphics::SetClearColor(unsigned char aRed, unsigned char aGreen, unsigned char aBlue)
+{
+    m_ClearColor.Set(aRed, aGreen, aBlue, 255);
+}
+
+size_t bart::SoftwareGraphics::LoadTexture(const string& aFilename)
+{
+    const size_t tHashKey = std::hash<std::string>()(aFilename);
+
+    if (m_TexCache.count(tHashKey) > 0)
+    {
+        m_TexCache[tHashKey]->Count++;
+        return tHashKey;
+    }
+
+    SDL_Surface* tSurface = IMG_Load(aFilename.c_str());
+    if (tSurface != nullptr)
+    {
+        SoftwareSurface* tImage = new SoftwareSurface();
+        const bool tCopied = CopySurface(tSurface, tImage);
+        SDL_FreeSurface(tSurface);
+
+        if (tCopied)
+        {
+            m_TexCache[tHashKey] = new Resource<SoftwareSurface>();
+            m_TexCache[tHashKey]->Data = tImage;
+            m_TexCache[tHashKey]->Count = 1;
+            return tHashKey;
+        }
+
+        delete tImage;
+    }
+
+    Engine::Instance().GetLogger().Log("Cannot load texture: %s\n", aFilename.c_str());
+    return 0;
+}
+
+void bart::SoftwareGraphics::UnloadTexture(size_t aTextureId)
+{
+    if (m_TexCache.count(aTextureId) > 0)
+    {
+        Resource<SoftwareSurface>* tInfo = m_TexCache[aTextureId];
+        tInfo->Count--;
+        if (tInfo->Count <= 0)
+        {
+            // Queued commands may still read the pixels
+            if (aTextureId == m_RenderTarget)
+            {
+                SetRenderTarget(0);
+            }
+
+            m_Rasterizer.Flush();
+
+            delete tInfo->Data;
+            delete tInfo;
+            m_TexCache.erase(aTextureId);
+            m_TargetScales.erase(aTextureId);
+        }
+    }
+}
+
+size_t bart::SoftwareGraphics::LoadFont(const string& aFilename, int aFontSize, const Color& aColor)
+{
+    const std::string tFontName = aFilename + "_" + std::to_string(aFontSize) + std::to_string(aColor.R) + std::
+        to_string(aColor.G) + std::to_string(aColor.B) + std::to_string(aColor.A);
+
+    const size_t tHashKey = std::hash<std::string>()(tFontName);
+
+    if (m_FntCache.count(tHashKey) > 0)
+    {
+        m_FntCache[tHashKey]->Count++;
+        return tHashKey;
+    }
+
+    // Same sizes as the font cache of SdlGraphics so both renderers lay out the text alike
+    const size_t tFaceKey = std::hash<std::string>()(aFilename + "_" + std::to_string(aFontSize));
+
+    if (m_FaceCache.count(tFaceKey) > 0)
+    {
+        m_FaceCache[tFaceKey]->Count++;
+    }
+    else
+    {
+        TTF_Font* tFont = TTF_OpenFont(aFilename.c_str(), aFontSize * 2);
+        if (tFont == nullptr)
+        {
+            Engine::Instance().GetLogger().Log("Cannot load font: %s\n", aFilename.c_str());
+            return 0;
+        }
+
+        m_FaceCache[tFaceKey] = new Resource<TTF_Font>();
+        m_FaceCache[tFaceKey]->Data = tFont;
+        m_FaceCache[tFaceKey]->Count = 1;
+    }
+
+    FontInfo* tInfo = new FontInfo();
+    tInfo->Data = m_FaceCache[tFaceKey]->Data;
+    tInfo->Count = 1;
+    tInfo->Face = tFaceKey;
+    tInfo->Tint = aColor;
+    m_FntCache[tHashKey] = tInfo;
+    return tHashKey;
+}
+
+void bart::SoftwareGraphics::UnloadFont(size_t aFontId)
+{
+    if (m_FntCache.count(aFontId) > 0)
+    {
+        m_FntCache[aFontId]->Count--;
+        if (m_FntCache[aFontId]->Count <= 0)
+        {
+            const size_t tFaceKey = m_FntCache[aFontId]->Face;
+            delete m_FntCache[aFontId];
+            m_FntCache.erase(aFontId);
+
+            m_FaceCache[tFaceKey]->Count--;
+            if (m_FaceCache[tFaceKey]->Count <= 0)
+            {
+                m_Rasterizer.Flush();
+                EvictCachedText(false, tFaceKey);
+                TTF_CloseFont(m_FaceCache[tFaceKey]->Data);
+                delete m_FaceCache[tFaceKey];
+                m_FaceCache.erase(tFaceKey);
+            }
+        }
+    }
+}
+
+void bart::SoftwareGraphics::Draw(const Rectangle& aRect)
+{
+    int x, y, w, h;
+    aRect.Get(&x, &y, &w, &h);
+    Draw(x, y, w, h);
+}
+
+void bart::SoftwareGraphics::Draw(const int aX, const int aY, const int aWidth, const int aHeight)
+{
+    int tX = aX;
+    int tY = aY;
+
+    if (m_Camera != nullptr)
+    {
+        tX -= m_Camera->GetX();
+        tY -= m_Camera->GetY();
+    }
+
+    SubmitOutline(static_cast<float>(tX), static_cast<float>(tY), static_cast<float>(aWidth), static_cast<float>(aHeight));
+
+    m_Stats.Add(DRAW_RECTANGLE);
+    m_Stats.Add(PIXELS_FILLED, 2ULL * (aWidth > 0 ? aWidth : 0) + 2ULL * (aHeight > 0 ? aHeight : 0));
+}
+
+void bart::SoftwareGraphics::Draw(const Circle& aCircle)
+{
+    int x, y;
+    float r;
+    aCircle.Get(&x, &y, &r);
+    Draw(x, y, r);
+}
+
+void bart::SoftwareGraphics::Draw(const int aX, const int aY, const float aRadius)
+{
+    const Circle tCircle(aX, aY, aRadius);
+    DrawCircles(&tCircle, 1);
+}
+
+void bart::SoftwareGraphics::Draw(const Point& aPoint)
+{
+    Draw(aPoint.X, aPoint.Y);
+}
+
+void bart::SoftwareGraphics::Draw(const int aX, const int aY)
+{
+    int tX = aX;
+    int tY = aY;
+
+    if (m_Camera != nullptr)
+    {
+        tX -= m_Camera->GetX();
+        tY -= m_Camera->GetY();
+    }
+
+    RasterCommand tCommand;
+    Submit(tCommand, static_cast<float>(tX), static_cast<float>(tY), 1.0f, 1.0f);
+    CountDraw(DRAW_POINT, tX, tY, 1, 1);
+}
+
+void bart::SoftwareGraphics::DrawRects(const Rectangle* aRects, const size_t aCount)
+{
+    if (aCount == 0)
+    {
+        return;
+    }
+
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+    unsigned long long tPixels = 0;
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const Rectangle& tRect = aRects[i];
+        SubmitOutline(static_cast<float>(tRect.X - tOffsetX), static_cast<float>(tRect.Y - tOffsetY),
+                      static_cast<float>(tRect.W), static_cast<float>(tRect.H));
+        tPixels += 2ULL * (tRect.W > 0 ? tRect.W : 0) + 2ULL * (tRect.H > 0 ? tRect.H : 0);
+    }
+
+    m_Stats.Add(DRAW_RECTANGLE);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount);
+    m_Stats.Add(PIXELS_FILLED, tPixels);
+}
+
+void bart::SoftwareGraphics::FillRects(const Rectangle* aRects, const size_t aCount)
+{
+    if (aCount == 0)
+    {
+        return;
+    }
+
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const int tX = aRects[i].X - tOffsetX;
+        const int tY = aRects[i].Y - tOffsetY;
+
+        RasterCommand tCommand;
+        Submit(tCommand, static_cast<float>(tX), static_cast<float>(tY), static_cast<float>(aRects[i].W), static_cast<float>(aRects[i].H));
+        CountPixels(tX, tY, aRects[i].W, aRects[i].H);
+    }
+
+    m_Stats.Add(FILL_RECTANGLE);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount);
+}
+
+void bart::SoftwareGraphics::DrawPoints(const Point* aPoints, const size_t aCount)
+{
+    if (aCount == 0)
+    {
+        return;
+    }
+
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const int tX = aPoints[i].X - tOffsetX;
+        const int tY = aPoints[i].Y - tOffsetY;
+
+        RasterCommand tCommand;
+        Submit(tCommand, static_cast<float>(tX), static_cast<float>(tY), 1.0f, 1.0f);
+        CountPixels(tX, tY, 1, 1);
+    }
+
+    m_Stats.Add(DRAW_POINT);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount);
+}
+
+void bart::SoftwareGraphics::DrawLines(const Point* aPoints, const size_t aCount)
+{
+    if (aCount < 2)
+    {
+        return;
+    }
+
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+    unsigned long long tPixels = 0;
+
+    for (size_t i = 1; i < aCount; i++)
+    {
+        const int tX1 = aPoints[i - 1].X - tOffsetX;
+        const int tY1 = aPoints[i - 1].Y - tOffsetY;
+        const int tX2 = aPoints[i].X - tOffsetX;
+        const int tY2 = aPoints[i].Y - tOffsetY;
+
+        SubmitLine(tX1, tY1, tX2, tY2);
+        tPixels += static_cast<unsigned long long>(std::max(std::abs(tX2 - tX1), std::abs(tY2 - tY1)));
+    }
+
+    m_Stats.Add(DRAW_LINE);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount - 1);
+    m_Stats.Add(PIXELS_FILLED, tPixels + 1);
+}
+
+void bart::SoftwareGraphics::DrawCircles(const Circle* aCircles, const size_t aCount)
+{
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+    bool tDrawn = false;
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const int tCx = aCircles[i].X - tOffsetX;
+        const int tCy = aCircles[i].Y - tOffsetY;
+
+        for (const Point& tOffset : m_Circles.GetOutline(aCircles[i].R))
+        {
+            RasterCommand tCommand;
+            Submit(tCommand, static_cast<float>(tCx + tOffset.X), static_cast<float>(tCy + tOffset.Y), 1.0f, 1.0f);
+            CountPixels(tCx + tOffset.X, tCy + tOffset.Y, 1, 1);
+            tDrawn = true;
+        }
+    }
+
+    if (tDrawn)
+    {
+        m_Stats.Add(DRAW_POINT);
+        m_Stats.Add(PRIMITIVES_BATCHED, aCount);
+    }
+}
+
+void bart::SoftwareGraphics::Draw(size_t aTexture,
+                                  const Rectangle& aSrc,
+                                  const Rectangle& aDst,
+                                  float aAngle,
+                                  bool aHorizontalFlip,
+                                  bool aVerticalFlip,
+                                  unsigned char aAlpha)
+{
+    if (aTexture && m_TexCache.count(aTexture) > 0)
+    {
+        int tX = aDst.X;
+        int tY = aDst.Y;
+
+        if (m_Camera != nullptr)
+        {
+            tX -= m_Camera->GetX();
+            tY -= m_Camera->GetY();
+        }
+
+        RasterCommand tCommand;
+        tCommand.Source = m_TexCache[aTexture]->Data;
+        tCommand.SrcX = aSrc.X;
+        tCommand.SrcY = aSrc.Y;
+        tCommand.SrcW = aSrc.W;
+        tCommand.SrcH = aSrc.H;
+        tCommand.Angle = aAngle;
+        tCommand.HorizontalFlip = aHorizontalFlip;
+        tCommand.VerticalFlip = aVerticalFlip;
+        tCommand.Color = static_cast<unsigned int>(aAlpha) << 24 | 0x00FFFFFF;
+        tCommand.Blend = m_Blending || aAlpha != 255;
+        Submit(tCommand, static_cast<float>(tX), static_cast<float>(tY), static_cast<float>(aDst.W), static_cast<float>(aDst.H));
+
+        CountDraw(DRAW_TEXTURE, tX, tY, aDst.W, aDst.H);
+    }
+}
+
+void bart::SoftwareGraphics::DrawSprites(const size_t aTexture, const Rectangle& aSrc, const Rectangle* aDst, const Color* aTints,
+                                         const size_t aCount)
+{
+    const TTexMap::const_iterator tItr = m_TexCache.find(aTexture);
+    if (aCount == 0 || tItr == m_TexCache.end())
+    {
+        return;
+    }
+
+    const int tOffsetX = m_Camera != nullptr ? m_Camera->GetX() : 0;
+    const int tOffsetY = m_Camera != nullptr ? m_Camera->GetY() : 0;
+
+    RasterCommand tCommand;
+    tCommand.Source = tItr->second->Data;
+    tCommand.SrcX = aSrc.X;
+    tCommand.SrcY = aSrc.Y;
+    tCommand.SrcW = aSrc.W;
+    tCommand.SrcH = aSrc.H;
+
+    for (size_t i = 0; i < aCount; i++)
+    {
+        const Color& tTint = aTints[i];
+        const int tX = aDst[i].X - tOffsetX;
+        const int tY = aDst[i].Y - tOffsetY;
+
+        tCommand.Color = static_cast<unsigned int>(tTint.A) << 24 | tTint.R << 16 | tTint.G << 8 | tTint.B;
+        tCommand.Blend = true;
+        Submit(tCommand, static_cast<float>(tX), static_cast<float>(tY), static_cast<float>(aDst[i].W), static_cast<float>(aDst[i].H));
+        CountPixels(tX, tY, aDst[i].W, aDst[i].H);
+    }
+
+    m_Stats.Add(DRAW_TEXTURE);
+    m_Stats.Add(PRIMITIVES_BATCHED, aCount);
+}
+
+void bart::SoftwareGraphics::Draw(const size_t aFont, const std::string& aText, const int aX, const int aY)
+{
+    if (m_FntCache.count(aFont) > 0)
+    {
+        DrawString(aFont, aText, aX, aY, 0, m_FntCache[aFont]->Tint);
+    }
+}
+
+void bart::SoftwareGraphics::Draw(const size_t aFont, const std::string& aText, const int aX, const int aY, const int aWrapWidth)
+{
+    if (m_FntCache.count(aFont) > 0)
+    {
+        DrawString(aFont, aText, aX, aY, aWrapWidth, m_FntCache[aFont]->Tint);
+    }
+}
+
+void bart::SoftwareGraphics::Draw(const size_t aFont, const std::string& aText, const int aX, const int aY, const Color& aColor)
+{
+    if (m_FntCache.count(aFont) > 0)
+    {
+        DrawString(aFont, aText, aX, aY, 0, aColor);
+    }
+}
+
+void bart::SoftwareGraphics::DrawString(const size_t aFont,
+                                        const string& aText,
+                                        const int aX,
+                                        const int aY,
+                                        const int aWrapWidth,
+                                        const Color& aColor)
+{
+    int tX = aX;
+    int tY = aY;
+
+    if (m_Camera != nullptr)
+    {
+        tX -= m_Camera->GetX();
+        tY -= m_Camera->GetY();
+    }
+
+    const CachedText* tText = GetCachedText(m_FntCache[aFont]->Face, aText, aWrapWidth);
+
+    if (tText->Surface != nullptr)
+    {
+        const SoftwareSurface* tSurface = tText->Surface;
+
+        RasterCommand tCommand;
+        tCommand.Source = tSurface;
+        tCommand.SrcW = tSurface->Width;
+        tCommand.SrcH = tSurface->Height;
+        tCommand.Color = static_cast<unsigned int>(aColor.A) << 24 | aColor.R << 16 | aColor.G << 8 | aColor.B;
+        Submit(tCommand, static_cast<float>(tX), static_cast<float>(tY),
+               static_cast<float>(tSurface->Width), static_cast<float>(tSurface->Height));
+
+        CountDraw(DRAW_TEXT, tX, tY, tSurface->Width, tSurface->Height);
+    }
+}
+
+void bart::SoftwareGraphics::GetTextureSize(size_t aTextureId, int* aWidth, int* aHeight)
+{
+    if (m_TexCache.count(aTextureId) > 0)
+    {
+        *aWidth = m_TexCache[aTextureId]->Data->Width;
+        *aHeight = m_TexCache[aTextureId]->Data->Height;
+    }
+    else
+    {
+        *aWidth = 0;
+        *aHeight = 0;
+    }
+}
+
+bool bart::SoftwareGraphics::IsRegionOpaque(const size_t aTextureId, const Rectangle& aRegion)
+{
+    TTexMap::iterator tItr = m_TexCache.find(aTextureId);
+    if (tItr == m_TexCache.end())
+    {
+        return false;
+    }
+
+    // The pixels are at hand, no need for a mask
+    const SoftwareSurface* tSurface = tItr->second->Data;
+
+    if (aRegion.W <= 0 || aRegion.H <= 0 || aRegion.X < 0 || aRegion.Y < 0 || aRegion.X + aRegion.W > tSurface->Width ||
+        aRegion.Y + aRegion.H > tSurface->Height)
+    {
+        return false;
+    }
+
+    for (int y = aRegion.Y; y < aRegion.Y + aRegion.H; y++)
+    {
+        const unsigned int* tRow = tSurface->Pixels.data() + static_cast<size_t>(y) * tSurface->Width;
+
+        for (int x = aRegion.X; x < aRegion.X + aRegion.W; x++)
+        {
+            if (tRow[x] < 0xFF000000)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void bart::SoftwareGraphics::SetBlending(const bool aEnabled)
+{
+    if (m_Blending != aEnabled)
+    {
+        m_Blending = aEnabled;
+        m_Stats.Add(STATE_CHANGES);
+    }
+}
+
+void bart::SoftwareGraphics::GetFontSize(size_t aFontId, const string& aText, int* aWidth, int* aHeight)
+{
+    if (m_FntCache.count(aFontId) > 0)
+    {
+        const CachedText* tText = GetCachedText(m_FntCache[aFontId]->Face, aText, 0);
+        *aWidth = tText->Surface != nullptr ? tText->Surface->Width : 0;
+        *aHeight = tText->Surface != nullptr ? tText->Surface->Height : 0;
+    }
+    else
+    {
+        *aWidth = 0;
+        *aHeight = 0;
+    }
+}
+
+void bart::SoftwareGraphics::GetScreenSize(int* aWidth, int* aHeight)
+{
+    SDL_DisplayMode tDisplayMode;
+    SDL_GetCurrentDisplayMode(0, &tDisplayMode);
+    *aWidth = tDisplayMode.w;
+    *aHeight = tDisplayMode.h;
+}
+
+void bart::SoftwareGraphics::GetWindowSize(int* aWidth, int* aHeight)
+{
+    SDL_GetWindowSize(m_Window, aWidth, aHeight);
+}
+
+int bart::SoftwareGraphics::GetTextureInCache() const
+{
+    return static_cast<int>(m_TexCache.size());
+}
+
+int bart::SoftwareGraphics::GetFontInCache() const
+{
+    return static_cast<int>(m_FntCache.size());
+}
+
+void bart::SoftwareGraphics::SetCamera(Camera* aCamera)
+{
+    m_Camera = aCamera;
+}
+
+bart::Camera* bart::SoftwareGraphics::GetCamera() const
+{
+    return m_Camera;
+}
+
+void bart::SoftwareGraphics::Fill(const Rectangle& aRect)
+{
+    int x, y, w, h;
+    aRect.Get(&x, &y, &w, &h);
+    Fill(x, y, w, h);
+}
+
+void bart::SoftwareGraphics::Fill(int aX, int aY, int aWidth, int aHeight)
+{
+    int tX = aX;
+    int tY = aY;
+
+    if (m_Camera != nullptr)
+    {
+        tX -= m_Camera->GetX();
+        tY -= m_Camera->GetY();
+    }
+
+    RasterCommand tCommand;
+    Submit(tCommand, static_cast<float>(tX), static_cast<float>(tY), static_cast<float>(aWidth), static_cast<float>(aHeight));
+    CountDraw(FILL_RECTANGLE, tX, tY, aWidth, aHeight);
+}
+
+void bart::SoftwareGraphics::SetViewport(const int aX, const int aY, const int aWidth, const int aHeight)
+{
+    DrawOutlines();
+
+    // Stored in window pixels with the scale of the moment, as SDL_RenderSetViewport does
+    m_ViewportX = static_cast<int>(std::floor(static_cast<float>(aX) * m_ScaleX));
+    m_ViewportY = static_cast<int>(std::floor(static_cast<float>(aY) * m_ScaleY));
+    m_ViewportWidth = static_cast<int>(std::ceil(static_cast<float>(aWidth) * m_ScaleX));
+    m_ViewportHeight = static_cast<int>(std::ceil(static_cast<float>(aHeight) * m_ScaleY));
+    m_Stats.Add(STATE_CHANGES);
+}
+
+void bart::SoftwareGraphics::ScaleViewport(const float aX, const float aY)
+{
+    DrawOutlines();
+    m_Stats.Add(STATE_CHANGES);
+
+    // Each target keeps its own scale, nested switches to other targets do not lose it
+    if (m_RenderTarget != 0)
+    {
+        m_TargetScaleX = aX;
+        m_TargetScaleY = aY;
+        m_TargetScales[m_RenderTarget] = {aX, aY};
+        return;
+    }
+
+    m_ScaleX = aX;
+    m_ScaleY = aY;
+}
+
+void bart::SoftwareGraphics::GetViewportScale(float* aX, float* aY)
+{
+    *aX = m_ScaleX;
+    *aY = m_ScaleY;
+}
+
+size_t bart::SoftwareGraphics::CreateRenderTarget(const int aWidth, const int aHeight)
+{
+    if (aWidth <= 0 || aHeight <= 0)
+    {
+        return 0;
+    }
+
+    SoftwareSurface* tSurface = new SoftwareSurface();
+    tSurface->Width = aWidth;
+    tSurface->Height = aHeight;
+    tSurface->Pixels.assign(static_cast<size_t>(aWidth) * aHeight, 0);
+
+    m_TargetCount++;
+    const size_t tHashKey = std::hash<std::string>()("RenderTarget_" + std::to_string(m_TargetCount));
+
+    m_TexCache[tHashKey] = new Resource<SoftwareSurface>();
+    m_TexCache[tHashKey]->Data = tSurface;
+    m_TexCache[tHashKey]->Count = 1;
+    return tHashKey;
+}
+
+bool bart::SoftwareGraphics::SetRenderTarget(const size_t aTarget)
+{
+    SoftwareSurface* tSurface = &m_Frame;
+
+    if (aTarget != 0)
+    {
+        TTexMap::iterator tItr = m_TexCache.find(aTarget);
+        if (tItr == m_TexCache.end())
+        {
+            return false;
+        }
+
+        tSurface = tItr->second->Data;
+    }
+
+    // The rasterizer finishes the commands of the previous target first
+    m_Rasterizer.SetTarget(tSurface);
+    m_RenderTarget = aTarget;
+    m_TargetScaleX = 1.0f;
+    m_TargetScaleY = 1.0f;
+
+    TScaleMap::const_iterator tScale = m_TargetScales.find(aTarget);
+    if (tScale != m_TargetScales.end())
+    {
+        m_TargetScaleX = tScale->second.X;
+        m_TargetScaleY = tScale->second.Y;
+    }
+    m_Stats.Add(STATE_CHANGES);
+    return true;
+}
+
+size_t bart::SoftwareGraphics::GetRenderTarget() const
+{
+    return m_RenderTarget;
+}
+
+void bart::SoftwareGraphics::SetWindowState(const EWindowState aState)
+{
+    if (m_Window == nullptr)
+    {
+        return;
+    }
+
+    switch (aState)
+    {
+    case BORDERLESS:
+        SDL_SetWindowFullscreen(m_Window, SDL_WINDOW_FULLSCREEN_DESKTOP);
+        break;
+    case FULLSCREEN:
+        SDL_SetWindowFullscreen(m_Window, SDL_WINDOW_FULLSCREEN);
+        break;
+
+    default:
+        SDL_SetWindowFullscreen(m_Window, 0);
+    }
+}
+
+void bart::SoftwareGraphics::Draw(Transform* transform)
+{
+    float tX = transform->X;
+    float tY = transform->Y;
+
+    if (m_Camera != nullptr)
+    {
+        tX -= static_cast<float>(m_Camera->GetX());
+        tY -= static_cast<float>(m_Camera->GetY());
+    }
+
+    m_Stats.Add(PIXELS_FILLED, static_cast<unsigned long long>(2.0f * (transform->Width + transform->Height)));
+
+    if (m_RenderTarget != 0)
+    {
+        SubmitOutline(tX, tY, transform->Width, transform->Height);
+        m_Stats.Add(DRAW_TRANSFORM);
+        return;
+    }
+
+    // Kept for the end of the frame like SdlGraphics does, so both renderers give the same image
+    OutlineBatch* tBatch = nullptr;
+    for (OutlineBatch& tOutlines : m_Outlines)
+    {
+        if (tOutlines.Tint.R == m_DrawColor.R && tOutlines.Tint.G == m_DrawColor.G && tOutlines.Tint.B == m_DrawColor.B &&
+            tOutlines.Tint.A == m_DrawColor.A)
+        {
+            tBatch = &tOutlines;
+            break;
+        }
+    }
+
+    if (tBatch == nullptr)
+    {
+        m_Outlines.push_back(OutlineBatch());
+        tBatch = &m_Outlines.back();
+        tBatch->Tint = m_DrawColor;
+    }
+
+    tBatch->Rects.push_back(tX);
+    tBatch->Rects.push_back(tY);
+    tBatch->Rects.push_back(transform->Width);
+    tBatch->Rects.push_back(transform->Height);
+}
+
+void bart::SoftwareGraphics::DrawOutlines()
+{
+    if (m_RenderTarget != 0)
+    {
+        return;
+    }
+
+    const Color tDrawColor = m_DrawColor;
+
+    for (OutlineBatch& tBatch : m_Outlines)
+    {
+        const size_t tCount = tBatch.Rects.size() / 4;
+        if (tCount == 0)
+        {
+            continue;
+        }
+
+        m_DrawColor = tBatch.Tint;
+        for (size_t i = 0; i < tCount; i++)
+        {
+            const float* tRect = &tBatch.Rects[i * 4];
+            SubmitOutline(tRect[0], tRect[1], tRect[2], tRect[3]);
+        }
+
+        m_Stats.Add(DRAW_TRANSFORM);
+        m_Stats.Add(PRIMITIVES_BATCHED, static_cast<unsigned long long>(tCount));
+        tBatch.Rects.clear();
+    }
+
+    m_DrawColor = tDrawColor;
+}
+
+bool bart::SoftwareGraphics::LoadAtlas(const string& /*aManifest*/)
+{
+    // Texture switches cost nothing on the CPU, the images are used as is
+    return false;
+}
+
+bool bart::SoftwareGraphics::BuildAtlas(const vector<string>& /*aFiles*/, int /*aPadding*/)
+{
+    return false;
+}
+
+void bart::SoftwareGraphics::UnloadAtlas()
+{
+}
+
+void bart::SoftwareGraphics::Submit(RasterCommand& aCommand, const float aX, const float aY, const float aWidth, const float aHeight)
+{
+    const SoftwareSurface* tTarget = m_Rasterizer.GetTarget();
+    if (tTarget == nullptr || aWidth <= 0.0f || aHeight <= 0.0f)
+    {
+        return;
+    }
+
+    // Fills take the draw color, the ones without blending are clears and keep their own
+    if (aCommand.Source == nullptr && aCommand.Blend)
+    {
+        aCommand.Color = static_cast<unsigned int>(m_DrawColor.A) << 24 | m_DrawColor.R << 16 | m_DrawColor.G << 8 | m_DrawColor.B;
+    }
+
+    // The window gets the viewport and its scale, render targets only their own scale
+    float tOriginX = 0.0f;
+    float tOriginY = 0.0f;
+    float tScaleX = m_TargetScaleX;
+    float tScaleY = m_TargetScaleY;
+    aCommand.ClipX = 0;
+    aCommand.ClipY = 0;
+    aCommand.ClipW = tTarget->Width;
+    aCommand.ClipH = tTarget->Height;
+
+    if (m_RenderTarget == 0)
+    {
+        tScaleX = m_ScaleX;
+        tScaleY = m_ScaleY;
+
+        if (m_ViewportWidth > 0 && m_ViewportHeight > 0)
+        {
+            tOriginX = static_cast<float>(m_ViewportX);
+            tOriginY = static_cast<float>(m_ViewportY);
+            aCommand.ClipX = m_ViewportX;
+            aCommand.ClipY = m_ViewportY;
+            aCommand.ClipW = m_ViewportWidth;
+            aCommand.ClipH = m_ViewportHeight;
+        }
+    }
+
+    // Both edges are rounded the same way so neighbouring rectangles meet without gap or overlap
+    const float tLeft = tOriginX + aX * tScaleX;
+    const float tTop = tOriginY + aY * tScaleY;
+    aCommand.DstX = static_cast<int>(std::floor(tLeft + 0.5f));
+    aCommand.DstY = static_cast<int>(std::floor(tTop + 0.5f));
+    aCommand.DstW = static_cast<int>(std::floor(tLeft + aWidth * tScaleX + 0.5f)) - aCommand.DstX;
+    aCommand.DstH = static_cast<int>(std::floor(tTop + aHeight * tScaleY + 0.5f)) - aCommand.DstY;
+
+    if (aCommand.DstW > 0 && aCommand.DstH > 0)
+    {
+        m_Rasterizer.Submit(aCommand);
+    }
+}
+
+void bart::SoftwareGraphics::SubmitOutline(const float aX, const float aY, const float aWidth, const float aHeight)
+{
+    if (aWidth <= 0.0f || aHeight <= 0.0f)
+    {
+        return;
+    }
+
+    RasterCommand tCommand;
+    Submit(tCommand, aX, aY, aWidth, 1.0f);
+    Submit(tCommand, aX, aY + aHeight - 1.0f, aWidth, 1.0f);
+    Submit(tCommand, aX, aY + 1.0f, 1.0f, aHeight - 2.0f);
+    Submit(tCommand, aX + aWidth - 1.0f, aY + 1.0f, 1.0f, aHeight - 2.0f);
+}
+
+void bart::SoftwareGraphics::SubmitLine(const int aX1, const int aY1, const int aX2, const int aY2)
+{
+    // Bresenham, the pixels of a row (or of a column for steep lines) are filled as one span
+    const int tDx = std::abs(aX2 - aX1);
+    const int tDy = -std::abs(aY2 - aY1);
+    const int tStepX = aX1 < aX2 ? 1 : -1;
+    const int tStepY = aY1 < aY2 ? 1 : -1;
+    const bool tSteep = -tDy > tDx;
+
+    int tError = tDx + tDy;
+    int tX = aX1;
+    int tY = aY1;
+    int tSpanX = tX;
+    int tSpanY = tY;
+
+    RasterCommand tCommand;
+
+    while (true)
+    {
+        const bool tLast = tX == aX2 && tY == aY2;
+        int tNextX = tX;
+        int tNextY = tY;
+
+        if (!tLast)
+        {
+            const int tError2 = 2 * tError;
+            if (tError2 >= tDy)
+            {
+                tError += tDy;
+                tNextX += tStepX;
+            }
+
+            if (tError2 <= tDx)
+            {
+                tError += tDx;
+                tNextY += tStepY;
+            }
+        }
+
+        // The span ends when the line leaves its row (or column), or at the last pixel
+        if (tLast || (tSteep ? tNextX != tSpanX : tNextY != tSpanY))
+        {
+            const int tLeft = std::min(tSpanX, tX);
+            const int tTop = std::min(tSpanY, tY);
+            Submit(tCommand, static_cast<float>(tLeft), static_cast<float>(tTop),
+                   static_cast<float>(std::abs(tX - tSpanX) + 1), static_cast<float>(std::abs(tY - tSpanY) + 1));
+            tSpanX = tNextX;
+            tSpanY = tNextY;
+        }
+
+        if (tLast)
+        {
+            break;
+        }
+
+        tX = tNextX;
+        tY = tNextY;
+    }
+}
+
+bool bart::SoftwareGraphics::CopySurface(SDL_Surface* aSurface, SoftwareSurface* aTarget)
+{
+    SDL_Surface* tConverted = SDL_ConvertSurfaceFormat(aSurface, SDL_PIXELFORMAT_ARGB8888, 0);
+    if (tConverted == nullptr)
+    {
+        return false;
+    }
+
+    SDL_LockSurface(tConverted);
+
+    aTarget->Width = tConverted->w;
+    aTarget->Height = tConverted->h;
+    aTarget->Pixels.resize(static_cast<size_t>(tConverted->w) * tConverted->h);
+
+    for (int y = 0; y < tConverted->h; y++)
+    {
+        const unsigned char* tRow = static_cast<const unsigned char*>(tConverted->pixels) + y * tConverted->pitch;
+        std::copy_n(reinterpret_cast<const unsigned int*>(tRow), tConverted->w, aTarget->Pixels.data() + static_cast<size_t>(y) * tConverted->w);
+    }
+
+    SDL_UnlockSurface(tConverted);
+    SDL_FreeSurface(tConverted);
+    return true;
+}
+
+bool bart::SoftwareGraphics::RenderText(TTF_Font* aFont, const string& aText, const int aWrapWidth, SoftwareSurface* aTarget)
+{
+    const SDL_Color tWhite = {255, 255, 255, 255};
+
+    aTarget->Width = 0;
+    aTarget->Height = 0;
+    aTarget->Pixels.clear();
+
+    if (aWrapWidth > 0)
+    {
+        SDL_Surface* tSurface = TTF_RenderUTF8_Blended_Wrapped(aFont, aText.c_str(), tWhite, static_cast<Uint32>(aWrapWidth));
+        if (tSurface == nullptr)
+        {
+            return false;
+        }
+
+        const bool tCopied = CopySurface(tSurface, aTarget);
+        SDL_FreeSurface(tSurface);
+        return tCopied;
+    }
+
+    // SDL_ttf ignores line breaks without a wrap width, the lines are rendered one by one
+    vector<SoftwareSurface> tLines;
+    size_t tStart = 0;
+    while (tStart <= aText.size())
+    {
+        size_t tEnd = aText.find('\n', tStart);
+        if (tEnd == string::npos)
+        {
+            tEnd = aText.size();
+        }
+
+        tLines.push_back(SoftwareSurface());
+        SDL_Surface* tSurface = nullptr;
+        if (tEnd > tStart)
+        {
+            tSurface = TTF_RenderUTF8_Blended(aFont, aText.substr(tStart, tEnd - tStart).c_str(), tWhite);
+        }
+
+        if (tSurface != nullptr)
+        {
+            CopySurface(tSurface, &tLines.back());
+            SDL_FreeSurface(tSurface);
+        }
+
+        aTarget->Width = std::max(aTarget->Width, tLines.back().Width);
+        tStart = tEnd + 1;
+    }
+
+    const int tLineSkip = TTF_FontLineSkip(aFont);
+    aTarget->Height = tLineSkip * (static_cast<int>(tLines.size()) - 1) + TTF_FontHeight(aFont);
+
+    if (aTarget->Width <= 0 || aTarget->Height <= 0)
+    {
+        aTarget->Width = 0;
+        aTarget->Height = 0;
+        return false;
+    }
+
+    aTarget->Pixels.assign(static_cast<size_t>(aTarget->Width) * aTarget->Height, 0x00FFFFFF);
+
+    for (size_t i = 0; i < tLines.size(); i++)
+    {
+        const SoftwareSurface& tLine = tLines[i];
+        const int tTop = tLineSkip * static_cast<int>(i);
+
+        for (int y = 0; y < tLine.Height && tTop + y < aTarget->Height; y++)
+        {
+            std::copy_n(tLine.Pixels.data() + static_cast<size_t>(y) * tLine.Width, tLine.Width,
+                        aTarget->Pixels.data() + static_cast<size_t>(tTop + y) * aTarget->Width);
+        }
+    }
+
+    return true;
+}
+
+bart::SoftwareGraphics::CachedText* bart::SoftwareGraphics::GetCachedText(const size_t aFace, const string& aText, const int aWrapWidth)
+{
+    size_t tHashKey = std::hash<std::string>()(aText);
+    tHashKey ^= aFace + 0x9e3779b9 + (tHashKey << 6) + (tHashKey >> 2);
+    tHashKey ^= static_cast<size_t>(aWrapWidth) + 0x9e3779b9 + (tHashKey << 6) + (tHashKey >> 2);
+
+    CachedText* tText = nullptr;
+    TTextMap::iterator tItr = m_TextCache.find(tHashKey);
+
+    if (tItr != m_TextCache.end())
+    {
+        tText = tItr->second;
+        if (tText->Face == aFace && tText->WrapWidth == aWrapWidth && tText->Text == aText)
+        {
+            tText->LastUsedFrame = m_FrameCount;
+            return tText;
+        }
+
+        // Hash collision, the slot is reused for the new string once nothing reads the old pixels
+        m_Rasterizer.Flush();
+        delete tText->Surface;
+        tText->Surface = nullptr;
+    }
+    else
+    {
+        tText = new CachedText();
+        m_TextCache[tHashKey] = tText;
+    }
+
+    tText->Face = aFace;
+    tText->Text = aText;
+    tText->WrapWidth = aWrapWidth;
+    tText->LastUsedFrame = m_FrameCount;
+
+    SoftwareSurface* tSurface = new SoftwareSurface();
+    if (RenderText(m_FaceCache[aFace]->Data, aText, aWrapWidth, tSurface))
+    {
+        tText->Surface = tSurface;
+    }
+    else
+    {
+        delete tSurface;
+    }
+
+    m_Stats.Add(TEXT_RASTERIZED);
+    return tText;
+}
+
+void bart::SoftwareGraphics::EvictCachedText(const bool aAll, const size_t aFace)
+{
+    for (TTextMap::iterator tItr = m_TextCache.begin(); tItr != m_TextCache.end();)
+    {
+        CachedText* tText = tItr->second;
+        const bool tExpired = m_FrameCount - tText->LastUsedFrame > TEXT_CACHE_LIFETIME;
+
+        if (aAll || tText->Face == aFace || (aFace == 0 && tExpired))
+        {
+            delete tText->Surface;
+            delete tText;
+            tItr = m_TextCache.erase(tItr);
+        }
+        else
+        {
+            ++tItr;
+        }
+    }
+}
+
+bart::RenderStats& bart::SoftwareGraphics::GetRenderStats()
+{
+    return m_Stats;
+}
+
+void bart::SoftwareGraphics::ShowRenderStats(const size_t aFont)
+{
+    m_StatsFont = aFont;
+}
+
+void bart::SoftwareGraphics::CountDraw(const ERenderCounter aCounter, const int aX, const int aY, const int aWidth, const int aHeight)
+{
+    m_Stats.Add(aCounter);
+    CountPixels(aX, aY, aWidth, aHeight);
+}
+
+void bart::SoftwareGraphics::CountPixels(const int aX, const int aY, const int aWidth, const int aHeight)
+{
+    const int tScreenWidth = static_cast<int>(static_cast<float>(m_ScreenWidth) / m_ScaleX);
+    const int tScreenHeight = static_cast<int>(static_cast<float>(m_ScreenHeight) / m_ScaleY);
+    const int tLeft = std::max(aX, 0);
+    const int tTop = std::max(aY, 0);
+    const int tRight = std::min(aX + aWidth, tScreenWidth);
+    const int tBottom = std::min(aY + aHeight, tScreenHeight);
+
+    if (tRight > tLeft && tBottom > tTop)
+    {
+        const float tArea = static_cast<float>(tRight - tLeft) * static_cast<float>(tBottom - tTop);
+        m_Stats.Add(PIXELS_FILLED, static_cast<unsigned long long>(tArea * m_ScaleX * m_ScaleY));
+
+        if (m_RenderTarget == 0)
+        {
+            m_Overdraw.Add(tLeft, tTop, tRight - tLeft, tBottom - tTop);
+        }
+    }
+}
+
+void bart::SoftwareGraphics::DrawRenderStats()
+{
+    if (m_FntCache.count(m_StatsFont) == 0 || m_RenderTarget != 0)
+    {
+        return;
+    }
+
+    // Rendered every frame outside of the text cache and of the counters
+    std::string tText = m_Stats.ToString();
+    if (m_Overdraw.IsEnabled())
+    {
+        tText += m_Overdraw.ToString();
+    }
+
+    if (!RenderText(m_FntCache[m_StatsFont]->Data, tText, 0, &m_StatsSurface))
+    {
+        return;
+    }
+
+    const Color tDrawColor = m_DrawColor;
+    m_DrawColor.Set(0, 0, 0, 160);
+
+    RasterCommand tBackground;
+    Submit(tBackground, 0.0f, 0.0f, static_cast<float>(m_StatsSurface.Width + 20), static_cast<float>(m_StatsSurface.Height + 20));
+    m_DrawColor = tDrawColor;
+
+    RasterCommand tCommand;
+    tCommand.Source = &m_StatsSurface;
+    tCommand.SrcW = m_StatsSurface.Width;
+    tCommand.SrcH = m_StatsSurface.Height;
+    tCommand.Color = 0xFFFFFF00;
+    Submit(tCommand, 10.0f, 10.0f, static_cast<float>(m_StatsSurface.Width), static_cast<float>(m_StatsSurface.Height));
+}
+
+bart::OverdrawAnalyzer& bart::SoftwareGraphics::GetOverdrawAnalyzer()
+{
+    return m_Overdraw;
+}
+
+void bart::SoftwareGraphics::ShowOverdraw(const bool aEnabled)
+{
+    m_Overdraw.SetEnabled(aEnabled);
+
+    if (aEnabled)
+    {
+        m_Overdraw.Resize(static_cast<int>(static_cast<float>(m_ScreenWidth) / m_ScaleX),
+                          static_cast<int>(static_cast<float>(m_ScreenHeight) / m_ScaleY));
+    }
+    else
+    {
+        m_Rasterizer.Flush();
+        m_HeatmapSurface.Pixels.clear();
+        m_HeatmapSurface.Width = 0;
+        m_HeatmapSurface.Height = 0;
+    }
+}
+
+void bart::SoftwareGraphics::DrawOverdraw()
+{
+    const int tWidth = m_Overdraw.GetWidth();
+    const int tHeight = m_Overdraw.GetHeight();
+
+    if (tWidth <= 0 || tHeight <= 0 || m_RenderTarget != 0)
+    {
+        return;
+    }
+
+    // The heat map is ARGB like the frame, it is blended in as is
+    m_Overdraw.GetHeatmap(&m_HeatmapSurface.Pixels);
+    m_HeatmapSurface.Width = tWidth;
+    m_HeatmapSurface.Height = tHeight;
+
+    RasterCommand tCommand;
+    tCommand.Source = &m_HeatmapSurface;
+    tCommand.SrcW = tWidth;
+    tCommand.SrcH = tHeight;
+    tCommand.Color = 220u << 24 | 0x00FFFFFF;
+    Submit(tCommand, 0.0f, 0.0f, static_cast<float>(tWidth), static_cast<float>(tHeight));
+}
\ No newline at end of file
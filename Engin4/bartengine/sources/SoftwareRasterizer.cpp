@@ -0,0 +1,507 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: SoftwareRasterizer.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <SoftwareRasterizer.h>
+#include <algorithm>
+#include <cmath>
+#include <emmintrin.h>
+
+const int bart::SoftwareRasterizer::TILE_SIZE = 64;
+
+namespace
+{
+    // x / 255 rounded to nearest, exact for every product of two bytes
+    inline unsigned int Div255(unsigned int aValue)
+    {
+        aValue += 128;
+        return (aValue + (aValue >> 8)) >> 8;
+    }
+
+    inline __m128i Div255(__m128i aValue)
+    {
+        aValue = _mm_add_epi16(aValue, _mm_set1_epi16(128));
+        return _mm_srli_epi16(_mm_add_epi16(aValue, _mm_srli_epi16(aValue, 8)), 8);
+    }
+
+    // Modulates a source pixel and writes it over the destination, the scalar twin of ShadePixels
+    inline unsigned int ShadePixel(const unsigned int aSrc, const unsigned int aDst, const unsigned int aMod, const bool aBlend)
+    {
+        const unsigned int tA = Div255((aSrc >> 24) * (aMod >> 24));
+        const unsigned int tR = Div255(((aSrc >> 16) & 0xFF) * ((aMod >> 16) & 0xFF));
+        const unsigned int tG = Div255(((aSrc >> 8) & 0xFF) * ((aMod >> 8) & 0xFF));
+        const unsigned int tB = Div255((aSrc & 0xFF) * (aMod & 0xFF));
+
+        if (!aBlend)
+        {
+            return tA << 24 | tR << 16 | tG << 8 | tB;
+        }
+
+        const unsigned int tInverse = 255 - tA;
+        const unsigned int tOutA = Div255(255 * tA + (aDst >> 24) * tInverse);
+        const unsigned int tOutR = Div255(tR * tA + ((aDst >> 16) & 0xFF) * tInverse);
+        const unsigned int tOutG = Div255(tG * tA + ((aDst >> 8) & 0xFF) * tInverse);
+        const unsigned int tOutB = Div255(tB * tA + (aDst & 0xFF) * tInverse);
+
+        return tOutA << 24 | tOutR << 16 | tOutG << 8 | tOutB;
+    }
+
+    // 4 pixels at once, each channel is widened to 16 bits
+    inline __m128i ShadePixels(const __m128i aSrc, const __m128i aDst, const __m128i aMod, const bool aBlend)
+    {
+        const __m128i tZero = _mm_setzero_si128();
+        const __m128i tSrcLo = Div255(_mm_mullo_epi16(_mm_unpacklo_epi8(aSrc, tZero), aMod));
+        const __m128i tSrcHi = Div255(_mm_mullo_epi16(_mm_unpackhi_epi8(aSrc, tZero), aMod));
+
+        if (!aBlend)
+        {
+            return _mm_packus_epi16(tSrcLo, tSrcHi);
+        }
+
+        // The alpha lane of the source counts as 255 so the result alpha is a + dst * (1 - a)
+        const __m128i tColorMask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+        const __m128i tAlphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+        const __m128i tMax = _mm_set1_epi16(255);
+
+        const __m128i tAlphaLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(tSrcLo, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i tAlphaHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(tSrcHi, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128i tColorLo = _mm_or_si128(_mm_and_si128(tSrcLo, tColorMask), tAlphaOne);
+        const __m128i tColorHi = _mm_or_si128(_mm_and_si128(tSrcHi, tColorMask), tAlphaOne);
+
+        const __m128i tDstLo = _mm_unpacklo_epi8(aDst, tZero);
+        const __m128i tDstHi = _mm_unpackhi_epi8(aDst, tZero);
+
+        const __m128i tOutLo = Div255(_mm_add_epi16(_mm_mullo_epi16(tColorLo, tAlphaLo), _mm_mullo_epi16(tDstLo, _mm_sub_epi16(tMax, tAlphaLo))));
+        const __m128i tOutHi = Div255(_mm_add_epi16(_mm_mullo_epi16(tColorHi, tAlphaHi), _mm_mullo_epi16(tDstHi, _mm_sub_epi16(tMax, tAlphaHi))));
+
+        return _mm_packus_epi16(tOutLo, tOutHi);
+    }
+}
+
+bart::SoftwareRasterizer::~SoftwareRasterizer()
+{
+    Stop();
+}
+
+void bart::SoftwareRasterizer::Start(const int aThreadCount)
+{
+    Stop();
+
+    int tThreadCount = aThreadCount;
+    if (tThreadCount <= 0)
+    {
+        tThreadCount = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+
+    // The thread calling Flush works too, the workers wait for the flush after the last one it ran
+    m_Stopping = false;
+    for (int i = 1; i < tThreadCount; i++)
+    {
+        m_Workers.push_back(std::thread(&SoftwareRasterizer::WorkerLoop, this, m_Generation));
+    }
+}
+
+void bart::SoftwareRasterizer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> tLock(m_Mutex);
+        m_Stopping = true;
+    }
+
+    m_StartSignal.notify_all();
+
+    for (std::thread& tWorker : m_Workers)
+    {
+        tWorker.join();
+    }
+
+    m_Workers.clear();
+    m_Commands.clear();
+    m_CommandBounds.clear();
+}
+
+void bart::SoftwareRasterizer::SetTarget(SoftwareSurface* aTarget)
+{
+    if (aTarget != m_Target)
+    {
+        Flush();
+        m_Target = aTarget;
+    }
+}
+
+void bart::SoftwareRasterizer::Submit(const RasterCommand& aCommand)
+{
+    if (m_Target == nullptr || aCommand.DstW <= 0 || aCommand.DstH <= 0)
+    {
+        return;
+    }
+
+    RasterCommand tCommand = aCommand;
+
+    if (tCommand.Source != nullptr)
+    {
+        // Like SDL, a source rectangle going out of the surface is clipped and the destination follows
+        const int tLeft = std::max(tCommand.SrcX, 0);
+        const int tTop = std::max(tCommand.SrcY, 0);
+        const int tRight = std::min(tCommand.SrcX + tCommand.SrcW, tCommand.Source->Width);
+        const int tBottom = std::min(tCommand.SrcY + tCommand.SrcH, tCommand.Source->Height);
+
+        if (tRight <= tLeft || tBottom <= tTop)
+        {
+            return;
+        }
+
+        if (tLeft != tCommand.SrcX || tTop != tCommand.SrcY || tRight - tLeft != tCommand.SrcW || tBottom - tTop != tCommand.SrcH)
+        {
+            tCommand.DstX += (tLeft - tCommand.SrcX) * tCommand.DstW / tCommand.SrcW;
+            tCommand.DstY += (tTop - tCommand.SrcY) * tCommand.DstH / tCommand.SrcH;
+            tCommand.DstW = (tRight - tLeft) * tCommand.DstW / tCommand.SrcW;
+            tCommand.DstH = (tBottom - tTop) * tCommand.DstH / tCommand.SrcH;
+            tCommand.SrcX = tLeft;
+            tCommand.SrcY = tTop;
+            tCommand.SrcW = tRight - tLeft;
+            tCommand.SrcH = tBottom - tTop;
+        }
+
+        if (tCommand.DstW <= 0 || tCommand.DstH <= 0)
+        {
+            return;
+        }
+    }
+
+    Bounds tBounds;
+    if (!GetBounds(tCommand, &tBounds))
+    {
+        return;
+    }
+
+    tBounds.MinX = std::max(tBounds.MinX, std::max(tCommand.ClipX, 0));
+    tBounds.MinY = std::max(tBounds.MinY, std::max(tCommand.ClipY, 0));
+    tBounds.MaxX = std::min(tBounds.MaxX, std::min(tCommand.ClipX + tCommand.ClipW, m_Target->Width));
+    tBounds.MaxY = std::min(tBounds.MaxY, std::min(tCommand.ClipY + tCommand.ClipH, m_Target->Height));
+
+    if (tBounds.MaxX > tBounds.MinX && tBounds.MaxY > tBounds.MinY)
+    {
+        m_Commands.push_back(tCommand);
+        m_CommandBounds.push_back(tBounds);
+    }
+}
+
+void bart::SoftwareRasterizer::Flush()
+{
+    if (m_Commands.empty() || m_Target == nullptr)
+    {
+        m_Commands.clear();
+        m_CommandBounds.clear();
+        return;
+    }
+
+    m_TileColumns = (m_Target->Width + TILE_SIZE - 1) / TILE_SIZE;
+    m_TileRows = (m_Target->Height + TILE_SIZE - 1) / TILE_SIZE;
+
+    const size_t tTileCount = static_cast<size_t>(m_TileColumns) * m_TileRows;
+    if (m_Bins.size() < tTileCount)
+    {
+        m_Bins.resize(tTileCount);
+    }
+
+    for (size_t i = 0; i < tTileCount; i++)
+    {
+        m_Bins[i].clear();
+    }
+
+    for (size_t i = 0; i < m_Commands.size(); i++)
+    {
+        const Bounds& tBounds = m_CommandBounds[i];
+        const int tToX = (tBounds.MaxX - 1) / TILE_SIZE;
+        const int tToY = (tBounds.MaxY - 1) / TILE_SIZE;
+
+        for (int y = tBounds.MinY / TILE_SIZE; y <= tToY; y++)
+        {
+            for (int x = tBounds.MinX / TILE_SIZE; x <= tToX; x++)
+            {
+                m_Bins[y * m_TileColumns + x].push_back(static_cast<unsigned int>(i));
+            }
+        }
+    }
+
+    m_NextTile = 0;
+
+    if (m_Workers.empty())
+    {
+        RasterizeTiles();
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> tLock(m_Mutex);
+            m_Generation++;
+            m_Busy = static_cast<int>(m_Workers.size());
+        }
+
+        m_StartSignal.notify_all();
+        RasterizeTiles();
+
+        std::unique_lock<std::mutex> tLock(m_Mutex);
+        m_DoneSignal.wait(tLock, [this]() { return m_Busy == 0; });
+    }
+
+    m_Commands.clear();
+    m_CommandBounds.clear();
+}
+
+void bart::SoftwareRasterizer::WorkerLoop(const unsigned int aGeneration)
+{
+    // Taken when the worker is created, a flush issued before the thread runs is not missed
+    unsigned int tGeneration = aGeneration;
+
+    for (;;)
+    {
+        std::unique_lock<std::mutex> tLock(m_Mutex);
+        m_StartSignal.wait(tLock, [this, tGeneration]() { return m_Stopping || m_Generation != tGeneration; });
+
+        if (m_Stopping)
+        {
+            return;
+        }
+
+        tGeneration = m_Generation;
+        tLock.unlock();
+
+        RasterizeTiles();
+
+        tLock.lock();
+        m_Busy--;
+        if (m_Busy == 0)
+        {
+            m_DoneSignal.notify_one();
+        }
+    }
+}
+
+void bart::SoftwareRasterizer::RasterizeTiles()
+{
+    const int tTileCount = m_TileColumns * m_TileRows;
+
+    for (int tTile = m_NextTile++; tTile < tTileCount; tTile = m_NextTile++)
+    {
+        RasterizeTile(tTile);
+    }
+}
+
+void bart::SoftwareRasterizer::RasterizeTile(const int aTile)
+{
+    const int tTileX = (aTile % m_TileColumns) * TILE_SIZE;
+    const int tTileY = (aTile / m_TileColumns) * TILE_SIZE;
+
+    for (unsigned int tIndex : m_Bins[aTile])
+    {
+        const Bounds& tBounds = m_CommandBounds[tIndex];
+        Bounds tArea;
+        tArea.MinX = std::max(tBounds.MinX, tTileX);
+        tArea.MinY = std::max(tBounds.MinY, tTileY);
+        tArea.MaxX = std::min(tBounds.MaxX, tTileX + TILE_SIZE);
+        tArea.MaxY = std::min(tBounds.MaxY, tTileY + TILE_SIZE);
+
+        if (m_Commands[tIndex].Angle != 0.0f)
+        {
+            ExecuteRotated(m_Commands[tIndex], tArea);
+        }
+        else
+        {
+            Execute(m_Commands[tIndex], tArea);
+        }
+    }
+}
+
+void bart::SoftwareRasterizer::Execute(const RasterCommand& aCommand, const Bounds& aArea) const
+{
+    // A fill is a source of one color that is not modulated
+    const unsigned int tScalarMod = aCommand.Source == nullptr ? 0xFFFFFFFF : aCommand.Color;
+    const __m128i tMod = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(tScalarMod)), _mm_setzero_si128());
+    const __m128i tFill = _mm_set1_epi32(static_cast<int>(aCommand.Color));
+    const bool tScaled = aCommand.Source != nullptr && aCommand.SrcW != aCommand.DstW;
+
+    for (int y = aArea.MinY; y < aArea.MaxY; y++)
+    {
+        unsigned int* tDstRow = &m_Target->Pixels[static_cast<size_t>(y) * m_Target->Width];
+        const unsigned int* tSrcRow = nullptr;
+
+        if (aCommand.Source != nullptr)
+        {
+            // Nearest sampling at the pixel centers
+            int tRow = ((y - aCommand.DstY) * 2 + 1) * aCommand.SrcH / (aCommand.DstH * 2);
+            if (aCommand.VerticalFlip)
+            {
+                tRow = aCommand.SrcH - 1 - tRow;
+            }
+
+            tSrcRow = &aCommand.Source->Pixels[static_cast<size_t>(aCommand.SrcY + tRow) * aCommand.Source->Width + aCommand.SrcX];
+        }
+
+        int x = aArea.MinX;
+        for (; x + 4 <= aArea.MaxX; x += 4)
+        {
+            __m128i tSrc;
+
+            if (tSrcRow == nullptr)
+            {
+                tSrc = tFill;
+            }
+            else if (!tScaled)
+            {
+                const int tColumn = x - aCommand.DstX;
+                if (aCommand.HorizontalFlip)
+                {
+                    tSrc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tSrcRow + aCommand.SrcW - 4 - tColumn));
+                    tSrc = _mm_shuffle_epi32(tSrc, _MM_SHUFFLE(0, 1, 2, 3));
+                }
+                else
+                {
+                    tSrc = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tSrcRow + tColumn));
+                }
+            }
+            else
+            {
+                int tColumns[4];
+                for (int i = 0; i < 4; i++)
+                {
+                    tColumns[i] = ((x + i - aCommand.DstX) * 2 + 1) * aCommand.SrcW / (aCommand.DstW * 2);
+                    if (aCommand.HorizontalFlip)
+                    {
+                        tColumns[i] = aCommand.SrcW - 1 - tColumns[i];
+                    }
+                }
+
+                tSrc = _mm_set_epi32(static_cast<int>(tSrcRow[tColumns[3]]), static_cast<int>(tSrcRow[tColumns[2]]),
+                                     static_cast<int>(tSrcRow[tColumns[1]]), static_cast<int>(tSrcRow[tColumns[0]]));
+            }
+
+            __m128i* tDst = reinterpret_cast<__m128i*>(tDstRow + x);
+            _mm_storeu_si128(tDst, ShadePixels(tSrc, _mm_loadu_si128(tDst), tMod, aCommand.Blend));
+        }
+
+        for (; x < aArea.MaxX; x++)
+        {
+            unsigned int tSrc = aCommand.Color;
+
+            if (tSrcRow != nullptr)
+            {
+                int tColumn = ((x - aCommand.DstX) * 2 + 1) * aCommand.SrcW / (aCommand.DstW * 2);
+                if (aCommand.HorizontalFlip)
+                {
+                    tColumn = aCommand.SrcW - 1 - tColumn;
+                }
+
+                tSrc = tSrcRow[tColumn];
+            }
+
+            tDstRow[x] = ShadePixel(tSrc, tDstRow[x], tScalarMod, aCommand.Blend);
+        }
+    }
+}
+
+void bart::SoftwareRasterizer::ExecuteRotated(const RasterCommand& aCommand, const Bounds& aArea) const
+{
+    const float tRadians = aCommand.Angle * 3.14159265f / 180.0f;
+    const float tCos = std::cos(tRadians);
+    const float tSin = std::sin(tRadians);
+    const float tHalfWidth = static_cast<float>(aCommand.DstW) * 0.5f;
+    const float tHalfHeight = static_cast<float>(aCommand.DstH) * 0.5f;
+    const float tCenterX = static_cast<float>(aCommand.DstX) + tHalfWidth;
+    const float tCenterY = static_cast<float>(aCommand.DstY) + tHalfHeight;
+    const unsigned int tMod = aCommand.Source == nullptr ? 0xFFFFFFFF : aCommand.Color;
+
+    for (int y = aArea.MinY; y < aArea.MaxY; y++)
+    {
+        unsigned int* tDstRow = &m_Target->Pixels[static_cast<size_t>(y) * m_Target->Width];
+        const float tDy = static_cast<float>(y) + 0.5f - tCenterY;
+
+        for (int x = aArea.MinX; x < aArea.MaxX; x++)
+        {
+            // Back in the unrotated destination rectangle
+            const float tDx = static_cast<float>(x) + 0.5f - tCenterX;
+            const float tLocalX = tDx * tCos + tDy * tSin + tHalfWidth;
+            const float tLocalY = -tDx * tSin + tDy * tCos + tHalfHeight;
+
+            if (tLocalX < 0.0f || tLocalY < 0.0f || tLocalX >= static_cast<float>(aCommand.DstW) ||
+                tLocalY >= static_cast<float>(aCommand.DstH))
+            {
+                continue;
+            }
+
+            unsigned int tSrc = aCommand.Color;
+
+            if (aCommand.Source != nullptr)
+            {
+                int tColumn = std::min(static_cast<int>(tLocalX * aCommand.SrcW / aCommand.DstW), aCommand.SrcW - 1);
+                int tRow = std::min(static_cast<int>(tLocalY * aCommand.SrcH / aCommand.DstH), aCommand.SrcH - 1);
+
+                if (aCommand.HorizontalFlip)
+                {
+                    tColumn = aCommand.SrcW - 1 - tColumn;
+                }
+
+                if (aCommand.VerticalFlip)
+                {
+                    tRow = aCommand.SrcH - 1 - tRow;
+                }
+
+                tSrc = aCommand.Source->Pixels[static_cast<size_t>(aCommand.SrcY + tRow) * aCommand.Source->Width + aCommand.SrcX + tColumn];
+            }
+
+            tDstRow[x] = ShadePixel(tSrc, tDstRow[x], tMod, aCommand.Blend);
+        }
+    }
+}
+
+bool bart::SoftwareRasterizer::GetBounds(const RasterCommand& aCommand, Bounds* aBounds)
+{
+    if (aCommand.Angle == 0.0f)
+    {
+        aBounds->MinX = aCommand.DstX;
+        aBounds->MinY = aCommand.DstY;
+        aBounds->MaxX = aCommand.DstX + aCommand.DstW;
+        aBounds->MaxY = aCommand.DstY + aCommand.DstH;
+        return true;
+    }
+
+    const float tRadians = aCommand.Angle * 3.14159265f / 180.0f;
+    const float tCos = std::fabs(std::cos(tRadians));
+    const float tSin = std::fabs(std::sin(tRadians));
+    const float tHalfWidth = static_cast<float>(aCommand.DstW) * 0.5f;
+    const float tHalfHeight = static_cast<float>(aCommand.DstH) * 0.5f;
+    const float tCenterX = static_cast<float>(aCommand.DstX) + tHalfWidth;
+    const float tCenterY = static_cast<float>(aCommand.DstY) + tHalfHeight;
+    const float tExtentX = tHalfWidth * tCos + tHalfHeight * tSin;
+    const float tExtentY = tHalfWidth * tSin + tHalfHeight * tCos;
+
+    aBounds->MinX = static_cast<int>(std::floor(tCenterX - tExtentX));
+    aBounds->MinY = static_cast<int>(std::floor(tCenterY - tExtentY));
+    aBounds->MaxX = static_cast<int>(std::ceil(tCenterX + tExtentX));
+    aBounds->MaxY = static_cast<int>(std::ceil(tCenterY + tExtentY));
+    return true;
+}
\ No newline at end of file
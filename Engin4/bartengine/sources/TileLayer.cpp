@@ -4,11 +4,19 @@
 #include <tinyxml2.h>
 #include <MathHelper.h>
 #include <iostream>
+#include <Camera.h>
+#include <Color.h>
+#include <algorithm>
 
 const unsigned FLIPPED_HORIZONTALLY_FLAG = 0x80000000;
 const unsigned FLIPPED_VERTICALLY_FLAG = 0x40000000;
 const unsigned FLIPPED_DIAGONALLY_FLAG = 0x20000000;
 
+const int bart::TileLayer::LOD_CHUNK_SIZE = 16;
+const int bart::TileLayer::LOD_TILE_SIZE = 8;
+const int bart::TileLayer::MAX_LOD_LEVEL = 4;
+const int bart::TileLayer::OCCLUSION_CHUNK_SIZE = 8;
+
 bool bart::TileLayer::Load(XMLNode* aNode, Tileset* aTileset, const int aTileWidth, const int aTileHeight)
 {
     m_TileWidth = aTileWidth;
@@ -45,6 +53,38 @@ bool bart::TileLayer::Load(XMLNode* aNode, Tileset* aTileset, const int aTileWid
 
     m_TilesetPtr = aTileset;
 
+    m_ChunkColumns = (m_Width + LOD_CHUNK_SIZE - 1) / LOD_CHUNK_SIZE;
+    m_ChunkRows = (m_Height + LOD_CHUNK_SIZE - 1) / LOD_CHUNK_SIZE;
+    m_Chunks.resize(m_ChunkColumns * m_ChunkRows);
+
+    for (TileChunk& tChunk : m_Chunks)
+    {
+        tChunk.Textures.resize(MAX_LOD_LEVEL + 1, 0);
+        tChunk.DirtyLevels = ~0u;
+    }
+
+    if (m_TilesetPtr->HasAnimations())
+    {
+        for (int y = 0; y < m_ChunkRows; y++)
+        {
+            for (int x = 0; x < m_ChunkColumns; x++)
+            {
+                UpdateChunkAnimations(x, y);
+            }
+        }
+    }
+
+    m_OcclusionColumns = (m_Width + OCCLUSION_CHUNK_SIZE - 1) / OCCLUSION_CHUNK_SIZE;
+    m_OpaqueMasks.assign(m_OcclusionColumns * ((m_Height + OCCLUSION_CHUNK_SIZE - 1) / OCCLUSION_CHUNK_SIZE), 0);
+
+    for (int y = 0; y < static_cast<int>(mLayerData.size()); y++)
+    {
+        for (int x = 0; x < m_Width; x++)
+        {
+            UpdateOpaqueMask(x, y);
+        }
+    }
+
     return true;
 }
 
@@ -57,89 +97,296 @@ void bart::TileLayer::Draw(const Rectangle& aViewport)
         const int tToX = MathHelper::Clamp((aViewport.X + aViewport.W) / m_TileWidth, tFromX, m_Width);
         const int tToY = MathHelper::Clamp((aViewport.Y + aViewport.H) / m_TileHeight, tFromY, m_Height);
 
-        if (tFromX < tToX && tFromY < tToY)
+        if (tFromX < tToX && tFromY < tToY && mLayerData.size() > 0)
+        {
+            InvalidateAnimatedChunks();
+            const int tLevel = GetLodLevel();
+
+            if (tLevel > 0)
+            {
+                DrawChunks(tFromX, tFromY, tToX, tToY, tLevel);
+            }
+            else
+            {
+                DrawTiles(tFromX, tFromY, tToX, tToY);
+            }
+        }
+    }
+}
+
+void bart::TileLayer::SetValueAt(const int aX, const int aY, const int aValue)
+{
+    mLayerData[aY][aX]->Index = aValue;
+
+    if (!m_Chunks.empty())
+    {
+        m_Chunks[(aY / LOD_CHUNK_SIZE) * m_ChunkColumns + aX / LOD_CHUNK_SIZE].DirtyLevels = ~0u;
+        UpdateChunkAnimations(aX / LOD_CHUNK_SIZE, aY / LOD_CHUNK_SIZE);
+    }
+
+    UpdateOpaqueMask(aX, aY);
+    m_Revision++;
+}
+
+void bart::TileLayer::DrawTiles(const int aFromX, const int aFromY, const int aToX, const int aToY)
+{
+    for (int y = aFromY; y < aToY; y++)
+    {
+        const int tY = y * m_TileHeight + static_cast<int>(m_VerticalOffset);
+        for (int x = aFromX; x < aToX; x++)
+        {
+            if (!IsOccluded(x, y))
+            {
+                DrawTile(x, y, x * m_TileWidth + static_cast<int>(m_HorizontalOffset), tY, 0, m_Alpha);
+            }
+        }
+    }
+
+    Engine::Instance().GetGraphic().SetBlending(true);
+}
+
+void bart::TileLayer::DrawChunks(const int aFromX, const int aFromY, const int aToX, const int aToY, const int aLevel)
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+
+    const int tChunkWidth = LOD_CHUNK_SIZE * m_TileWidth;
+    const int tChunkHeight = LOD_CHUNK_SIZE * m_TileHeight;
+    const int tFromX = aFromX / LOD_CHUNK_SIZE;
+    const int tFromY = aFromY / LOD_CHUNK_SIZE;
+    const int tToX = (aToX + LOD_CHUNK_SIZE - 1) / LOD_CHUNK_SIZE;
+    const int tToY = (aToY + LOD_CHUNK_SIZE - 1) / LOD_CHUNK_SIZE;
+
+    Rectangle tSrc;
+    Rectangle tDest;
+    tSrc.Set(0, 0, tChunkWidth >> aLevel, tChunkHeight >> aLevel);
+
+    for (int y = tFromY; y < tToY; y++)
+    {
+        for (int x = tFromX; x < tToX; x++)
         {
-            IGraphic& tGraphic = Engine::Instance().GetGraphic();
+            TileChunk& tChunk = m_Chunks[y * m_ChunkColumns + x];
+
+            if (tChunk.DirtyLevels & (1u << aLevel))
+            {
+                BakeChunk(tChunk, x, y, aLevel);
+            }
+
+            if (tChunk.Textures[aLevel] != 0)
+            {
+                tDest.Set(x * tChunkWidth + static_cast<int>(m_HorizontalOffset),
+                          y * tChunkHeight + static_cast<int>(m_VerticalOffset), tChunkWidth, tChunkHeight);
+                tGraphic.Draw(tChunk.Textures[aLevel], tSrc, tDest, 0.0f, false, false, m_Alpha);
+            }
+            else
+            {
+                // No render target available, the tiles of the chunk are drawn one by one
+                DrawTiles(x * LOD_CHUNK_SIZE, y * LOD_CHUNK_SIZE, std::min((x + 1) * LOD_CHUNK_SIZE, m_Width),
+                          std::min((y + 1) * LOD_CHUNK_SIZE, m_Height));
+            }
+        }
+    }
+}
+
+void bart::TileLayer::DrawTile(const int aX, const int aY, const int aDestX, const int aDestY, const int aLevel, const unsigned char aAlpha)
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+
+    Rectangle tDest;
+    tDest.Set(aDestX, aDestY, m_TileWidth >> aLevel, m_TileHeight >> aLevel);
+
+    const TileInfo* tInfo = mLayerData[aY][aX];
+    const int tIndex = m_TilesetPtr->Remap(tInfo->Index);
+    bool tInvalidTile = false;
 
-            Rectangle tDest;
-            int tIndex = 0;
-            int tY = 0;
+    if (tIndex > 0)
+    {
+        Tile* tTile = m_TilesetPtr->GetTile(tIndex);
+
+        if (tTile != nullptr)
+        {
+            tDest.W = tTile->Bounds.W >> aLevel;
+            tDest.H = tTile->Bounds.H >> aLevel;
+            tGraphic.SetBlending(!tTile->Opaque);
 
-            const size_t tDataSize = mLayerData.size();
-            if (tDataSize > 0)
+            if (tInfo->DiagonalFlip)
             {
-                for (int y = tFromY; y < tToY; y++)
+                if (tInfo->HorizontalFlip && tInfo->VerticalFlip)
                 {
-                    tY = y * m_TileHeight;
-                    for (int x = tFromX; x < tToX; x++)
-                    {
-                        tDest.X = x * m_TileWidth + static_cast<int>(m_HorizontalOffset);
-                        tDest.Y = tY + static_cast<int>(m_VerticalOffset);
-
-                        tIndex = mLayerData[y][x]->Index;
-                        bool tInvalidTile = false;
-
-                        if (tIndex > 0)
-                        {
-                            Tile* tTile = m_TilesetPtr->GetTile(tIndex);
-
-                            if (tTile != nullptr)
-                            {
-                                tDest.W = tTile->Bounds.W;
-                                tDest.H = tTile->Bounds.H;
-
-                                if (mLayerData[y][x]->DiagonalFlip)
-                                {
-                                    if (mLayerData[y][x]->HorizontalFlip && mLayerData[y][x]->VerticalFlip)
-                                    {
-                                        tGraphic.Draw(
-                                            tTile->Texture, tTile->Bounds, tDest, -90.0f, false, true, m_Alpha);
-                                    }
-                                    else if (mLayerData[y][x]->VerticalFlip)
-                                    {
-                                        tGraphic.Draw(
-                                            tTile->Texture, tTile->Bounds, tDest, -90.0f, false, false, m_Alpha);
-                                    }
-                                    else if (mLayerData[y][x]->HorizontalFlip)
-                                    {
-                                        tGraphic.Draw(
-                                            tTile->Texture, tTile->Bounds, tDest, 90.0f, false, false, m_Alpha);
-                                    }
-
-                                    else
-                                    {
-                                        tGraphic.Draw(
-                                            tTile->Texture, tTile->Bounds, tDest, -90.0f, true, false, m_Alpha);
-                                    }
-                                }
-                                else
-                                {
-                                    tGraphic.Draw(
-                                        tTile->Texture, tTile->Bounds, tDest, 0.0f, mLayerData[y][x]->HorizontalFlip,
-                                        mLayerData[y][x]->VerticalFlip, m_Alpha);
-                                }
-                            }
-                            else
-                            {
-                                tInvalidTile = true;
-                            }
-                        }
-                        else if (tIndex < 0)
-                        {
-                            tInvalidTile = true;
-                        }
-
-                        if (tInvalidTile)
-                        {
-                            // Unsupported map is a red rectangle in game:
-                            tGraphic.SetColor(255, 0, 0, 255);
-                            tGraphic.Fill(tDest);
-                        }
-                    }
+                    tGraphic.Draw(tTile->Texture, tTile->Bounds, tDest, -90.0f, false, true, aAlpha);
                 }
+                else if (tInfo->VerticalFlip)
+                {
+                    tGraphic.Draw(tTile->Texture, tTile->Bounds, tDest, -90.0f, false, false, aAlpha);
+                }
+                else if (tInfo->HorizontalFlip)
+                {
+                    tGraphic.Draw(tTile->Texture, tTile->Bounds, tDest, 90.0f, false, false, aAlpha);
+                }
+                else
+                {
+                    tGraphic.Draw(tTile->Texture, tTile->Bounds, tDest, -90.0f, true, false, aAlpha);
+                }
+            }
+            else
+            {
+                tGraphic.Draw(tTile->Texture, tTile->Bounds, tDest, 0.0f, tInfo->HorizontalFlip, tInfo->VerticalFlip, aAlpha);
+            }
+        }
+        else
+        {
+            tInvalidTile = true;
+        }
+    }
+    else if (tIndex < 0)
+    {
+        tInvalidTile = true;
+    }
+
+    if (tInvalidTile)
+    {
+        // Unsupported map is a red rectangle in game:
+        tGraphic.SetColor(255, 0, 0, 255);
+        tGraphic.Fill(tDest);
+    }
+}
+
+void bart::TileLayer::BakeChunk(TileChunk& aChunk, const int aChunkX, const int aChunkY, const int aLevel)
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    aChunk.DirtyLevels &= ~(1u << aLevel);
+
+    if (aChunk.Textures[aLevel] == 0)
+    {
+        const int tWidth = std::max((LOD_CHUNK_SIZE * m_TileWidth) >> aLevel, 1);
+        const int tHeight = std::max((LOD_CHUNK_SIZE * m_TileHeight) >> aLevel, 1);
+        aChunk.Textures[aLevel] = tGraphic.CreateRenderTarget(tWidth, tHeight);
+
+        if (aChunk.Textures[aLevel] == 0)
+        {
+            return;
+        }
+    }
+
+    // The chunk is drawn in its own space, without the camera or the layer offset
+    const size_t tPreviousTarget = tGraphic.GetRenderTarget();
+    Camera* tCamera = tGraphic.GetCamera();
+    tGraphic.SetCamera(nullptr);
+    tGraphic.SetRenderTarget(aChunk.Textures[aLevel]);
+    tGraphic.Clear(Color(0, 0, 0, 0));
+
+    const int tFromX = aChunkX * LOD_CHUNK_SIZE;
+    const int tFromY = aChunkY * LOD_CHUNK_SIZE;
+    const int tToX = std::min(tFromX + LOD_CHUNK_SIZE, m_Width);
+    const int tToY = std::min(tFromY + LOD_CHUNK_SIZE, m_Height);
+
+    for (int y = tFromY; y < tToY; y++)
+    {
+        for (int x = tFromX; x < tToX; x++)
+        {
+            DrawTile(x, y, ((x - tFromX) * m_TileWidth) >> aLevel, ((y - tFromY) * m_TileHeight) >> aLevel, aLevel, 255);
+        }
+    }
+
+    tGraphic.SetBlending(true);
+    tGraphic.SetRenderTarget(tPreviousTarget);
+    tGraphic.SetCamera(tCamera);
+}
+
+int bart::TileLayer::GetLodLevel() const
+{
+    float tScaleX;
+    float tScaleY;
+    Engine::Instance().GetGraphic().GetViewportScale(&tScaleX, &tScaleY);
+
+    const int tTileSize = std::min(m_TileWidth, m_TileHeight);
+    const float tScreenSize = static_cast<float>(tTileSize) * std::min(tScaleX, tScaleY);
+
+    if (tScreenSize >= static_cast<float>(LOD_TILE_SIZE) || tScreenSize <= 0.0f)
+    {
+        return 0;
+    }
+
+    // The smallest level whose tiles are still at least as large as on screen
+    int tLevel = 0;
+    while (tLevel < MAX_LOD_LEVEL && tScreenSize * static_cast<float>(1 << (tLevel + 1)) <= static_cast<float>(tTileSize))
+    {
+        tLevel++;
+    }
+
+    return tLevel;
+}
+
+void bart::TileLayer::UpdateChunkAnimations(const int aChunkX, const int aChunkY)
+{
+    const int tChunk = aChunkY * m_ChunkColumns + aChunkX;
+    const bool tWasAnimated = m_Chunks[tChunk].Animations != 0;
+
+    const int tFromX = aChunkX * LOD_CHUNK_SIZE;
+    const int tFromY = aChunkY * LOD_CHUNK_SIZE;
+    const int tToX = std::min(tFromX + LOD_CHUNK_SIZE, m_Width);
+    const int tToY = std::min(tFromY + LOD_CHUNK_SIZE, std::min(m_Height, static_cast<int>(mLayerData.size())));
+
+    unsigned long long tAnimations = 0;
+    for (int y = tFromY; y < tToY; y++)
+    {
+        for (int x = tFromX; x < tToX; x++)
+        {
+            if (mLayerData[y][x] != nullptr)
+            {
+                tAnimations |= m_TilesetPtr->GetAnimationBit(mLayerData[y][x]->Index);
+            }
+        }
+    }
+
+    m_Chunks[tChunk].Animations = tAnimations;
+
+    if (tAnimations != 0 && !tWasAnimated)
+    {
+        m_AnimatedChunks.push_back(tChunk);
+    }
+    else if (tAnimations == 0 && tWasAnimated)
+    {
+        m_AnimatedChunks.erase(std::find(m_AnimatedChunks.begin(), m_AnimatedChunks.end(), tChunk));
+    }
+}
+
+void bart::TileLayer::InvalidateAnimatedChunks()
+{
+    const unsigned long long tChanged = m_TilesetPtr->GetChangedAnimations();
+    if (tChanged == 0)
+    {
+        return;
+    }
+
+    // The chunks without animated tiles keep their baked textures
+    for (const int tChunk : m_AnimatedChunks)
+    {
+        if (m_Chunks[tChunk].Animations & tChanged)
+        {
+            m_Chunks[tChunk].DirtyLevels = ~0u;
+        }
+    }
+}
+
+void bart::TileLayer::CleanChunks()
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+
+    for (TileChunk& tChunk : m_Chunks)
+    {
+        for (size_t tTexture : tChunk.Textures)
+        {
+            if (tTexture != 0)
+            {
+                tGraphic.UnloadTexture(tTexture);
             }
         }
     }
+
+    m_Chunks.clear();
+    m_AnimatedChunks.clear();
+    m_ChunkColumns = 0;
+    m_ChunkRows = 0;
 }
 
 int bart::TileLayer::IsColliding(const Rectangle& aCollider, int* aX, int* aY)
@@ -176,6 +423,77 @@ int bart::TileLayer::IsColliding(const Rectangle& aCollider)
     return IsColliding(aCollider, &tX, &tY);
 }
 
+bool bart::TileLayer::CanOcclude() const
+{
+    // Offset or translucent layers do not cover the cells of the layers below
+    return m_Visible && m_Alpha == 255 && m_HorizontalOffset == 0.0f && m_VerticalOffset == 0.0f;
+}
+
+bool bart::TileLayer::IsOpaqueAt(const int aX, const int aY) const
+{
+    const TileInfo* tInfo = mLayerData[aY][aX];
+    if (tInfo == nullptr || tInfo->Index <= 0)
+    {
+        return false;
+    }
+
+    const Tile* tTile = m_TilesetPtr->GetTile(tInfo->Index);
+    if (tTile == nullptr || !tTile->Opaque)
+    {
+        return false;
+    }
+
+    // A rotated tile only keeps covering its cell when it is square
+    return tTile->Bounds.W >= m_TileWidth && tTile->Bounds.H >= m_TileHeight &&
+        (!tInfo->DiagonalFlip || tTile->Bounds.W == tTile->Bounds.H);
+}
+
+void bart::TileLayer::UpdateOpaqueMask(const int aX, const int aY)
+{
+    if (m_OpaqueMasks.empty())
+    {
+        return;
+    }
+
+    const size_t tChunk = (aY / OCCLUSION_CHUNK_SIZE) * m_OcclusionColumns + aX / OCCLUSION_CHUNK_SIZE;
+    const unsigned long long tBit = 1ULL << ((aY % OCCLUSION_CHUNK_SIZE) * OCCLUSION_CHUNK_SIZE + aX % OCCLUSION_CHUNK_SIZE);
+
+    if (IsOpaqueAt(aX, aY))
+    {
+        m_OpaqueMasks[tChunk] |= tBit;
+    }
+    else
+    {
+        m_OpaqueMasks[tChunk] &= ~tBit;
+    }
+}
+
+bool bart::TileLayer::IsOccluded(const int aX, const int aY) const
+{
+    if (m_Occlusion.empty())
+    {
+        return false;
+    }
+
+    const size_t tChunk = (aY / OCCLUSION_CHUNK_SIZE) * m_OcclusionColumns + aX / OCCLUSION_CHUNK_SIZE;
+    const unsigned long long tBit = 1ULL << ((aY % OCCLUSION_CHUNK_SIZE) * OCCLUSION_CHUNK_SIZE + aX % OCCLUSION_CHUNK_SIZE);
+
+    if ((m_Occlusion[tChunk] & tBit) == 0)
+    {
+        return false;
+    }
+
+    // A tile larger than its cell is still visible around it
+    const int tIndex = mLayerData[aY][aX]->Index;
+    if (tIndex > 0)
+    {
+        const Tile* tTile = m_TilesetPtr->GetTile(tIndex);
+        return tTile == nullptr || (tTile->Bounds.W <= m_TileWidth && tTile->Bounds.H <= m_TileHeight);
+    }
+
+    return true;
+}
+
 void bart::TileLayer::SetData(const char* aData)
 {
     std::string tCurrentToken;
@@ -225,6 +543,10 @@ void bart::TileLayer::SetData(const char* aData)
 
 void bart::TileLayer::Clean()
 {
+    CleanChunks();
+    m_OpaqueMasks.clear();
+    m_Occlusion.clear();
+
     for (TTileMap::iterator itr = mLayerData.begin(); itr != mLayerData.end(); ++itr)
     {
         for (TileInfo* tInfo : *itr)
@@ -20,6 +20,9 @@ void bart::TileMap::Clean()
     }
 
     mMapInfo.clear();
+    m_LayerDepth.clear();
+    m_TileLayers.clear();
+    m_OcclusionRevision = ~0u;
     m_Factory.Clear();
     m_Tileset.Clean();
 }
@@ -46,6 +49,55 @@ void bart::TileMap::AddLayer(Layer* aLayer)
     const string tName = aLayer->GetName();
     mMapInfo[tName] = aLayer;
     m_LayerDepth.push_back(aLayer);
+
+    TileLayer* tTileLayer = dynamic_cast<TileLayer*>(aLayer);
+    if (tTileLayer != nullptr)
+    {
+        m_TileLayers.push_back(tTileLayer);
+    }
+}
+
+void bart::TileMap::UpdateOcclusion()
+{
+    unsigned int tRevision = 0;
+    for (TileLayer* tLayer : m_TileLayers)
+    {
+        tRevision += tLayer->GetRevision();
+    }
+
+    if (tRevision == m_OcclusionRevision)
+    {
+        return;
+    }
+
+    m_OcclusionRevision = tRevision;
+
+    // From the top, each layer is hidden by the union of the opaque cells above it
+    std::vector<unsigned long long> tCovered;
+    for (size_t i = m_TileLayers.size(); i-- > 0;)
+    {
+        TileLayer* tLayer = m_TileLayers[i];
+        const std::vector<unsigned long long>& tMasks = tLayer->GetOpaqueMasks();
+
+        // Layers of another size than the ones above them are never hidden
+        tLayer->SetOcclusion(tCovered.size() == tMasks.size() ? tCovered : std::vector<unsigned long long>());
+
+        if (tLayer->CanOcclude() && !tMasks.empty())
+        {
+            if (tCovered.empty())
+            {
+                tCovered.assign(tMasks.size(), 0);
+            }
+
+            if (tCovered.size() == tMasks.size())
+            {
+                for (size_t j = 0; j < tMasks.size(); j++)
+                {
+                    tCovered[j] |= tMasks[j];
+                }
+            }
+        }
+    }
 }
 
 void bart::TileMap::LoadMap(XMLNode* aNode)
@@ -169,8 +221,23 @@ void bart::TileMap::Draw()
 
 void bart::TileMap::Draw(const Rectangle& aViewport)
 {
+    UpdateOcclusion();
+
+    // Once per frame for the whole map, on the clock of the animation system
+    m_Tileset.Animate(static_cast<unsigned long long>(Engine::Instance().GetAnimations().GetClock() * 1000.0));
+
+    OverdrawAnalyzer& tOverdraw = Engine::Instance().GetGraphic().GetOverdrawAnalyzer();
+    const std::string tScope = tOverdraw.GetScope();
+
     for (size_t i = 0; i < m_LayerDepth.size(); i++)
     {
+        if (tOverdraw.IsEnabled())
+        {
+            tOverdraw.SetScope("Layer " + m_LayerDepth[i]->GetName());
+        }
+
         m_LayerDepth[i]->Draw(aViewport);
     }
+
+    tOverdraw.SetScope(tScope);
 }
@@ -3,6 +3,7 @@
 #include <string>
 #include <Engine.h>
 #include <StringHelper.h>
+#include <algorithm>
 
 using namespace tinyxml2;
 using namespace std;
@@ -57,6 +58,7 @@ bool bart::Tileset::Load(XMLNode* aNode, const std::string& aAssetPath)
                 if (tTextureId > 0)
                 {
                     m_TextureIds.push_back(tTextureId);
+                    IGraphic& tGraphic = Engine::Instance().GetGraphic();
                     int tTileNumber = tFirstIndex;
                     int tY = 0;
                     int tX = 0;
@@ -69,13 +71,37 @@ bool bart::Tileset::Load(XMLNode* aNode, const std::string& aAssetPath)
                         m_SourceMap[tTileNumber] = new Tile();
                         m_SourceMap[tTileNumber]->Texture = tTextureId;
                         m_SourceMap[tTileNumber]->Bounds = {tX * tTileWidth, tY * tTileHeight, tTileWidth, tTileHeight};
+                        m_SourceMap[tTileNumber]->Opaque = tGraphic.IsRegionOpaque(tTextureId, m_SourceMap[tTileNumber]->Bounds);
                     }
                 }
             }
+            else if (tNextValue == "tile")
+            {
+                LoadAnimation(tNext, tFirstIndex);
+            }
 
             tNext = tNext->NextSibling();
         }
 
+        // An animated tile only hides the layers below when all its frames are opaque
+        for (const TileAnimation& tAnimation : m_Animations)
+        {
+            TTileMap::iterator tItr = m_SourceMap.find(tAnimation.Index);
+            if (tItr == m_SourceMap.end())
+            {
+                continue;
+            }
+
+            for (const int tFrame : tAnimation.Frames)
+            {
+                TTileMap::iterator tFrameItr = m_SourceMap.find(tFrame);
+                if (tFrameItr == m_SourceMap.end() || !tFrameItr->second->Opaque)
+                {
+                    tItr->second->Opaque = false;
+                }
+            }
+        }
+
         return true;
     }
 
@@ -83,6 +109,83 @@ bool bart::Tileset::Load(XMLNode* aNode, const std::string& aAssetPath)
     return false;
 }
 
+void bart::Tileset::LoadAnimation(XMLNode* aNode, const int aFirstIndex)
+{
+    XMLNode* tAnimationNode = aNode->FirstChildElement("animation");
+    if (tAnimationNode == nullptr)
+    {
+        return;
+    }
+
+    TileAnimation tAnimation;
+    tAnimation.Index = aFirstIndex + aNode->ToElement()->IntAttribute("id");
+    unsigned int tEnd = 0;
+
+    for (XMLElement* tFrame = tAnimationNode->FirstChildElement("frame"); tFrame != nullptr; tFrame = tFrame->NextSiblingElement("frame"))
+    {
+        // A frame of 0 ms would never be shown
+        tEnd += std::max(tFrame->UnsignedAttribute("duration"), 1u);
+        tAnimation.Frames.push_back(aFirstIndex + tFrame->IntAttribute("tileid"));
+        tAnimation.Ends.push_back(tEnd);
+    }
+
+    if (tAnimation.Frames.empty() || tAnimation.Index < 0)
+    {
+        return;
+    }
+
+    const size_t tIndex = static_cast<size_t>(tAnimation.Index);
+    if (tIndex >= m_Remap.size())
+    {
+        const size_t tOldSize = m_Remap.size();
+        m_Remap.resize(tIndex + 1);
+        m_AnimationIds.resize(tIndex + 1, -1);
+
+        for (size_t i = tOldSize; i < m_Remap.size(); i++)
+        {
+            m_Remap[i] = static_cast<int>(i);
+        }
+    }
+
+    m_Remap[tIndex] = tAnimation.Frames[0];
+    m_AnimationIds[tIndex] = static_cast<int>(m_Animations.size());
+    m_Animations.push_back(tAnimation);
+}
+
+void bart::Tileset::Animate(const unsigned long long aClock)
+{
+    m_Changed = 0;
+
+    for (size_t i = 0; i < m_Animations.size(); i++)
+    {
+        TileAnimation& tAnimation = m_Animations[i];
+        const unsigned int tTime = static_cast<unsigned int>(aClock % tAnimation.Ends.back());
+
+        size_t tFrame = 0;
+        while (tTime >= tAnimation.Ends[tFrame])
+        {
+            tFrame++;
+        }
+
+        if (tFrame != tAnimation.Current)
+        {
+            tAnimation.Current = tFrame;
+            m_Remap[tAnimation.Index] = tAnimation.Frames[tFrame];
+            m_Changed |= 1ULL << (i % 64);
+        }
+    }
+}
+
+unsigned long long bart::Tileset::GetAnimationBit(const int aIndex) const
+{
+    if (aIndex < 0 || static_cast<size_t>(aIndex) >= m_AnimationIds.size() || m_AnimationIds[aIndex] < 0)
+    {
+        return 0;
+    }
+
+    return 1ULL << (m_AnimationIds[aIndex] % 64);
+}
+
 bart::Tile* bart::Tileset::GetTile(const int aIndex)
 {
     return m_SourceMap[aIndex];
@@ -96,6 +199,10 @@ void bart::Tileset::Clean()
     }
 
     m_SourceMap.clear();
+    m_Animations.clear();
+    m_Remap.clear();
+    m_AnimationIds.clear();
+    m_Changed = 0;
 
     for (size_t i = 0; i < m_TextureIds.size(); i++)
     {
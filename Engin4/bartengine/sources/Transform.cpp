@@ -27,6 +27,7 @@
 
 #include <Transform.h>
 #include <Rectangle.h>
+#include <cmath>
 
 void bart::Transform::SetPosition(const float aX, const float aY)
 {
@@ -83,3 +84,24 @@ void bart::Transform::GetBounds(Rectangle* aRectangle) const
     aRectangle->W = static_cast<int>(Width);
     aRectangle->H = static_cast<int>(Height);
 }
+
+void bart::Transform::GetAxisAlignedBounds(Rectangle* aRectangle) const
+{
+    if (Angle == 0.0f)
+    {
+        GetBounds(aRectangle);
+        return;
+    }
+
+    // Box enclosing the rectangle rotated around its center
+    const float tRadians = Angle * 3.14159265f / 180.0f;
+    const float tCos = std::fabs(std::cos(tRadians));
+    const float tSin = std::fabs(std::sin(tRadians));
+    const float tWidth = Width * tCos + Height * tSin;
+    const float tHeight = Width * tSin + Height * tCos;
+
+    aRectangle->X = static_cast<int>(X + (Width - tWidth) * 0.5f);
+    aRectangle->Y = static_cast<int>(Y + (Height - tHeight) * 0.5f);
+    aRectangle->W = static_cast<int>(std::ceil(tWidth)) + 1;
+    aRectangle->H = static_cast<int>(std::ceil(tHeight)) + 1;
+}
\ No newline at end of file
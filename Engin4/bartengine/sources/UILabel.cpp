@@ -0,0 +1,81 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: UILabel.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <UILabel.h>
+#include <Engine.h>
+
+void bart::UILabel::Load(const std::string& aFontFile, const int aFontSize, const Color& aColor)
+{
+    m_FontId = Engine::Instance().GetGraphic().LoadFont(aFontFile, aFontSize, aColor);
+    SetDirty();
+}
+
+void bart::UILabel::Unload()
+{
+    Engine::Instance().GetGraphic().UnloadFont(m_FontId);
+    m_FontId = 0;
+}
+
+void bart::UILabel::Draw()
+{
+    if (!m_Text.empty())
+    {
+        Engine::Instance().GetGraphic().Draw(m_FontId, m_Text, m_X, m_Y);
+    }
+}
+
+bool bart::UILabel::GetBounds(Rectangle* aBounds) const
+{
+    if (m_Text.empty())
+    {
+        return false;
+    }
+
+    int tWidth, tHeight;
+    Engine::Instance().GetGraphic().GetFontSize(m_FontId, m_Text, &tWidth, &tHeight);
+    aBounds->Set(m_X, m_Y, tWidth, tHeight);
+    return tWidth > 0 && tHeight > 0;
+}
+
+void bart::UILabel::SetText(const std::string& aText)
+{
+    if (aText != m_Text)
+    {
+        m_Text = aText;
+        SetDirty();
+    }
+}
+
+void bart::UILabel::SetPosition(const int aX, const int aY)
+{
+    if (aX != m_X || aY != m_Y)
+    {
+        m_X = aX;
+        m_Y = aY;
+        SetDirty();
+    }
+}
\ No newline at end of file
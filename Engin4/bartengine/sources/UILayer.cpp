@@ -0,0 +1,238 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: UILayer.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+
+#include <UILayer.h>
+#include <Engine.h>
+#include <Color.h>
+#include <algorithm>
+
+void bart::UILayer::Initialize(const std::string& aName, const int aWidth, const int aHeight)
+{
+    m_Width = aWidth;
+    m_Height = aHeight;
+    m_Invalid = true;
+
+    RenderGraph& tGraph = Engine::Instance().GetRenderGraph();
+    m_Resource = tGraph.AddResource(aName, aWidth, aHeight, true);
+
+    m_CachePass = tGraph.AddPass(aName + " cache", [this](RenderGraph& aGraph) { Cache(aGraph); });
+    tGraph.SetOutput(m_CachePass, m_Resource);
+
+    m_CompositePass = tGraph.AddPass(aName, [this](RenderGraph& aGraph) { Compose(aGraph); });
+    tGraph.AddInput(m_CompositePass, m_Resource);
+    tGraph.SetOutput(m_CompositePass, RenderGraph::BACKBUFFER);
+}
+
+void bart::UILayer::Clean()
+{
+    RenderGraph& tGraph = Engine::Instance().GetRenderGraph();
+    tGraph.RemovePass(m_CompositePass);
+    tGraph.RemovePass(m_CachePass);
+    tGraph.RemoveResource(m_Resource);
+
+    m_CompositePass = 0;
+    m_CachePass = 0;
+    m_Resource = 0;
+    m_Slots.clear();
+    m_DirtyRegions.clear();
+}
+
+void bart::UILayer::Add(UIWidget* aWidget)
+{
+    Slot tSlot;
+    tSlot.Widget = aWidget;
+    m_Slots.push_back(tSlot);
+    aWidget->SetDirty();
+}
+
+void bart::UILayer::Remove(UIWidget* aWidget)
+{
+    for (std::vector<Slot>::iterator tItr = m_Slots.begin(); tItr != m_Slots.end(); ++tItr)
+    {
+        if (tItr->Widget == aWidget)
+        {
+            // What the widget drew must be erased
+            if (tItr->Visible)
+            {
+                m_DirtyRegions.push_back(tItr->Bounds);
+            }
+
+            m_Slots.erase(tItr);
+            return;
+        }
+    }
+}
+
+void bart::UILayer::Invalidate()
+{
+    m_Invalid = true;
+}
+
+void bart::UILayer::SetVisible(const bool aVisible)
+{
+    Engine::Instance().GetRenderGraph().SetEnabled(m_CompositePass, aVisible);
+}
+
+void bart::UILayer::Cache(RenderGraph& aGraph)
+{
+    if (aGraph.IsNewTarget(m_Resource))
+    {
+        m_Invalid = true;
+    }
+
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    Camera* tCamera = tGraphic.GetCamera();
+    tGraphic.SetCamera(nullptr);
+
+    Refresh();
+
+    tGraphic.SetCamera(tCamera);
+}
+
+void bart::UILayer::Compose(RenderGraph& aGraph)
+{
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    Camera* tCamera = tGraphic.GetCamera();
+    tGraphic.SetCamera(nullptr);
+
+    const size_t tTarget = aGraph.GetTarget(m_Resource);
+    if (tTarget == 0)
+    {
+        // Without render targets, every widget is drawn every frame
+        for (Slot& tSlot : m_Slots)
+        {
+            tSlot.Widget->Draw();
+            tSlot.Widget->ClearDirty();
+        }
+
+        m_RedrawnWidgets = static_cast<unsigned int>(m_Slots.size());
+    }
+    else
+    {
+        Rectangle tBounds;
+        tBounds.Set(0, 0, m_Width, m_Height);
+        tGraphic.Draw(tTarget, tBounds, tBounds, 0.0f, false, false, 255);
+    }
+
+    tGraphic.SetCamera(tCamera);
+}
+
+void bart::UILayer::Refresh()
+{
+    m_Redraw.assign(m_Slots.size(), false);
+    bool tAny = m_Invalid || !m_DirtyRegions.empty();
+
+    for (size_t i = 0; i < m_Slots.size(); i++)
+    {
+        Slot& tSlot = m_Slots[i];
+
+        if (m_Invalid || tSlot.Widget->IsDirty())
+        {
+            // Both where the widget was and where it is now
+            if (tSlot.Visible)
+            {
+                m_DirtyRegions.push_back(tSlot.Bounds);
+            }
+
+            tSlot.Visible = tSlot.Widget->GetBounds(&tSlot.Bounds);
+            if (tSlot.Visible)
+            {
+                m_DirtyRegions.push_back(tSlot.Bounds);
+            }
+
+            m_Redraw[i] = true;
+            tAny = true;
+        }
+    }
+
+    if (!tAny)
+    {
+        m_RedrawnWidgets = 0;
+        return;
+    }
+
+    // A clean widget under a cleared region is redrawn too, its own area is then cleared as well
+    bool tGrown = true;
+    while (tGrown)
+    {
+        tGrown = false;
+
+        for (size_t i = 0; i < m_Slots.size(); i++)
+        {
+            if (!m_Redraw[i] && m_Slots[i].Visible && IsInDirtyRegion(m_Slots[i].Bounds))
+            {
+                m_Redraw[i] = true;
+                m_DirtyRegions.push_back(m_Slots[i].Bounds);
+                tGrown = true;
+            }
+        }
+    }
+
+    // The graph has bound the target of the layer
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    const Color tTransparent(0, 0, 0, 0);
+    if (m_Invalid)
+    {
+        tGraphic.Clear(tTransparent);
+    }
+    else
+    {
+        for (const Rectangle& tRegion : m_DirtyRegions)
+        {
+            tGraphic.Clear(tTransparent, tRegion);
+        }
+    }
+
+    m_RedrawnWidgets = 0;
+    for (size_t i = 0; i < m_Slots.size(); i++)
+    {
+        if (m_Redraw[i])
+        {
+            m_Slots[i].Widget->Draw();
+            m_RedrawnWidgets++;
+        }
+
+        m_Slots[i].Widget->ClearDirty();
+    }
+
+    m_DirtyRegions.clear();
+    m_Invalid = false;
+}
+
+bool bart::UILayer::IsInDirtyRegion(const Rectangle& aBounds) const
+{
+    for (const Rectangle& tRegion : m_DirtyRegions)
+    {
+        if (aBounds.X < tRegion.X + tRegion.W && tRegion.X < aBounds.X + aBounds.W && aBounds.Y < tRegion.Y + tRegion.H &&
+            tRegion.Y < aBounds.Y + aBounds.H)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
\ No newline at end of file
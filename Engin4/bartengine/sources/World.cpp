@@ -29,6 +29,9 @@
 #include <Entity.h>
 #include <Engine.h>
 #include <typeinfo>
+#include <Camera.h>
+#include <cfloat>
+#include <xmmintrin.h>
 
 void bart::World::Add(const std::string& aName, Entity* aEntity)
 {
@@ -179,6 +182,7 @@ void bart::World::Unload(const bool aForceDestroy)
     m_Entities.clear();
     m_DrawEntities.clear();
     m_UpdateEntities.clear();
+    m_CullEntities.clear();
 
 #if DEBUG_CACHES
     const int tTextureCnt = Engine::Instance().GetGraphic().GetTextureInCache();
@@ -227,15 +231,117 @@ void bart::World::Update(float aDeltaTime)
 
 void bart::World::Draw()
 {
+    IGraphic& tGraphic = Engine::Instance().GetGraphic();
+    const Camera* tCamera = tGraphic.GetCamera();
+    OverdrawAnalyzer& tOverdraw = tGraphic.GetOverdrawAnalyzer();
+
+    if (tCamera == nullptr || tCamera->GetWidth() <= 0 || tCamera->GetHeight() <= 0)
+    {
+        // No viewport to cull against
+        unsigned long long tDrawn = 0;
+        for (TEntityVector::iterator itr = m_DrawEntities.begin(); itr != m_DrawEntities.end(); ++itr)
+        {
+            Entity* tEntity = *itr;
+
+            if (tEntity != nullptr && tEntity->IsActive())
+            {
+                if (tOverdraw.IsEnabled())
+                {
+                    tOverdraw.SetScope(typeid(*tEntity).name());
+                }
+
+                (*itr)->Draw();
+                tDrawn++;
+            }
+        }
+
+        tOverdraw.SetScope("");
+        tGraphic.GetRenderStats().Add(ENTITIES_DRAWN, tDrawn);
+        return;
+    }
+
+    m_CullEntities.clear();
+    m_CullMinX.clear();
+    m_CullMinY.clear();
+    m_CullMaxX.clear();
+    m_CullMaxY.clear();
+
     for (TEntityVector::iterator itr = m_DrawEntities.begin(); itr != m_DrawEntities.end(); ++itr)
     {
         Entity* tEntity = *itr;
 
         if (tEntity != nullptr && tEntity->IsActive())
         {
-            (*itr)->Draw();
+            Rectangle tBounds;
+            m_CullEntities.push_back(tEntity);
+
+            if (tEntity->GetBounds(&tBounds))
+            {
+                m_CullMinX.push_back(static_cast<float>(tBounds.X));
+                m_CullMinY.push_back(static_cast<float>(tBounds.Y));
+                m_CullMaxX.push_back(static_cast<float>(tBounds.X + tBounds.W));
+                m_CullMaxY.push_back(static_cast<float>(tBounds.Y + tBounds.H));
+            }
+            else
+            {
+                // Without bounds the entity is always visible
+                m_CullMinX.push_back(-FLT_MAX);
+                m_CullMinY.push_back(-FLT_MAX);
+                m_CullMaxX.push_back(FLT_MAX);
+                m_CullMaxY.push_back(FLT_MAX);
+            }
+        }
+    }
+
+    const size_t tCount = m_CullEntities.size();
+
+    // Pad to a multiple of 4 with empty boxes, they never pass the test
+    while (m_CullMinX.size() % 4 != 0)
+    {
+        m_CullMinX.push_back(FLT_MAX);
+        m_CullMinY.push_back(FLT_MAX);
+        m_CullMaxX.push_back(-FLT_MAX);
+        m_CullMaxY.push_back(-FLT_MAX);
+    }
+
+    // Same overlap test as Camera::CollideWith, 4 boxes at a time
+    const __m128 tLeft = _mm_set1_ps(static_cast<float>(tCamera->GetX()));
+    const __m128 tTop = _mm_set1_ps(static_cast<float>(tCamera->GetY()));
+    const __m128 tRight = _mm_set1_ps(static_cast<float>(tCamera->GetX() + tCamera->GetWidth()));
+    const __m128 tBottom = _mm_set1_ps(static_cast<float>(tCamera->GetY() + tCamera->GetHeight()));
+
+    unsigned long long tDrawn = 0;
+
+    for (size_t i = 0; i < tCount; i += 4)
+    {
+        const __m128 tMinX = _mm_loadu_ps(&m_CullMinX[i]);
+        const __m128 tMinY = _mm_loadu_ps(&m_CullMinY[i]);
+        const __m128 tMaxX = _mm_loadu_ps(&m_CullMaxX[i]);
+        const __m128 tMaxY = _mm_loadu_ps(&m_CullMaxY[i]);
+
+        const __m128 tInX = _mm_and_ps(_mm_cmplt_ps(tMinX, tRight), _mm_cmpgt_ps(tMaxX, tLeft));
+        const __m128 tInY = _mm_and_ps(_mm_cmple_ps(tMinY, tBottom), _mm_cmpge_ps(tMaxY, tTop));
+        const int tMask = _mm_movemask_ps(_mm_and_ps(tInX, tInY));
+
+        for (size_t j = 0; j < 4 && i + j < tCount; j++)
+        {
+            if (tMask & (1 << j))
+            {
+                if (tOverdraw.IsEnabled())
+                {
+                    tOverdraw.SetScope(typeid(*m_CullEntities[i + j]).name());
+                }
+
+                m_CullEntities[i + j]->Draw();
+                tDrawn++;
+            }
         }
     }
+
+    tOverdraw.SetScope("");
+
+    tGraphic.GetRenderStats().Add(ENTITIES_DRAWN, tDrawn);
+    tGraphic.GetRenderStats().Add(ENTITIES_CULLED, tCount - tDrawn);
 }
 
 std::vector<bart::Entity*>& bart::World::GetEntityOfType(size_t aTypeId)
@@ -23,6 +23,8 @@ using namespace std;
 b2BroadPhase::b2BroadPhase()
 {
 	m_proxyCount = 0;
+	m_staticProxyCount = 0;
+	m_staticInsertCount = 0;
 
 	m_pairCapacity = 16;
 	m_pairCount = 0;
@@ -31,6 +33,11 @@ b2BroadPhase::b2BroadPhase()
 	m_moveCapacity = 16;
 	m_moveCount = 0;
 	m_moveBuffer = (int32*)b2Alloc(m_moveCapacity * sizeof(int32));
+
+	m_queryProxyId = e_nullProxy;
+	m_queryTree = 0;
+
+	ResetCounters();
 }
 
 b2BroadPhase::~b2BroadPhase()
@@ -39,9 +46,20 @@ b2BroadPhase::~b2BroadPhase()
 	b2Free(m_pairBuffer);
 }
 
-int32 b2BroadPhase::CreateProxy(const b2AABB& aabb, void* userData)
+int32 b2BroadPhase::CreateProxy(const b2AABB& aabb, void* userData, bool isStatic)
 {
-	int32 proxyId = m_tree.CreateProxy(aabb, userData);
+	int32 proxyId;
+	if (isStatic)
+	{
+		proxyId = 2 * m_staticTree.CreateProxy(aabb, userData) + 1;
+		++m_staticProxyCount;
+		++m_staticInsertCount;
+	}
+	else
+	{
+		proxyId = 2 * m_tree.CreateProxy(aabb, userData);
+	}
+
 	++m_proxyCount;
 	BufferMove(proxyId);
 	return proxyId;
@@ -51,12 +69,19 @@ void b2BroadPhase::DestroyProxy(int32 proxyId)
 {
 	UnBufferMove(proxyId);
 	--m_proxyCount;
-	m_tree.DestroyProxy(proxyId);
+
+	if (b2IsStaticProxy(proxyId))
+	{
+		--m_staticProxyCount;
+		m_staticInsertCount = b2Min(m_staticInsertCount, m_staticProxyCount);
+	}
+
+	GetTree(proxyId).DestroyProxy(b2ProxyNode(proxyId));
 }
 
 void b2BroadPhase::MoveProxy(int32 proxyId, const b2AABB& aabb, const b2Vec2& displacement)
 {
-	bool buffer = m_tree.MoveProxy(proxyId, aabb, displacement);
+	bool buffer = GetTree(proxyId).MoveProxy(b2ProxyNode(proxyId), aabb, displacement);
 	if (buffer)
 	{
 		BufferMove(proxyId);
@@ -95,9 +120,26 @@ void b2BroadPhase::UnBufferMove(int32 proxyId)
 	}
 }
 
+void b2BroadPhase::RebuildStaticTree()
+{
+	m_staticTree.RebuildTopDown();
+	m_staticInsertCount = 0;
+	++m_counters.staticRebuilds;
+}
+
+void b2BroadPhase::ResetCounters()
+{
+	m_counters.staticQueries = 0;
+	m_counters.dynamicQueries = 0;
+	m_counters.pairs = 0;
+	m_counters.staticRebuilds = 0;
+}
+
 // This is called from b2DynamicTree::Query when we are gathering pairs.
-bool b2BroadPhase::QueryCallback(int32 proxyId)
+bool b2BroadPhase::QueryCallback(int32 nodeId)
 {
+	int32 proxyId = 2 * nodeId + m_queryTree;
+
 	// A proxy cannot form a pair with itself.
 	if (proxyId == m_queryProxyId)
 	{
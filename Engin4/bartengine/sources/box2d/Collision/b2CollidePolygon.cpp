@@ -18,6 +18,7 @@
 
 #include <box2d/Collision/b2Collision.h>
 #include <box2d/Collision/Shapes/b2PolygonShape.h>
+#include <box2d/Common/b2WideMath.h>
 
 // Find the separation between poly1 and poly2 for a give edge normal on poly1.
 static float32 b2EdgeSeparation(const b2PolygonShape* poly1, const b2Transform& xf1, int32 edge1,
@@ -189,24 +190,15 @@ static void b2FindIncidentEdge(b2ClipVertex c[2],
 // Find incident edge
 // Clip
 
+// Choose the reference edge and clip the incident edge against it, once the
+// edges of max separation are known and both overlap.
 // The normal points from 1 to 2
-void b2CollidePolygons(b2Manifold* manifold,
-					  const b2PolygonShape* polyA, const b2Transform& xfA,
-					  const b2PolygonShape* polyB, const b2Transform& xfB)
+static void b2ClipPolygons(b2Manifold* manifold,
+						   const b2PolygonShape* polyA, const b2Transform& xfA, int32 edgeA, float32 separationA,
+						   const b2PolygonShape* polyB, const b2Transform& xfB, int32 edgeB, float32 separationB)
 {
-	manifold->pointCount = 0;
 	float32 totalRadius = polyA->m_radius + polyB->m_radius;
 
-	int32 edgeA = 0;
-	float32 separationA = b2FindMaxSeparation(&edgeA, polyA, xfA, polyB, xfB);
-	if (separationA > totalRadius)
-		return;
-
-	int32 edgeB = 0;
-	float32 separationB = b2FindMaxSeparation(&edgeB, polyB, xfB, polyA, xfA);
-	if (separationB > totalRadius)
-		return;
-
 	const b2PolygonShape* poly1;	// reference polygon
 	const b2PolygonShape* poly2;	// incident polygon
 	b2Transform xf1, xf2;
@@ -315,3 +307,259 @@ void b2CollidePolygons(b2Manifold* manifold,
 
 	manifold->pointCount = pointCount;
 }
+
+void b2CollidePolygons(b2Manifold* manifold,
+					  const b2PolygonShape* polyA, const b2Transform& xfA,
+					  const b2PolygonShape* polyB, const b2Transform& xfB)
+{
+	manifold->pointCount = 0;
+	float32 totalRadius = polyA->m_radius + polyB->m_radius;
+
+	int32 edgeA = 0;
+	float32 separationA = b2FindMaxSeparation(&edgeA, polyA, xfA, polyB, xfB);
+	if (separationA > totalRadius)
+		return;
+
+	int32 edgeB = 0;
+	float32 separationB = b2FindMaxSeparation(&edgeB, polyB, xfB, polyA, xfA);
+	if (separationB > totalRadius)
+		return;
+
+	b2ClipPolygons(manifold, polyA, xfA, edgeA, separationA, polyB, xfB, edgeB, separationB);
+}
+
+// Same search as b2FindMaxSeparation over separations computed ahead for every edge.
+static float32 b2FindMaxSeparation(int32* edgeIndex, const float32* separations, int32 edge, int32 count1)
+{
+	float32 s = separations[edge];
+
+	int32 prevEdge = edge - 1 >= 0 ? edge - 1 : count1 - 1;
+	float32 sPrev = separations[prevEdge];
+
+	int32 nextEdge = edge + 1 < count1 ? edge + 1 : 0;
+	float32 sNext = separations[nextEdge];
+
+	int32 bestEdge;
+	float32 bestSeparation;
+	int32 increment;
+	if (sPrev > s && sPrev > sNext)
+	{
+		increment = -1;
+		bestEdge = prevEdge;
+		bestSeparation = sPrev;
+	}
+	else if (sNext > s)
+	{
+		increment = 1;
+		bestEdge = nextEdge;
+		bestSeparation = sNext;
+	}
+	else
+	{
+		*edgeIndex = edge;
+		return s;
+	}
+
+	for ( ; ; )
+	{
+		if (increment == -1)
+			edge = bestEdge - 1 >= 0 ? bestEdge - 1 : count1 - 1;
+		else
+			edge = bestEdge + 1 < count1 ? bestEdge + 1 : 0;
+
+		s = separations[edge];
+
+		if (s > bestSeparation)
+		{
+			bestEdge = edge;
+			bestSeparation = s;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	*edgeIndex = bestEdge;
+	return bestSeparation;
+}
+
+#if B2_WIDE_MATH
+
+// Boxes of several pairs, one lane per pair.
+struct b2BoxLanes
+{
+	float32 px[b2_wideLanes], py[b2_wideLanes];
+	float32 s[b2_wideLanes], c[b2_wideLanes];
+	float32 centroidX[b2_wideLanes], centroidY[b2_wideLanes];
+	float32 vertexX[4][b2_wideLanes], vertexY[4][b2_wideLanes];
+	float32 normalX[4][b2_wideLanes], normalY[4][b2_wideLanes];
+};
+
+static void b2LoadBox(b2BoxLanes* box, int32 lane, const b2PolygonShape* poly, const b2Transform& xf)
+{
+	box->px[lane] = xf.p.x;
+	box->py[lane] = xf.p.y;
+	box->s[lane] = xf.q.s;
+	box->c[lane] = xf.q.c;
+	box->centroidX[lane] = poly->m_centroid.x;
+	box->centroidY[lane] = poly->m_centroid.y;
+	for (int32 i = 0; i < 4; ++i)
+	{
+		box->vertexX[i][lane] = poly->m_vertices[i].x;
+		box->vertexY[i][lane] = poly->m_vertices[i].y;
+		box->normalX[i][lane] = poly->m_normals[i].x;
+		box->normalY[i][lane] = poly->m_normals[i].y;
+	}
+}
+
+// b2Mul(xf, v) of the lanes
+static inline void b2MulTransformW(b2FloatW* x, b2FloatW* y, b2FloatW px, b2FloatW py, b2FloatW s, b2FloatW c,
+								   b2FloatW vx, b2FloatW vy)
+{
+	*x = b2AddW(b2SubW(b2MulW(c, vx), b2MulW(s, vy)), px);
+	*y = b2AddW(b2AddW(b2MulW(s, vx), b2MulW(c, vy)), py);
+}
+
+// b2EdgeSeparation of every edge of the boxes 1 against the boxes 2, and the
+// first edge b2FindMaxSeparation looks at, the same operations for each lane.
+static void b2BoxSeparations(float32 separations[4][b2_wideLanes], int32 firstEdges[b2_wideLanes],
+							 const b2BoxLanes& box1, const b2BoxLanes& box2)
+{
+	b2FloatW px1 = b2LoadW(box1.px), py1 = b2LoadW(box1.py);
+	b2FloatW s1 = b2LoadW(box1.s), c1 = b2LoadW(box1.c);
+	b2FloatW px2 = b2LoadW(box2.px), py2 = b2LoadW(box2.py);
+	b2FloatW s2 = b2LoadW(box2.s), c2 = b2LoadW(box2.c);
+
+	// Edge normal of 1 with the largest projection on the centroids offset.
+	b2FloatW centroid1X, centroid1Y, centroid2X, centroid2Y;
+	b2MulTransformW(&centroid1X, &centroid1Y, px1, py1, s1, c1, b2LoadW(box1.centroidX), b2LoadW(box1.centroidY));
+	b2MulTransformW(&centroid2X, &centroid2Y, px2, py2, s2, c2, b2LoadW(box2.centroidX), b2LoadW(box2.centroidY));
+	b2FloatW dx = b2SubW(centroid2X, centroid1X);
+	b2FloatW dy = b2SubW(centroid2Y, centroid1Y);
+	b2FloatW dLocalX = b2AddW(b2MulW(c1, dx), b2MulW(s1, dy));
+	b2FloatW dLocalY = b2AddW(b2MulW(b2NegW(s1), dx), b2MulW(c1, dy));
+
+	b2FloatW maxDot = b2SplatW(-b2_maxFloat);
+	b2FloatW edge = b2SplatW(0.0f);
+	for (int32 i = 0; i < 4; ++i)
+	{
+		b2FloatW dot = b2AddW(b2MulW(b2LoadW(box1.normalX[i]), dLocalX), b2MulW(b2LoadW(box1.normalY[i]), dLocalY));
+		b2FloatW greater = b2GreaterW(dot, maxDot);
+		maxDot = b2SelectW(greater, dot, maxDot);
+		edge = b2SelectW(greater, b2SplatW(float32(i)), edge);
+	}
+
+	float32 edges[b2_wideLanes];
+	b2StoreW(edges, edge);
+	for (int32 i = 0; i < b2_wideLanes; ++i)
+	{
+		firstEdges[i] = int32(edges[i]);
+	}
+
+	for (int32 e = 0; e < 4; ++e)
+	{
+		// Edge normal in the world and in the frame of 2.
+		b2FloatW nx = b2LoadW(box1.normalX[e]), ny = b2LoadW(box1.normalY[e]);
+		b2FloatW worldX = b2SubW(b2MulW(c1, nx), b2MulW(s1, ny));
+		b2FloatW worldY = b2AddW(b2MulW(s1, nx), b2MulW(c1, ny));
+		b2FloatW localX = b2AddW(b2MulW(c2, worldX), b2MulW(s2, worldY));
+		b2FloatW localY = b2AddW(b2MulW(b2NegW(s2), worldX), b2MulW(c2, worldY));
+
+		// Support vertex of 2 for -normal, the first of the smallest.
+		b2FloatW minDot = b2SplatW(b2_maxFloat);
+		b2FloatW supportX = b2LoadW(box2.vertexX[0]);
+		b2FloatW supportY = b2LoadW(box2.vertexY[0]);
+		for (int32 i = 0; i < 4; ++i)
+		{
+			b2FloatW vx = b2LoadW(box2.vertexX[i]), vy = b2LoadW(box2.vertexY[i]);
+			b2FloatW dot = b2AddW(b2MulW(vx, localX), b2MulW(vy, localY));
+			b2FloatW less = b2LessW(dot, minDot);
+			minDot = b2SelectW(less, dot, minDot);
+			supportX = b2SelectW(less, vx, supportX);
+			supportY = b2SelectW(less, vy, supportY);
+		}
+
+		b2FloatW v1X, v1Y, v2X, v2Y;
+		b2MulTransformW(&v1X, &v1Y, px1, py1, s1, c1, b2LoadW(box1.vertexX[e]), b2LoadW(box1.vertexY[e]));
+		b2MulTransformW(&v2X, &v2Y, px2, py2, s2, c2, supportX, supportY);
+		b2FloatW separation = b2AddW(b2MulW(b2SubW(v2X, v1X), worldX), b2MulW(b2SubW(v2Y, v1Y), worldY));
+		b2StoreW(separations[e], separation);
+	}
+}
+
+#endif
+
+void b2CollideBoxes(b2Manifold* const* manifolds,
+					const b2PolygonShape* const* polysA, const b2Transform* const* xfsA,
+					const b2PolygonShape* const* polysB, const b2Transform* const* xfsB, int32 count)
+{
+	b2Assert(0 < count && count <= b2_wideLanes);
+
+#if B2_WIDE_MATH
+	if (b2IsWideSupported())
+	{
+		// The lanes past the count repeat the first pair.
+		b2BoxLanes boxesA, boxesB;
+		for (int32 i = 0; i < b2_wideLanes; ++i)
+		{
+			int32 pair = i < count ? i : 0;
+			b2Assert(polysA[pair]->m_vertexCount == 4 && polysB[pair]->m_vertexCount == 4);
+			b2LoadBox(&boxesA, i, polysA[pair], *xfsA[pair]);
+			b2LoadBox(&boxesB, i, polysB[pair], *xfsB[pair]);
+		}
+
+		float32 separations[4][b2_wideLanes];
+		int32 firstEdges[b2_wideLanes];
+		float32 lane[4];
+
+		// The edges of B are only searched when a pair is not already apart.
+		int32 edgesA[b2_wideLanes];
+		float32 separationsA[b2_wideLanes];
+		bool overlapping = false;
+		b2BoxSeparations(separations, firstEdges, boxesA, boxesB);
+		for (int32 i = 0; i < count; ++i)
+		{
+			manifolds[i]->pointCount = 0;
+			float32 totalRadius = polysA[i]->m_radius + polysB[i]->m_radius;
+
+			for (int32 e = 0; e < 4; ++e)
+			{
+				lane[e] = separations[e][i];
+			}
+
+			separationsA[i] = b2FindMaxSeparation(&edgesA[i], lane, firstEdges[i], 4);
+			overlapping = overlapping || (separationsA[i] > totalRadius) == false;
+		}
+
+		if (overlapping == false)
+			return;
+
+		b2BoxSeparations(separations, firstEdges, boxesB, boxesA);
+		for (int32 i = 0; i < count; ++i)
+		{
+			float32 totalRadius = polysA[i]->m_radius + polysB[i]->m_radius;
+			if (separationsA[i] > totalRadius)
+				continue;
+
+			for (int32 e = 0; e < 4; ++e)
+			{
+				lane[e] = separations[e][i];
+			}
+
+			int32 edgeB = 0;
+			float32 separationB = b2FindMaxSeparation(&edgeB, lane, firstEdges[i], 4);
+			if (separationB > totalRadius)
+				continue;
+
+			b2ClipPolygons(manifolds[i], polysA[i], *xfsA[i], edgesA[i], separationsA[i], polysB[i], *xfsB[i], edgeB, separationB);
+		}
+		return;
+	}
+#endif
+
+	for (int32 i = 0; i < count; ++i)
+	{
+		b2CollidePolygons(manifolds[i], polysA[i], *xfsA[i], polysB[i], *xfsB[i]);
+	}
+}
@@ -768,3 +768,197 @@ void b2DynamicTree::RebuildBottomUp()
 
 	Validate();
 }
+
+// Number of buckets the leaf centers are sorted in to find the split of a node.
+#define b2_treeBins 16
+
+static inline int32 b2TreeBin(const b2AABB& aabb, int32 axis, float32 lower, float32 scale)
+{
+	b2Vec2 center = aabb.GetCenter();
+	float32 value = axis == 0 ? center.x : center.y;
+	return b2Min(int32((value - lower) * scale), b2_treeBins - 1);
+}
+
+void b2DynamicTree::RebuildTopDown()
+{
+	if (m_root == b2_nullNode)
+	{
+		return;
+	}
+
+	int32* leaves = (int32*)b2Alloc(m_nodeCount * sizeof(int32));
+	int32 count = 0;
+
+	// Build array of leaves. Free the rest.
+	for (int32 i = 0; i < m_nodeCapacity; ++i)
+	{
+		if (m_nodes[i].height < 0)
+		{
+			// free node in pool
+			continue;
+		}
+
+		if (m_nodes[i].IsLeaf())
+		{
+			m_nodes[i].parent = b2_nullNode;
+			leaves[count] = i;
+			++count;
+		}
+		else
+		{
+			FreeNode(i);
+		}
+	}
+
+	m_root = BuildTopDown(leaves, count);
+	m_nodes[m_root].parent = b2_nullNode;
+	b2Free(leaves);
+
+	Validate();
+}
+
+// Build the sub-tree of the given leaves, they are reordered. Returns its root.
+int32 b2DynamicTree::BuildTopDown(int32* leaves, int32 count)
+{
+	if (count == 1)
+	{
+		return leaves[0];
+	}
+
+	// The split is searched along the longest side of the bounds of the centers.
+	b2Vec2 lower = m_nodes[leaves[0]].aabb.GetCenter();
+	b2Vec2 upper = lower;
+	for (int32 i = 1; i < count; ++i)
+	{
+		b2Vec2 center = m_nodes[leaves[i]].aabb.GetCenter();
+		lower = b2Min(lower, center);
+		upper = b2Max(upper, center);
+	}
+
+	int32 axis = upper.x - lower.x >= upper.y - lower.y ? 0 : 1;
+	float32 minValue = axis == 0 ? lower.x : lower.y;
+	float32 size = axis == 0 ? upper.x - lower.x : upper.y - lower.y;
+
+	// Centers all at the same place are split in two halves.
+	int32 split = count / 2;
+
+	if (size > 0.0f)
+	{
+		float32 scale = b2_treeBins / size;
+
+		b2AABB binAABBs[b2_treeBins];
+		int32 binCounts[b2_treeBins];
+		for (int32 i = 0; i < b2_treeBins; ++i)
+		{
+			binCounts[i] = 0;
+		}
+
+		for (int32 i = 0; i < count; ++i)
+		{
+			const b2AABB& aabb = m_nodes[leaves[i]].aabb;
+			int32 bin = b2TreeBin(aabb, axis, minValue, scale);
+			if (binCounts[bin] == 0)
+			{
+				binAABBs[bin] = aabb;
+			}
+			else
+			{
+				binAABBs[bin].Combine(aabb);
+			}
+			++binCounts[bin];
+		}
+
+		// Cost of the leaves right of each boundary, the perimeter stands for the area in 2D.
+		float32 rightCosts[b2_treeBins];
+		b2AABB bounds;
+		int32 boundsCount = 0;
+		for (int32 i = b2_treeBins - 1; i > 0; --i)
+		{
+			if (binCounts[i] > 0)
+			{
+				if (boundsCount == 0)
+				{
+					bounds = binAABBs[i];
+				}
+				else
+				{
+					bounds.Combine(binAABBs[i]);
+				}
+				boundsCount += binCounts[i];
+			}
+
+			rightCosts[i] = boundsCount > 0 ? boundsCount * bounds.GetPerimeter() : 0.0f;
+		}
+
+		float32 minCost = b2_maxFloat;
+		int32 bestBin = -1;
+		boundsCount = 0;
+		for (int32 i = 0; i < b2_treeBins - 1; ++i)
+		{
+			if (binCounts[i] > 0)
+			{
+				if (boundsCount == 0)
+				{
+					bounds = binAABBs[i];
+				}
+				else
+				{
+					bounds.Combine(binAABBs[i]);
+				}
+				boundsCount += binCounts[i];
+			}
+
+			if (boundsCount == 0 || boundsCount == count)
+			{
+				continue;
+			}
+
+			float32 cost = boundsCount * bounds.GetPerimeter() + rightCosts[i + 1];
+			if (cost < minCost)
+			{
+				minCost = cost;
+				bestBin = i;
+			}
+		}
+
+		if (bestBin >= 0)
+		{
+			// Partition, the leaves up to the best boundary first.
+			int32 i = 0;
+			int32 j = count - 1;
+			while (i <= j)
+			{
+				if (b2TreeBin(m_nodes[leaves[i]].aabb, axis, minValue, scale) <= bestBin)
+				{
+					++i;
+				}
+				else
+				{
+					b2Swap(leaves[i], leaves[j]);
+					--j;
+				}
+			}
+
+			split = i;
+		}
+	}
+
+	int32 index1 = BuildTopDown(leaves, split);
+	int32 index2 = BuildTopDown(leaves + split, count - split);
+
+	// The pool may grow, no pointer is held across the allocation.
+	int32 parentIndex = AllocateNode();
+	b2TreeNode* parent = m_nodes + parentIndex;
+	b2TreeNode* child1 = m_nodes + index1;
+	b2TreeNode* child2 = m_nodes + index2;
+	parent->child1 = index1;
+	parent->child2 = index2;
+	parent->height = 1 + b2Max(child1->height, child2->height);
+	parent->aabb.Combine(child1->aabb, child2->aabb);
+	parent->parent = b2_nullNode;
+
+	child1->parent = parentIndex;
+	child2->parent = parentIndex;
+
+	return parentIndex;
+}
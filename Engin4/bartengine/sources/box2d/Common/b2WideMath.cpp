@@ -0,0 +1,58 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: b2WideMath.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <box2d/Common/b2WideMath.h>
+
+#if B2_WIDE_MATH
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+// SSE2 is bit 26 of edx
+static bool b2HasSse2()
+{
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#else
+	unsigned int eax, ebx, ecx, edx;
+	return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (edx & (1 << 26)) != 0;
+#endif
+}
+#endif
+
+bool b2IsWideSupported()
+{
+#if B2_WIDE_MATH
+	static const bool supported = b2HasSse2();
+	return supported;
+#else
+	return false;
+#endif
+}
\ No newline at end of file
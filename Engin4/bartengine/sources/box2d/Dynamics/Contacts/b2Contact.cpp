@@ -151,7 +151,7 @@ b2Contact::b2Contact(b2Fixture* fA, int32 indexA, b2Fixture* fB, int32 indexB)
 
 // Update the contact manifold and touching status.
 // Note: do not assume the fixture AABBs are overlapping or are valid.
-void b2Contact::Update(b2ContactListener* listener)
+void b2Contact::Update(b2ContactListener* listener, const b2Manifold* manifold)
 {
 	b2Manifold oldManifold = m_manifold;
 
@@ -182,7 +182,14 @@ void b2Contact::Update(b2ContactListener* listener)
 	}
 	else
 	{
-		Evaluate(&m_manifold, xfA, xfB);
+		if (manifold)
+		{
+			m_manifold = *manifold;
+		}
+		else
+		{
+			Evaluate(&m_manifold, xfA, xfB);
+		}
 		touching = m_manifold.pointCount > 0;
 
 		// Match old contact ids to new contact ids and copy the
@@ -21,26 +21,12 @@
 #include <box2d/Dynamics/Contacts/b2Contact.h>
 #include <box2d/Dynamics/b2Body.h>
 #include <box2d/Dynamics/b2Fixture.h>
+#include <box2d/Dynamics/b2Island.h>
 #include <box2d/Dynamics/b2World.h>
 #include <box2d/Common/b2StackAllocator.h>
 
 #define B2_DEBUG_SOLVER 0
 
-struct b2ContactPositionConstraint
-{
-	b2Vec2 localPoints[b2_maxManifoldPoints];
-	b2Vec2 localNormal;
-	b2Vec2 localPoint;
-	int32 indexA;
-	int32 indexB;
-	float32 invMassA, invMassB;
-	b2Vec2 localCenterA, localCenterB;
-	float32 invIA, invIB;
-	b2Manifold::Type type;
-	float32 radiusA, radiusB;
-	int32 pointCount;
-};
-
 b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 {
 	m_step = def->step;
@@ -73,8 +59,8 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
 		vc->friction = contact->m_friction;
 		vc->restitution = contact->m_restitution;
-		vc->indexA = bodyA->m_islandIndex;
-		vc->indexB = bodyB->m_islandIndex;
+		vc->indexA = def->island->GetIndex(bodyA);
+		vc->indexB = def->island->GetIndex(bodyB);
 		vc->invMassA = bodyA->m_invMass;
 		vc->invMassB = bodyB->m_invMass;
 		vc->invIA = bodyA->m_invI;
@@ -85,8 +71,8 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 		vc->normalMass.SetZero();
 
 		b2ContactPositionConstraint* pc = m_positionConstraints + i;
-		pc->indexA = bodyA->m_islandIndex;
-		pc->indexB = bodyB->m_islandIndex;
+		pc->indexA = vc->indexA;
+		pc->indexB = vc->indexB;
 		pc->invMassA = bodyA->m_invMass;
 		pc->invMassB = bodyB->m_invMass;
 		pc->localCenterA = bodyA->m_sweep.localCenter;
@@ -129,6 +115,7 @@ b2ContactSolver::b2ContactSolver(b2ContactSolverDef* def)
 
 b2ContactSolver::~b2ContactSolver()
 {
+	m_wide.Clear();
 	m_allocator->Free(m_velocityConstraints);
 	m_allocator->Free(m_positionConstraints);
 }
@@ -243,6 +230,12 @@ void b2ContactSolver::InitializeVelocityConstraints()
 			}
 		}
 	}
+
+	if (m_step.wideSolver && b2WideContactSolver::IsSupported())
+	{
+		m_wide.Clear();
+		m_wide.Initialize(this);
+	}
 }
 
 void b2ContactSolver::WarmStart()
@@ -287,6 +280,12 @@ void b2ContactSolver::WarmStart()
 
 void b2ContactSolver::SolveVelocityConstraints()
 {
+	if (m_wide.IsActive())
+	{
+		m_wide.SolveVelocityConstraints();
+		return;
+	}
+
 	for (int32 i = 0; i < m_count; ++i)
 	{
 		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
@@ -596,6 +595,11 @@ void b2ContactSolver::SolveVelocityConstraints()
 
 void b2ContactSolver::StoreImpulses()
 {
+	if (m_wide.IsActive())
+	{
+		m_wide.StoreImpulses();
+	}
+
 	for (int32 i = 0; i < m_count; ++i)
 	{
 		b2ContactVelocityConstraint* vc = m_velocityConstraints + i;
@@ -663,6 +667,11 @@ struct b2PositionSolverManifold
 // Sequential solver.
 bool b2ContactSolver::SolvePositionConstraints()
 {
+	if (m_wide.IsActive())
+	{
+		return m_wide.SolvePositionConstraints();
+	}
+
 	float32 minSeparation = 0.0f;
 
 	for (int32 i = 0; i < m_count; ++i)
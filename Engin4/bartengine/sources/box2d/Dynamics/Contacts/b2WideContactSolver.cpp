@@ -0,0 +1,689 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: b2WideContactSolver.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <box2d/Dynamics/Contacts/b2WideContactSolver.h>
+#include <box2d/Dynamics/Contacts/b2ContactSolver.h>
+#include <box2d/Common/b2StackAllocator.h>
+#include <string.h>
+
+/// Batches being filled at the same time. A contact goes in the first one where it shares no moving body, more
+/// of them fill the lanes better.
+#define b2_wideOpenBatches 8
+
+#if B2_WIDE_MATH
+
+// Velocities of the bodies of the lanes
+struct b2BodyStateW
+{
+	b2FloatW vAX, vAY, wA;
+	b2FloatW vBX, vBY, wB;
+};
+
+static void b2GatherVelocities(const b2WideContactBatch& batch, const b2Velocity* velocities, b2BodyStateW* state)
+{
+	float32 vAX[b2_wideLanes], vAY[b2_wideLanes], wA[b2_wideLanes];
+	float32 vBX[b2_wideLanes], vBY[b2_wideLanes], wB[b2_wideLanes];
+
+	for (int32 i = 0; i < b2_wideLanes; ++i)
+	{
+		int32 indexA = batch.indexA[i];
+		int32 indexB = batch.indexB[i];
+		if (indexA < 0)
+		{
+			vAX[i] = vAY[i] = wA[i] = 0.0f;
+			vBX[i] = vBY[i] = wB[i] = 0.0f;
+			continue;
+		}
+
+		vAX[i] = velocities[indexA].v.x;
+		vAY[i] = velocities[indexA].v.y;
+		wA[i] = velocities[indexA].w;
+		vBX[i] = velocities[indexB].v.x;
+		vBY[i] = velocities[indexB].v.y;
+		wB[i] = velocities[indexB].w;
+	}
+
+	state->vAX = b2LoadW(vAX);
+	state->vAY = b2LoadW(vAY);
+	state->wA = b2LoadW(wA);
+	state->vBX = b2LoadW(vBX);
+	state->vBY = b2LoadW(vBY);
+	state->wB = b2LoadW(wB);
+}
+
+static void b2ScatterVelocities(const b2WideContactBatch& batch, const b2BodyStateW& state, b2Velocity* velocities)
+{
+	float32 vAX[b2_wideLanes], vAY[b2_wideLanes], wA[b2_wideLanes];
+	float32 vBX[b2_wideLanes], vBY[b2_wideLanes], wB[b2_wideLanes];
+	b2StoreW(vAX, state.vAX);
+	b2StoreW(vAY, state.vAY);
+	b2StoreW(wA, state.wA);
+	b2StoreW(vBX, state.vBX);
+	b2StoreW(vBY, state.vBY);
+	b2StoreW(wB, state.wB);
+
+	for (int32 i = 0; i < b2_wideLanes; ++i)
+	{
+		if (batch.moveA[i])
+		{
+			b2Velocity& v = velocities[batch.indexA[i]];
+			v.v.Set(vAX[i], vAY[i]);
+			v.w = wA[i];
+		}
+
+		if (batch.moveB[i])
+		{
+			b2Velocity& v = velocities[batch.indexB[i]];
+			v.v.Set(vBX[i], vBY[i]);
+			v.w = wB[i];
+		}
+	}
+}
+
+// Relative velocity at a contact point along an axis, b2Dot(vB + b2Cross(wB, rB) - vA - b2Cross(wA, rA), axis)
+static inline b2FloatW b2RelativeVelocityW(const b2BodyStateW& s, b2FloatW rAX, b2FloatW rAY, b2FloatW rBX,
+										   b2FloatW rBY, b2FloatW axisX, b2FloatW axisY)
+{
+	b2FloatW dvX = b2AddW(b2SubW(b2SubW(s.vBX, b2MulW(s.wB, rBY)), s.vAX), b2MulW(s.wA, rAY));
+	b2FloatW dvY = b2SubW(b2SubW(b2AddW(s.vBY, b2MulW(s.wB, rBX)), s.vAY), b2MulW(s.wA, rAX));
+	return b2AddW(b2MulW(dvX, axisX), b2MulW(dvY, axisY));
+}
+
+#endif
+
+b2WideContactSolver::b2WideContactSolver()
+{
+	m_solver = NULL;
+	m_batches = NULL;
+	m_batchCount = 0;
+}
+
+bool b2WideContactSolver::IsSupported()
+{
+	return b2IsWideSupported();
+}
+
+void b2WideContactSolver::Initialize(b2ContactSolver* solver)
+{
+	m_solver = solver;
+	m_batchCount = Group(NULL);
+	if (m_batchCount == 0)
+	{
+		return;
+	}
+
+	m_batches = (b2WideContactBatch*)solver->m_allocator->Allocate(m_batchCount * sizeof(b2WideContactBatch));
+	memset(m_batches, 0, m_batchCount * sizeof(b2WideContactBatch));
+	for (int32 i = 0; i < m_batchCount; ++i)
+	{
+		for (int32 j = 0; j < b2_wideLanes; ++j)
+		{
+			m_batches[i].constraint[j] = -1;
+			m_batches[i].indexA[j] = -1;
+			m_batches[i].indexB[j] = -1;
+		}
+	}
+
+	Group(m_batches);
+}
+
+void b2WideContactSolver::Clear()
+{
+	if (m_batches)
+	{
+		m_solver->m_allocator->Free(m_batches);
+		m_batches = NULL;
+	}
+
+	m_batchCount = 0;
+}
+
+// Greedy grouping in the order of the contacts, the same from one run to the next. Counts the batches when none
+// are given, fills them otherwise.
+int32 b2WideContactSolver::Group(b2WideContactBatch* batches)
+{
+	struct b2OpenBatch
+	{
+		int32 batch;
+		int32 count;
+		int32 bodies[2 * b2_wideLanes];
+	};
+
+	b2OpenBatch open[b2_wideOpenBatches];
+	int32 openCount = 0;
+	int32 batchCount = 0;
+
+	for (int32 i = 0; i < m_solver->m_count; ++i)
+	{
+		const b2ContactVelocityConstraint* vc = m_solver->m_velocityConstraints + i;
+
+		// The bodies no impulse moves can be shared by the lanes
+		int32 bodyA = vc->invMassA > 0.0f || vc->invIA > 0.0f ? vc->indexA : -1;
+		int32 bodyB = vc->invMassB > 0.0f || vc->invIB > 0.0f ? vc->indexB : -1;
+
+		int32 k = 0;
+		for (; k < openCount; ++k)
+		{
+			bool shared = false;
+			for (int32 j = 0; j < 2 * open[k].count; ++j)
+			{
+				int32 body = open[k].bodies[j];
+				if (body >= 0 && (body == bodyA || body == bodyB))
+				{
+					shared = true;
+					break;
+				}
+			}
+
+			if (shared == false)
+			{
+				break;
+			}
+		}
+
+		if (k == openCount)
+		{
+			if (openCount == b2_wideOpenBatches)
+			{
+				// The oldest one is solved with lanes left empty.
+				memmove(open, open + 1, (openCount - 1) * sizeof(b2OpenBatch));
+				--openCount;
+				k = openCount;
+			}
+
+			open[k].batch = batchCount++;
+			open[k].count = 0;
+			++openCount;
+		}
+
+		int32 lane = open[k].count++;
+		open[k].bodies[2 * lane + 0] = bodyA;
+		open[k].bodies[2 * lane + 1] = bodyB;
+
+		if (batches)
+		{
+			Fill(batches + open[k].batch, lane, i);
+		}
+
+		if (open[k].count == b2_wideLanes)
+		{
+			memmove(open + k, open + k + 1, (openCount - k - 1) * sizeof(b2OpenBatch));
+			--openCount;
+		}
+	}
+
+	return batchCount;
+}
+
+void b2WideContactSolver::Fill(b2WideContactBatch* batch, int32 lane, int32 index)
+{
+	const b2ContactVelocityConstraint* vc = m_solver->m_velocityConstraints + index;
+	const b2ContactPositionConstraint* pc = m_solver->m_positionConstraints + index;
+
+	batch->constraint[lane] = index;
+	batch->indexA[lane] = vc->indexA;
+	batch->indexB[lane] = vc->indexB;
+	batch->moveA[lane] = vc->invMassA > 0.0f || vc->invIA > 0.0f;
+	batch->moveB[lane] = vc->invMassB > 0.0f || vc->invIB > 0.0f;
+
+	batch->normalX[lane] = vc->normal.x;
+	batch->normalY[lane] = vc->normal.y;
+	batch->friction[lane] = vc->friction;
+	batch->invMassA[lane] = vc->invMassA;
+	batch->invIA[lane] = vc->invIA;
+	batch->invMassB[lane] = vc->invMassB;
+	batch->invIB[lane] = vc->invIB;
+
+	// The second point of a lane solved one point at a time stays at zero, it applies nothing.
+	for (int32 j = 0; j < vc->pointCount; ++j)
+	{
+		const b2VelocityConstraintPoint* vcp = vc->points + j;
+		batch->rAX[j][lane] = vcp->rA.x;
+		batch->rAY[j][lane] = vcp->rA.y;
+		batch->rBX[j][lane] = vcp->rB.x;
+		batch->rBY[j][lane] = vcp->rB.y;
+		batch->normalMass[j][lane] = vcp->normalMass;
+		batch->tangentMass[j][lane] = vcp->tangentMass;
+		batch->velocityBias[j][lane] = vcp->velocityBias;
+		batch->normalImpulse[j][lane] = vcp->normalImpulse;
+		batch->tangentImpulse[j][lane] = vcp->tangentImpulse;
+	}
+
+	batch->K[0][lane] = vc->K.ex.x;
+	batch->K[1][lane] = vc->K.ex.y;
+	batch->K[2][lane] = vc->K.ey.x;
+	batch->K[3][lane] = vc->K.ey.y;
+	batch->blockMass[0][lane] = vc->normalMass.ex.x;
+	batch->blockMass[1][lane] = vc->normalMass.ex.y;
+	batch->blockMass[2][lane] = vc->normalMass.ey.x;
+	batch->blockMass[3][lane] = vc->normalMass.ey.y;
+	batch->blockSolve[lane] = vc->pointCount == 2 ? -1 : 0;
+
+	batch->localCenterAX[lane] = pc->localCenterA.x;
+	batch->localCenterAY[lane] = pc->localCenterA.y;
+	batch->localCenterBX[lane] = pc->localCenterB.x;
+	batch->localCenterBY[lane] = pc->localCenterB.y;
+	batch->localNormalX[lane] = pc->localNormal.x;
+	batch->localNormalY[lane] = pc->localNormal.y;
+	batch->localPointX[lane] = pc->localPoint.x;
+	batch->localPointY[lane] = pc->localPoint.y;
+	batch->radiusA[lane] = pc->radiusA;
+	batch->radiusB[lane] = pc->radiusB;
+	batch->circles[lane] = pc->type == b2Manifold::e_circles ? -1 : 0;
+	batch->faceB[lane] = pc->type == b2Manifold::e_faceB ? -1 : 0;
+
+	for (int32 j = 0; j < pc->pointCount; ++j)
+	{
+		batch->localPointsX[j][lane] = pc->localPoints[j].x;
+		batch->localPointsY[j][lane] = pc->localPoints[j].y;
+		batch->positionPoints[j][lane] = -1;
+	}
+}
+
+void b2WideContactSolver::SolveVelocityConstraints()
+{
+#if B2_WIDE_MATH
+	b2Velocity* velocities = m_solver->m_velocities;
+	const b2FloatW zero = _mm_setzero_ps();
+
+	for (int32 i = 0; i < m_batchCount; ++i)
+	{
+		b2WideContactBatch& batch = m_batches[i];
+
+		b2BodyStateW s;
+		b2GatherVelocities(batch, velocities, &s);
+
+		b2FloatW mA = b2LoadW(batch.invMassA);
+		b2FloatW iA = b2LoadW(batch.invIA);
+		b2FloatW mB = b2LoadW(batch.invMassB);
+		b2FloatW iB = b2LoadW(batch.invIB);
+		b2FloatW normalX = b2LoadW(batch.normalX);
+		b2FloatW normalY = b2LoadW(batch.normalY);
+		b2FloatW tangentX = normalY;
+		b2FloatW tangentY = b2NegW(normalX);
+		b2FloatW friction = b2LoadW(batch.friction);
+		b2FloatW blockSolve = b2LoadMaskW(batch.blockSolve);
+
+		// Solve tangent constraints first because non-penetration is more important
+		// than friction.
+		for (int32 j = 0; j < b2_maxManifoldPoints; ++j)
+		{
+			b2FloatW rAX = b2LoadW(batch.rAX[j]);
+			b2FloatW rAY = b2LoadW(batch.rAY[j]);
+			b2FloatW rBX = b2LoadW(batch.rBX[j]);
+			b2FloatW rBY = b2LoadW(batch.rBY[j]);
+			b2FloatW tangentImpulse = b2LoadW(batch.tangentImpulse[j]);
+
+			b2FloatW vt = b2RelativeVelocityW(s, rAX, rAY, rBX, rBY, tangentX, tangentY);
+			b2FloatW lambda = b2MulW(b2LoadW(batch.tangentMass[j]), b2NegW(vt));
+
+			// b2Clamp the accumulated force
+			b2FloatW maxFriction = b2MulW(friction, b2LoadW(batch.normalImpulse[j]));
+			b2FloatW newImpulse = b2MaxW(b2NegW(maxFriction), b2MinW(b2AddW(tangentImpulse, lambda), maxFriction));
+			lambda = b2SubW(newImpulse, tangentImpulse);
+			b2StoreW(batch.tangentImpulse[j], newImpulse);
+
+			// Apply contact impulse
+			b2FloatW PX = b2MulW(lambda, tangentX);
+			b2FloatW PY = b2MulW(lambda, tangentY);
+
+			b2BodyStateW n;
+			n.vAX = b2SubW(s.vAX, b2MulW(mA, PX));
+			n.vAY = b2SubW(s.vAY, b2MulW(mA, PY));
+			n.wA = b2SubW(s.wA, b2MulW(iA, b2CrossW(rAX, rAY, PX, PY)));
+
+			n.vBX = b2AddW(s.vBX, b2MulW(mB, PX));
+			n.vBY = b2AddW(s.vBY, b2MulW(mB, PY));
+			n.wB = b2AddW(s.wB, b2MulW(iB, b2CrossW(rBX, rBY, PX, PY)));
+
+			if (j == 0)
+			{
+				s = n;
+			}
+			else
+			{
+				// Only the lanes with two points have a second one
+				s.vAX = b2SelectW(blockSolve, n.vAX, s.vAX);
+				s.vAY = b2SelectW(blockSolve, n.vAY, s.vAY);
+				s.wA = b2SelectW(blockSolve, n.wA, s.wA);
+				s.vBX = b2SelectW(blockSolve, n.vBX, s.vBX);
+				s.vBY = b2SelectW(blockSolve, n.vBY, s.vBY);
+				s.wB = b2SelectW(blockSolve, n.wB, s.wB);
+			}
+		}
+
+		// Solve normal constraints, one point or both as the block solver of b2ContactSolver
+		b2FloatW r1AX = b2LoadW(batch.rAX[0]);
+		b2FloatW r1AY = b2LoadW(batch.rAY[0]);
+		b2FloatW r1BX = b2LoadW(batch.rBX[0]);
+		b2FloatW r1BY = b2LoadW(batch.rBY[0]);
+		b2FloatW r2AX = b2LoadW(batch.rAX[1]);
+		b2FloatW r2AY = b2LoadW(batch.rAY[1]);
+		b2FloatW r2BX = b2LoadW(batch.rBX[1]);
+		b2FloatW r2BY = b2LoadW(batch.rBY[1]);
+		b2FloatW a1 = b2LoadW(batch.normalImpulse[0]);
+		b2FloatW a2 = b2LoadW(batch.normalImpulse[1]);
+		b2FloatW normalMass1 = b2LoadW(batch.normalMass[0]);
+
+		b2FloatW vn1 = b2RelativeVelocityW(s, r1AX, r1AY, r1BX, r1BY, normalX, normalY);
+		b2FloatW vn2 = b2RelativeVelocityW(s, r2AX, r2AY, r2BX, r2BY, normalX, normalY);
+
+		// One point
+		b2FloatW lambda = b2MulW(b2NegW(normalMass1), b2SubW(vn1, b2LoadW(batch.velocityBias[0])));
+		b2FloatW single1 = b2MaxW(b2AddW(a1, lambda), zero);
+
+		// Two points
+		b2FloatW bX = b2SubW(vn1, b2LoadW(batch.velocityBias[0]));
+		b2FloatW bY = b2SubW(vn2, b2LoadW(batch.velocityBias[1]));
+		b2FloatW k11 = b2LoadW(batch.K[0]);
+		b2FloatW k12 = b2LoadW(batch.K[1]);
+		b2FloatW k21 = b2LoadW(batch.K[2]);
+		b2FloatW k22 = b2LoadW(batch.K[3]);
+		bX = b2SubW(bX, b2AddW(b2MulW(k11, a1), b2MulW(k21, a2)));
+		bY = b2SubW(bY, b2AddW(b2MulW(k12, a1), b2MulW(k22, a2)));
+
+		// Case 1: vn = 0
+		b2FloatW x1 = b2NegW(b2AddW(b2MulW(b2LoadW(batch.blockMass[0]), bX), b2MulW(b2LoadW(batch.blockMass[2]), bY)));
+		b2FloatW x2 = b2NegW(b2AddW(b2MulW(b2LoadW(batch.blockMass[1]), bX), b2MulW(b2LoadW(batch.blockMass[3]), bY)));
+		b2FloatW case1 = b2AndW(b2GreaterEqualW(x1, zero), b2GreaterEqualW(x2, zero));
+
+		// Case 2: vn1 = 0 and x2 = 0
+		b2FloatW case2X1 = b2MulW(b2NegW(normalMass1), bX);
+		b2FloatW case2 = b2AndW(b2GreaterEqualW(case2X1, zero), b2GreaterEqualW(b2AddW(b2MulW(k12, case2X1), bY), zero));
+
+		// Case 3: vn2 = 0 and x1 = 0
+		b2FloatW case3X2 = b2MulW(b2NegW(b2LoadW(batch.normalMass[1])), bY);
+		b2FloatW case3 = b2AndW(b2GreaterEqualW(case3X2, zero), b2GreaterEqualW(b2AddW(b2MulW(k21, case3X2), bX), zero));
+
+		// Case 4: x1 = 0 and x2 = 0
+		b2FloatW case4 = b2AndW(b2GreaterEqualW(bX, zero), b2GreaterEqualW(bY, zero));
+
+		// The first valid case, none leaves the lane as it is
+		x1 = b2SelectW(case1, x1, b2SelectW(case2, case2X1, zero));
+		x2 = b2SelectW(case1, x2, b2SelectW(case2, zero, b2SelectW(case3, case3X2, zero)));
+		b2FloatW solved = b2OrW(b2OrW(case1, case2), b2OrW(case3, case4));
+
+		// Lanes with one point only use the first impulse, the second one stays at zero
+		x1 = b2SelectW(blockSolve, b2SelectW(solved, x1, a1), single1);
+		x2 = b2SelectW(blockSolve, b2SelectW(solved, x2, a2), a2);
+		b2StoreW(batch.normalImpulse[0], x1);
+		b2StoreW(batch.normalImpulse[1], x2);
+
+		// Apply incremental impulse
+		b2FloatW d1 = b2SubW(x1, a1);
+		b2FloatW d2 = b2SubW(x2, a2);
+		b2FloatW P1X = b2MulW(d1, normalX);
+		b2FloatW P1Y = b2MulW(d1, normalY);
+		b2FloatW P2X = b2MulW(d2, normalX);
+		b2FloatW P2Y = b2MulW(d2, normalY);
+
+		b2BodyStateW single;
+		single.vAX = b2SubW(s.vAX, b2MulW(mA, P1X));
+		single.vAY = b2SubW(s.vAY, b2MulW(mA, P1Y));
+		single.wA = b2SubW(s.wA, b2MulW(iA, b2CrossW(r1AX, r1AY, P1X, P1Y)));
+		single.vBX = b2AddW(s.vBX, b2MulW(mB, P1X));
+		single.vBY = b2AddW(s.vBY, b2MulW(mB, P1Y));
+		single.wB = b2AddW(s.wB, b2MulW(iB, b2CrossW(r1BX, r1BY, P1X, P1Y)));
+
+		b2FloatW PX = b2AddW(P1X, P2X);
+		b2FloatW PY = b2AddW(P1Y, P2Y);
+		b2BodyStateW block;
+		block.vAX = b2SubW(s.vAX, b2MulW(mA, PX));
+		block.vAY = b2SubW(s.vAY, b2MulW(mA, PY));
+		block.wA = b2SubW(s.wA, b2MulW(iA, b2AddW(b2CrossW(r1AX, r1AY, P1X, P1Y), b2CrossW(r2AX, r2AY, P2X, P2Y))));
+		block.vBX = b2AddW(s.vBX, b2MulW(mB, PX));
+		block.vBY = b2AddW(s.vBY, b2MulW(mB, PY));
+		block.wB = b2AddW(s.wB, b2MulW(iB, b2AddW(b2CrossW(r1BX, r1BY, P1X, P1Y), b2CrossW(r2BX, r2BY, P2X, P2Y))));
+
+		b2FloatW applied = b2SelectW(blockSolve, solved, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+		s.vAX = b2SelectW(applied, b2SelectW(blockSolve, block.vAX, single.vAX), s.vAX);
+		s.vAY = b2SelectW(applied, b2SelectW(blockSolve, block.vAY, single.vAY), s.vAY);
+		s.wA = b2SelectW(applied, b2SelectW(blockSolve, block.wA, single.wA), s.wA);
+		s.vBX = b2SelectW(applied, b2SelectW(blockSolve, block.vBX, single.vBX), s.vBX);
+		s.vBY = b2SelectW(applied, b2SelectW(blockSolve, block.vBY, single.vBY), s.vBY);
+		s.wB = b2SelectW(applied, b2SelectW(blockSolve, block.wB, single.wB), s.wB);
+
+		b2ScatterVelocities(batch, s, velocities);
+	}
+#endif
+}
+
+
+void b2WideContactSolver::StoreImpulses()
+{
+	for (int32 i = 0; i < m_batchCount; ++i)
+	{
+		const b2WideContactBatch& batch = m_batches[i];
+		for (int32 j = 0; j < b2_wideLanes; ++j)
+		{
+			if (batch.constraint[j] < 0)
+			{
+				continue;
+			}
+
+			b2ContactVelocityConstraint* vc = m_solver->m_velocityConstraints + batch.constraint[j];
+			for (int32 k = 0; k < vc->pointCount; ++k)
+			{
+				vc->points[k].normalImpulse = batch.normalImpulse[k][j];
+				vc->points[k].tangentImpulse = batch.tangentImpulse[k][j];
+			}
+		}
+	}
+}
+
+bool b2WideContactSolver::SolvePositionConstraints()
+{
+#if B2_WIDE_MATH
+	b2Position* positions = m_solver->m_positions;
+	const b2FloatW zero = _mm_setzero_ps();
+	b2FloatW minSeparation = zero;
+
+	for (int32 i = 0; i < m_batchCount; ++i)
+	{
+		const b2WideContactBatch& batch = m_batches[i];
+
+		float32 cAX[b2_wideLanes], cAY[b2_wideLanes], aA[b2_wideLanes];
+		float32 cBX[b2_wideLanes], cBY[b2_wideLanes], aB[b2_wideLanes];
+		for (int32 j = 0; j < b2_wideLanes; ++j)
+		{
+			int32 indexA = batch.indexA[j];
+			int32 indexB = batch.indexB[j];
+			if (indexA < 0)
+			{
+				cAX[j] = cAY[j] = aA[j] = 0.0f;
+				cBX[j] = cBY[j] = aB[j] = 0.0f;
+				continue;
+			}
+
+			cAX[j] = positions[indexA].c.x;
+			cAY[j] = positions[indexA].c.y;
+			aA[j] = positions[indexA].a;
+			cBX[j] = positions[indexB].c.x;
+			cBY[j] = positions[indexB].c.y;
+			aB[j] = positions[indexB].a;
+		}
+
+		b2FloatW mA = b2LoadW(batch.invMassA);
+		b2FloatW iA = b2LoadW(batch.invIA);
+		b2FloatW mB = b2LoadW(batch.invMassB);
+		b2FloatW iB = b2LoadW(batch.invIB);
+		b2FloatW localCenterAX = b2LoadW(batch.localCenterAX);
+		b2FloatW localCenterAY = b2LoadW(batch.localCenterAY);
+		b2FloatW localCenterBX = b2LoadW(batch.localCenterBX);
+		b2FloatW localCenterBY = b2LoadW(batch.localCenterBY);
+		b2FloatW circles = b2LoadMaskW(batch.circles);
+		b2FloatW faceB = b2LoadMaskW(batch.faceB);
+		b2FloatW radiusA = b2LoadW(batch.radiusA);
+		b2FloatW radiusB = b2LoadW(batch.radiusB);
+
+		for (int32 j = 0; j < b2_maxManifoldPoints; ++j)
+		{
+			b2FloatW active = b2LoadMaskW(batch.positionPoints[j]);
+			if (_mm_movemask_ps(active) == 0)
+			{
+				break;
+			}
+
+			// b2Rot::Set of each lane, the positions moved with the previous point
+			float32 sA[b2_wideLanes], cosA[b2_wideLanes], sB[b2_wideLanes], cosB[b2_wideLanes];
+			for (int32 k = 0; k < b2_wideLanes; ++k)
+			{
+				sA[k] = sinf(aA[k]);
+				cosA[k] = cosf(aA[k]);
+				sB[k] = sinf(aB[k]);
+				cosB[k] = cosf(aB[k]);
+			}
+
+			b2FloatW qAS = b2LoadW(sA);
+			b2FloatW qAC = b2LoadW(cosA);
+			b2FloatW qBS = b2LoadW(sB);
+			b2FloatW qBC = b2LoadW(cosB);
+			b2FloatW pAX = b2LoadW(cAX);
+			b2FloatW pAY = b2LoadW(cAY);
+			b2FloatW pBX = b2LoadW(cBX);
+			b2FloatW pBY = b2LoadW(cBY);
+			b2FloatW angleA = b2LoadW(aA);
+			b2FloatW angleB = b2LoadW(aB);
+
+			// xf.p = c - b2Mul(xf.q, localCenter)
+			b2FloatW xfAX = b2SubW(pAX, b2SubW(b2MulW(qAC, localCenterAX), b2MulW(qAS, localCenterAY)));
+			b2FloatW xfAY = b2SubW(pAY, b2AddW(b2MulW(qAS, localCenterAX), b2MulW(qAC, localCenterAY)));
+			b2FloatW xfBX = b2SubW(pBX, b2SubW(b2MulW(qBC, localCenterBX), b2MulW(qBS, localCenterBY)));
+			b2FloatW xfBY = b2SubW(pBY, b2AddW(b2MulW(qBS, localCenterBX), b2MulW(qBC, localCenterBY)));
+
+			// b2PositionSolverManifold, the reference face is on B for e_faceB and on A otherwise
+			b2FloatW refS = b2SelectW(faceB, qBS, qAS);
+			b2FloatW refC = b2SelectW(faceB, qBC, qAC);
+			b2FloatW refX = b2SelectW(faceB, xfBX, xfAX);
+			b2FloatW refY = b2SelectW(faceB, xfBY, xfAY);
+			b2FloatW incS = b2SelectW(faceB, qAS, qBS);
+			b2FloatW incC = b2SelectW(faceB, qAC, qBC);
+			b2FloatW incX = b2SelectW(faceB, xfAX, xfBX);
+			b2FloatW incY = b2SelectW(faceB, xfAY, xfBY);
+
+			b2FloatW localNormalX = b2LoadW(batch.localNormalX);
+			b2FloatW localNormalY = b2LoadW(batch.localNormalY);
+			b2FloatW localPointX = b2LoadW(batch.localPointX);
+			b2FloatW localPointY = b2LoadW(batch.localPointY);
+			b2FloatW localClipX = b2LoadW(batch.localPointsX[j]);
+			b2FloatW localClipY = b2LoadW(batch.localPointsY[j]);
+
+			b2FloatW planeX = b2AddW(b2SubW(b2MulW(refC, localPointX), b2MulW(refS, localPointY)), refX);
+			b2FloatW planeY = b2AddW(b2AddW(b2MulW(refS, localPointX), b2MulW(refC, localPointY)), refY);
+			b2FloatW clipX = b2AddW(b2SubW(b2MulW(incC, localClipX), b2MulW(incS, localClipY)), incX);
+			b2FloatW clipY = b2AddW(b2AddW(b2MulW(incS, localClipX), b2MulW(incC, localClipY)), incY);
+			b2FloatW dX = b2SubW(clipX, planeX);
+			b2FloatW dY = b2SubW(clipY, planeY);
+
+			// e_faceA and e_faceB
+			b2FloatW normalX = b2SubW(b2MulW(refC, localNormalX), b2MulW(refS, localNormalY));
+			b2FloatW normalY = b2AddW(b2MulW(refS, localNormalX), b2MulW(refC, localNormalY));
+			b2FloatW pointX = clipX;
+			b2FloatW pointY = clipY;
+
+			// e_circles, the normal from the center on A to the one on B
+			b2FloatW length = _mm_sqrt_ps(b2AddW(b2MulW(dX, dX), b2MulW(dY, dY)));
+			b2FloatW invLength = _mm_div_ps(b2SplatW(1.0f), length);
+			b2FloatW normalize = b2GreaterEqualW(length, b2SplatW(b2_epsilon));
+			b2FloatW circleNormalX = b2SelectW(normalize, b2MulW(dX, invLength), dX);
+			b2FloatW circleNormalY = b2SelectW(normalize, b2MulW(dY, invLength), dY);
+			b2FloatW half = b2SplatW(0.5f);
+
+			normalX = b2SelectW(circles, circleNormalX, normalX);
+			normalY = b2SelectW(circles, circleNormalY, normalY);
+			pointX = b2SelectW(circles, b2MulW(half, b2AddW(planeX, clipX)), pointX);
+			pointY = b2SelectW(circles, b2MulW(half, b2AddW(planeY, clipY)), pointY);
+
+			b2FloatW separation = b2AddW(b2MulW(dX, normalX), b2MulW(dY, normalY));
+			separation = b2SubW(b2SubW(separation, radiusA), radiusB);
+
+			// Ensure normal points from A to B
+			normalX = b2SelectW(faceB, b2NegW(normalX), normalX);
+			normalY = b2SelectW(faceB, b2NegW(normalY), normalY);
+
+			b2FloatW rAX = b2SubW(pointX, pAX);
+			b2FloatW rAY = b2SubW(pointY, pAY);
+			b2FloatW rBX = b2SubW(pointX, pBX);
+			b2FloatW rBY = b2SubW(pointY, pBY);
+
+			// Track max constraint error.
+			minSeparation = b2SelectW(active, b2MinW(minSeparation, separation), minSeparation);
+
+			// Prevent large corrections and allow slop.
+			b2FloatW C = b2MulW(b2SplatW(b2_baumgarte), b2AddW(separation, b2SplatW(b2_linearSlop)));
+			C = b2MaxW(b2SplatW(-b2_maxLinearCorrection), b2MinW(C, zero));
+
+			// Compute the effective mass.
+			b2FloatW rnA = b2CrossW(rAX, rAY, normalX, normalY);
+			b2FloatW rnB = b2CrossW(rBX, rBY, normalX, normalY);
+			b2FloatW K = b2AddW(b2AddW(b2AddW(mA, mB), b2MulW(b2MulW(iA, rnA), rnA)), b2MulW(b2MulW(iB, rnB), rnB));
+
+			// Compute normal impulse
+			b2FloatW impulse = b2AndW(_mm_cmpgt_ps(K, zero), _mm_div_ps(b2NegW(C), K));
+
+			b2FloatW PX = b2MulW(impulse, normalX);
+			b2FloatW PY = b2MulW(impulse, normalY);
+
+			b2StoreW(cAX, b2SelectW(active, b2SubW(pAX, b2MulW(mA, PX)), pAX));
+			b2StoreW(cAY, b2SelectW(active, b2SubW(pAY, b2MulW(mA, PY)), pAY));
+			b2StoreW(aA, b2SelectW(active, b2SubW(angleA, b2MulW(iA, b2CrossW(rAX, rAY, PX, PY))), angleA));
+
+			b2StoreW(cBX, b2SelectW(active, b2AddW(pBX, b2MulW(mB, PX)), pBX));
+			b2StoreW(cBY, b2SelectW(active, b2AddW(pBY, b2MulW(mB, PY)), pBY));
+			b2StoreW(aB, b2SelectW(active, b2AddW(angleB, b2MulW(iB, b2CrossW(rBX, rBY, PX, PY))), angleB));
+		}
+
+		for (int32 j = 0; j < b2_wideLanes; ++j)
+		{
+			if (batch.moveA[j])
+			{
+				positions[batch.indexA[j]].c.Set(cAX[j], cAY[j]);
+				positions[batch.indexA[j]].a = aA[j];
+			}
+
+			if (batch.moveB[j])
+			{
+				positions[batch.indexB[j]].c.Set(cBX[j], cBY[j]);
+				positions[batch.indexB[j]].a = aB[j];
+			}
+		}
+	}
+
+	float32 separations[b2_wideLanes];
+	b2StoreW(separations, minSeparation);
+	float32 separation = 0.0f;
+	for (int32 i = 0; i < b2_wideLanes; ++i)
+	{
+		separation = b2Min(separation, separations[i]);
+	}
+
+	// We can't expect minSpeparation >= -b2_linearSlop because we don't
+	// push the separation above -b2_linearSlop.
+	return separation >= -3.0f * b2_linearSlop;
+#else
+	return true;
+#endif
+}
\ No newline at end of file
@@ -18,6 +18,7 @@
 
 #include <box2d/Dynamics/Joints/b2DistanceJoint.h>
 #include <box2d/Dynamics/b2Body.h>
+#include <box2d/Dynamics/b2Island.h>
 #include <box2d/Dynamics/b2TimeStep.h>
 
 // 1-D constrained system
@@ -61,8 +62,8 @@ b2DistanceJoint::b2DistanceJoint(const b2DistanceJointDef* def)
 
 void b2DistanceJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexA = data.island->GetIndex(m_bodyA);
+	m_indexB = data.island->GetIndex(m_bodyB);
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -18,6 +18,7 @@
 
 #include <box2d/Dynamics/Joints/b2PrismaticJoint.h>
 #include <box2d/Dynamics/b2Body.h>
+#include <box2d/Dynamics/b2Island.h>
 #include <box2d/Dynamics/b2TimeStep.h>
 
 // Linear constraint (point-to-line)
@@ -124,8 +125,8 @@ b2PrismaticJoint::b2PrismaticJoint(const b2PrismaticJointDef* def)
 
 void b2PrismaticJoint::InitVelocityConstraints(const b2SolverData& data)
 {
-	m_indexA = m_bodyA->m_islandIndex;
-	m_indexB = m_bodyB->m_islandIndex;
+	m_indexA = data.island->GetIndex(m_bodyA);
+	m_indexB = data.island->GetIndex(m_bodyB);
 	m_localCenterA = m_bodyA->m_sweep.localCenter;
 	m_localCenterB = m_bodyB->m_sweep.localCenter;
 	m_invMassA = m_bodyA->m_invMass;
@@ -123,6 +123,7 @@ void b2Body::SetType(b2BodyType type)
 		return;
 	}
 
+	bool wasStatic = m_type == b2_staticBody;
 	m_type = type;
 
 	ResetMassData();
@@ -136,6 +137,20 @@ void b2Body::SetType(b2BodyType type)
 		SynchronizeFixtures();
 	}
 
+	// The static proxies are in a tree of their own.
+	if (wasStatic != (m_type == b2_staticBody))
+	{
+		b2BroadPhase* broadPhase = &m_world->m_contactManager.m_broadPhase;
+		for (b2Fixture* f = m_fixtureList; f; f = f->m_next)
+		{
+			if (f->m_proxyCount > 0)
+			{
+				f->DestroyProxies(broadPhase);
+				f->CreateProxies(broadPhase, m_xf);
+			}
+		}
+	}
+
 	SetAwake(true);
 
 	m_force.SetZero();
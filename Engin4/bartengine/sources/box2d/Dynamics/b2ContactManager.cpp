@@ -21,6 +21,9 @@
 #include <box2d/Dynamics/b2Fixture.h>
 #include <box2d/Dynamics/b2WorldCallbacks.h>
 #include <box2d/Dynamics/Contacts/b2Contact.h>
+#include <box2d/Collision/Shapes/b2CircleShape.h>
+#include <box2d/Collision/Shapes/b2PolygonShape.h>
+#include <box2d/Common/b2WideMath.h>
 
 b2ContactFilter b2_defaultFilter;
 b2ContactListener b2_defaultListener;
@@ -32,6 +35,7 @@ b2ContactManager::b2ContactManager()
 	m_contactFilter = &b2_defaultFilter;
 	m_contactListener = &b2_defaultListener;
 	m_allocator = NULL;
+	m_wideCollide = false;
 }
 
 void b2ContactManager::Destroy(b2Contact* c)
@@ -99,73 +103,267 @@ void b2ContactManager::Destroy(b2Contact* c)
 	--m_contactCount;
 }
 
+// Is the contact destroyed, left alone because its bodies sleep, or updated.
+b2ContactManager::CheckResult b2ContactManager::Check(b2Contact* c)
+{
+	b2Fixture* fixtureA = c->GetFixtureA();
+	b2Fixture* fixtureB = c->GetFixtureB();
+	int32 indexA = c->GetChildIndexA();
+	int32 indexB = c->GetChildIndexB();
+	b2Body* bodyA = fixtureA->GetBody();
+	b2Body* bodyB = fixtureB->GetBody();
+
+	// Is this contact flagged for filtering?
+	if (c->m_flags & b2Contact::e_filterFlag)
+	{
+		// Should these bodies collide?
+		if (bodyB->ShouldCollide(bodyA) == false)
+		{
+			return e_checkDestroy;
+		}
+
+		// Check user filtering.
+		if (m_contactFilter && m_contactFilter->ShouldCollide(fixtureA, fixtureB) == false)
+		{
+			return e_checkDestroy;
+		}
+
+		// Clear the filtering flag.
+		c->m_flags &= ~b2Contact::e_filterFlag;
+	}
+
+	bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
+	bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+
+	// At least one body must be awake and it must be dynamic or kinematic.
+	if (activeA == false && activeB == false)
+	{
+		return e_checkSleeping;
+	}
+
+	int32 proxyIdA = fixtureA->m_proxies[indexA].proxyId;
+	int32 proxyIdB = fixtureB->m_proxies[indexB].proxyId;
+	bool overlap = m_broadPhase.TestOverlap(proxyIdA, proxyIdB);
+
+	// Here we destroy contacts that cease to overlap in the broad-phase.
+	if (overlap == false)
+	{
+		return e_checkDestroy;
+	}
+
+	// The contact persists.
+	return e_checkUpdate;
+}
+
 // This is the top level collision call for the time step. Here
 // all the narrow phase collision is processed for the world
 // contact list.
 void b2ContactManager::Collide()
 {
+	if (m_wideCollide)
+	{
+		CollideWide();
+		return;
+	}
+
 	// Update awake contacts.
 	b2Contact* c = m_contactList;
 	while (c)
 	{
-		b2Fixture* fixtureA = c->GetFixtureA();
-		b2Fixture* fixtureB = c->GetFixtureB();
-		int32 indexA = c->GetChildIndexA();
-		int32 indexB = c->GetChildIndexB();
-		b2Body* bodyA = fixtureA->GetBody();
-		b2Body* bodyB = fixtureB->GetBody();
+		b2Contact* next = c->GetNext();
 
-		// Is this contact flagged for filtering?
-		if (c->m_flags & b2Contact::e_filterFlag)
+		switch (Check(c))
 		{
-			// Should these bodies collide?
-			if (bodyB->ShouldCollide(bodyA) == false)
-			{
-				b2Contact* cNuke = c;
-				c = cNuke->GetNext();
-				Destroy(cNuke);
-				continue;
-			}
+		case e_checkDestroy:
+			Destroy(c);
+			break;
 
-			// Check user filtering.
-			if (m_contactFilter && m_contactFilter->ShouldCollide(fixtureA, fixtureB) == false)
-			{
-				b2Contact* cNuke = c;
-				c = cNuke->GetNext();
-				Destroy(cNuke);
-				continue;
-			}
+		case e_checkSleeping:
+			break;
 
-			// Clear the filtering flag.
-			c->m_flags &= ~b2Contact::e_filterFlag;
+		case e_checkUpdate:
+			c->Update(m_contactListener);
+			break;
 		}
 
-		bool activeA = bodyA->IsAwake() && bodyA->m_type != b2_staticBody;
-		bool activeB = bodyB->IsAwake() && bodyB->m_type != b2_staticBody;
+		c = next;
+	}
+}
+
+// Same narrow phase as Collide, in windows of the contact list small enough to
+// stay in the cache. The contacts of a window are sorted in groups of shape pairs,
+// the manifolds of each group are computed together, boxes b2_wideLanes at a
+// time, then the contacts are updated in the order of the list with their
+// manifold so the listener sees the same calls.
+void b2ContactManager::CollideWide()
+{
+	b2Contact* c = m_contactList;
+	while (c)
+	{
+		int32 entryCount = CollectWide(&c);
+		CollideWide(entryCount);
+		UpdateWide(entryCount);
+	}
+}
+
+// Sort the contacts of the next window and move to the contact after it.
+int32 b2ContactManager::CollectWide(b2Contact** next)
+{
+	int32 entryCount = 0;
+	for (b2Contact* c = *next; c && entryCount < b2_wideCollideWindow; c = c->GetNext())
+	{
+		*next = c->GetNext();
+		WideEntry* entry = m_wideEntries + entryCount;
+		++entryCount;
+		entry->contact = c;
 
-		// At least one body must be awake and it must be dynamic or kinematic.
-		if (activeA == false && activeB == false)
+		CheckResult result = Check(c);
+		if (result == e_checkDestroy)
 		{
-			c = c->GetNext();
+			entry->bucket = WideEntry::e_destroy;
 			continue;
 		}
 
-		int32 proxyIdA = fixtureA->m_proxies[indexA].proxyId;
-		int32 proxyIdB = fixtureB->m_proxies[indexB].proxyId;
-		bool overlap = m_broadPhase.TestOverlap(proxyIdA, proxyIdB);
+		if (result == e_checkSleeping)
+		{
+			entry->bucket = WideEntry::e_sleeping;
+			continue;
+		}
 
-		// Here we destroy contacts that cease to overlap in the broad-phase.
-		if (overlap == false)
+		// Sensors and the other shape pairs are evaluated by their contact.
+		entry->bucket = WideEntry::e_evaluate;
+
+		b2Fixture* fixtureA = c->GetFixtureA();
+		b2Fixture* fixtureB = c->GetFixtureB();
+		if (fixtureA->IsSensor() || fixtureB->IsSensor())
 		{
-			b2Contact* cNuke = c;
-			c = cNuke->GetNext();
-			Destroy(cNuke);
 			continue;
 		}
 
-		// The contact persists.
-		c->Update(m_contactListener);
-		c = c->GetNext();
+		b2Shape::Type typeA = fixtureA->GetType();
+		b2Shape::Type typeB = fixtureB->GetType();
+		if (typeA == b2Shape::e_circle && typeB == b2Shape::e_circle)
+		{
+			entry->bucket = WideEntry::e_circles;
+		}
+		else if (typeA == b2Shape::e_polygon && typeB == b2Shape::e_polygon)
+		{
+			const b2PolygonShape* polygonA = (b2PolygonShape*)fixtureA->GetShape();
+			const b2PolygonShape* polygonB = (b2PolygonShape*)fixtureB->GetShape();
+			if (polygonA->m_vertexCount == 4 && polygonB->m_vertexCount == 4)
+			{
+				entry->bucket = WideEntry::e_boxes;
+			}
+		}
+		else if (typeA == b2Shape::e_polygon && typeB == b2Shape::e_circle)
+		{
+			entry->bucket = WideEntry::e_polygonAndCircle;
+		}
+
+		// The manifold is only partly written when the shapes do not touch.
+		if (entry->bucket != WideEntry::e_evaluate)
+		{
+			entry->manifold = c->m_manifold;
+		}
+	}
+
+	return entryCount;
+}
+
+// Compute the manifolds of the window by group.
+void b2ContactManager::CollideWide(int32 entryCount)
+{
+	b2Manifold* boxManifolds[b2_wideLanes];
+	const b2PolygonShape* boxesA[b2_wideLanes];
+	const b2PolygonShape* boxesB[b2_wideLanes];
+	const b2Transform* boxXfsA[b2_wideLanes];
+	const b2Transform* boxXfsB[b2_wideLanes];
+	int32 boxCount = 0;
+
+	for (int32 i = 0; i < entryCount; ++i)
+	{
+		WideEntry* entry = m_wideEntries + i;
+		b2Fixture* fixtureA = entry->contact->GetFixtureA();
+		b2Fixture* fixtureB = entry->contact->GetFixtureB();
+
+		switch (entry->bucket)
+		{
+		case WideEntry::e_boxes:
+			boxManifolds[boxCount] = &entry->manifold;
+			boxesA[boxCount] = (b2PolygonShape*)fixtureA->GetShape();
+			boxesB[boxCount] = (b2PolygonShape*)fixtureB->GetShape();
+			boxXfsA[boxCount] = &fixtureA->GetBody()->GetTransform();
+			boxXfsB[boxCount] = &fixtureB->GetBody()->GetTransform();
+			if (++boxCount == b2_wideLanes)
+			{
+				b2CollideBoxes(boxManifolds, boxesA, boxXfsA, boxesB, boxXfsB, boxCount);
+				boxCount = 0;
+			}
+			break;
+
+		// A pair of circles is tested faster than its lanes are filled.
+		case WideEntry::e_circles:
+			b2CollideCircles(&entry->manifold,
+							 (b2CircleShape*)fixtureA->GetShape(), fixtureA->GetBody()->GetTransform(),
+							 (b2CircleShape*)fixtureB->GetShape(), fixtureB->GetBody()->GetTransform());
+			break;
+
+		case WideEntry::e_polygonAndCircle:
+			b2CollidePolygonAndCircle(&entry->manifold,
+									  (b2PolygonShape*)fixtureA->GetShape(), fixtureA->GetBody()->GetTransform(),
+									  (b2CircleShape*)fixtureB->GetShape(), fixtureB->GetBody()->GetTransform());
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	if (boxCount > 0)
+	{
+		b2CollideBoxes(boxManifolds, boxesA, boxXfsA, boxesB, boxXfsB, boxCount);
+	}
+}
+
+// Update the contacts of the window in the order of the list.
+void b2ContactManager::UpdateWide(int32 entryCount)
+{
+	for (int32 i = 0; i < entryCount; ++i)
+	{
+		WideEntry* entry = m_wideEntries + i;
+		b2Contact* c = entry->contact;
+
+		switch (entry->bucket)
+		{
+		case WideEntry::e_destroy:
+			Destroy(c);
+			break;
+
+		case WideEntry::e_sleeping:
+			// A contact updated before may have woken its bodies up.
+			switch (Check(c))
+			{
+			case e_checkDestroy:
+				Destroy(c);
+				break;
+
+			case e_checkSleeping:
+				break;
+
+			case e_checkUpdate:
+				c->Update(m_contactListener);
+				break;
+			}
+			break;
+
+		case WideEntry::e_evaluate:
+			c->Update(m_contactListener);
+			break;
+
+		default:
+			c->Update(m_contactListener, &entry->manifold);
+			break;
+		}
 	}
 }
 
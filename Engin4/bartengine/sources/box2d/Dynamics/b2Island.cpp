@@ -158,6 +158,7 @@ b2Island::b2Island(
 	m_bodyCount = 0;
 	m_contactCount = 0;
 	m_jointCount = 0;
+	m_staticCount = 0;
 
 	m_allocator = allocator;
 	m_listener = listener;
@@ -168,11 +169,13 @@ b2Island::b2Island(
 
 	m_velocities = (b2Velocity*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Velocity));
 	m_positions = (b2Position*)m_allocator->Allocate(m_bodyCapacity * sizeof(b2Position));
+	m_staticIndices = (int32*)m_allocator->Allocate(m_bodyCapacity * sizeof(int32));
 }
 
 b2Island::~b2Island()
 {
 	// Warning: the order should reverse the constructor order.
+	m_allocator->Free(m_staticIndices);
 	m_allocator->Free(m_positions);
 	m_allocator->Free(m_velocities);
 	m_allocator->Free(m_joints);
@@ -180,7 +183,8 @@ b2Island::~b2Island()
 	m_allocator->Free(m_bodies);
 }
 
-void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep)
+void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep,
+					 bool concurrent)
 {
 	b2Timer timer;
 
@@ -196,9 +200,12 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		b2Vec2 v = b->m_linearVelocity;
 		float32 w = b->m_angularVelocity;
 
-		// Store positions for continuous collision.
-		b->m_sweep.c0 = b->m_sweep.c;
-		b->m_sweep.a0 = b->m_sweep.a;
+		// Store positions for continuous collision. A static body never moves, they are already equal.
+		if (b->m_type != b2_staticBody)
+		{
+			b->m_sweep.c0 = b->m_sweep.c;
+			b->m_sweep.a0 = b->m_sweep.a;
+		}
 
 		if (b->m_type == b2_dynamicBody)
 		{
@@ -230,9 +237,11 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	solverData.step = step;
 	solverData.positions = m_positions;
 	solverData.velocities = m_velocities;
+	solverData.island = this;
 
 	// Initialize velocity constraints.
 	b2ContactSolverDef contactSolverDef;
+	contactSolverDef.island = this;
 	contactSolverDef.step = step;
 	contactSolverDef.contacts = m_contacts;
 	contactSolverDef.count = m_contactCount;
@@ -330,6 +339,12 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
+		if (body->m_type == b2_staticBody)
+		{
+			// Left as they were, no mass so the solvers did not move it.
+			continue;
+		}
+
 		body->m_sweep.c = m_positions[i].c;
 		body->m_sweep.a = m_positions[i].a;
 		body->m_linearVelocity = m_velocities[i].v;
@@ -375,6 +390,12 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 			for (int32 i = 0; i < m_bodyCount; ++i)
 			{
 				b2Body* b = m_bodies[i];
+				if (concurrent && b->GetType() == b2_staticBody)
+				{
+					// b2IslandSolver sets the static bodies asleep in the island order.
+					continue;
+				}
+
 				b->SetAwake(false);
 			}
 		}
@@ -397,6 +418,7 @@ void b2Island::SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiInd
 	}
 
 	b2ContactSolverDef contactSolverDef;
+	contactSolverDef.island = this;
 	contactSolverDef.contacts = m_contacts;
 	contactSolverDef.count = m_contactCount;
 	contactSolverDef.allocator = m_allocator;
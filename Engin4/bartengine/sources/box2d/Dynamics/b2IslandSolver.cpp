@@ -0,0 +1,253 @@
+/// -------------------------------------------------------------------------------------------------------------------
+/// BartEngine
+/// File: b2IslandSolver.cpp
+///
+/// Copyright (c) 2019-2020, David St-Cyr
+/// All rights reserved.
+///
+/// This software is provided 'as-is', without any express or implied warranty. In no event will the authors be held
+/// liable for any damages arising from the use of this software.
+///
+/// Permission is granted to anyone to use this software for any purpose, including commercial applications, and to
+/// alter it and redistribute it freely, subject to the following restrictions:
+///
+/// 1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software.
+///    If you use this software in a product, an acknowledgment in the product documentation would be appreciated but
+///    is not required.
+///
+/// 2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original
+///    software.
+///
+/// 3. This notice may not be removed or altered from any source distribution.
+///
+/// Author: David St-Cyr
+/// david.stcyr@bart.ca
+///
+/// -------------------------------------------------------------------------------------------------------------------
+#include <box2d/Dynamics/b2IslandSolver.h>
+#include <box2d/Dynamics/b2Island.h>
+#include <box2d/Dynamics/b2Body.h>
+#include <box2d/Dynamics/b2WorldCallbacks.h>
+#include <box2d/Dynamics/Contacts/b2Contact.h>
+#include <box2d/Common/b2StackAllocator.h>
+
+b2IslandSolver::b2IslandSolver()
+{
+	m_allowSleep = true;
+	m_gravity.SetZero();
+	m_generation = 0;
+	m_busy = 0;
+	m_stopping = false;
+	m_nextIsland = 0;
+}
+
+b2IslandSolver::~b2IslandSolver()
+{
+	Stop();
+}
+
+void b2IslandSolver::SetThreadCount(int32 count)
+{
+	Stop();
+
+	m_stopping = false;
+	for (int32 i = 1; i < count; ++i)
+	{
+		m_allocators.push_back(new b2StackAllocator());
+	}
+
+	// The workers wait for the solve after the last one, not the ones solved before they existed
+	for (int32 i = 1; i < count; ++i)
+	{
+		m_workers.push_back(std::thread(&b2IslandSolver::WorkerLoop, this, i - 1, m_generation));
+	}
+}
+
+void b2IslandSolver::Add(const b2Island& island)
+{
+	b2IslandRange range;
+	range.bodyStart = int32(m_bodies.size());
+	range.bodyCount = island.m_bodyCount;
+	range.contactStart = int32(m_contacts.size());
+	range.contactCount = island.m_contactCount;
+	range.jointStart = int32(m_joints.size());
+	range.jointCount = island.m_jointCount;
+	range.profile.solveInit = 0.0f;
+	range.profile.solveVelocity = 0.0f;
+	range.profile.solvePosition = 0.0f;
+
+	m_bodies.insert(m_bodies.end(), island.m_bodies, island.m_bodies + island.m_bodyCount);
+	m_contacts.insert(m_contacts.end(), island.m_contacts, island.m_contacts + island.m_contactCount);
+	m_joints.insert(m_joints.end(), island.m_joints, island.m_joints + island.m_jointCount);
+	m_islands.push_back(range);
+}
+
+void b2IslandSolver::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep,
+						   b2StackAllocator* allocator, b2ContactListener* listener)
+{
+	m_step = step;
+	m_gravity = gravity;
+	m_allowSleep = allowSleep;
+	m_nextIsland = 0;
+
+	if (m_workers.empty() || m_islands.size() < 2)
+	{
+		SolveIslands(allocator);
+	}
+	else
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_generation++;
+			m_busy = int32(m_workers.size());
+		}
+
+		m_startSignal.notify_all();
+		SolveIslands(allocator);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneSignal.wait(lock, [this]() { return m_busy == 0; });
+	}
+
+	// In the order the islands were built, whatever thread solved them
+	for (size_t i = 0; i < m_islands.size(); ++i)
+	{
+		const b2IslandRange& range = m_islands[i];
+		profile->solveInit += range.profile.solveInit;
+		profile->solveVelocity += range.profile.solveVelocity;
+		profile->solvePosition += range.profile.solvePosition;
+		SynchronizeStatics(range);
+		Report(range, listener);
+	}
+
+	m_islands.clear();
+	m_bodies.clear();
+	m_contacts.clear();
+	m_joints.clear();
+}
+
+void b2IslandSolver::SolveIslands(b2StackAllocator* allocator)
+{
+	const int32 count = int32(m_islands.size());
+
+	for (int32 i = m_nextIsland++; i < count; i = m_nextIsland++)
+	{
+		SolveIsland(m_islands[i], allocator);
+	}
+}
+
+void b2IslandSolver::SolveIsland(b2IslandRange& range, b2StackAllocator* allocator)
+{
+	// The post solve callbacks are raised later, from the calling thread
+	b2Island island(range.bodyCount, range.contactCount, range.jointCount, allocator, NULL);
+
+	// The island keeps the index of its static bodies itself, the other islands may hold them too
+	for (int32 i = 0; i < range.bodyCount; ++i)
+	{
+		island.Add(m_bodies[range.bodyStart + i]);
+	}
+
+	for (int32 i = 0; i < range.contactCount; ++i)
+	{
+		island.Add(m_contacts[range.contactStart + i]);
+	}
+
+	for (int32 i = 0; i < range.jointCount; ++i)
+	{
+		island.Add(m_joints[range.jointStart + i]);
+	}
+
+	island.Solve(&range.profile, m_step, m_gravity, m_allowSleep, true);
+}
+
+void b2IslandSolver::SynchronizeStatics(const b2IslandRange& range)
+{
+	// Solved one island after the other, a static body ends up awake unless the last island holding it fell
+	// asleep. The seed of an island is never static and sleeps with the rest of it.
+	const bool asleep = m_bodies[range.bodyStart]->IsAwake() == false;
+
+	for (int32 i = 0; i < range.bodyCount; ++i)
+	{
+		b2Body* b = m_bodies[range.bodyStart + i];
+		if (b->GetType() == b2_staticBody)
+		{
+			b->SetAwake(!asleep);
+		}
+	}
+}
+
+void b2IslandSolver::Report(const b2IslandRange& range, b2ContactListener* listener) const
+{
+	if (listener == NULL)
+	{
+		return;
+	}
+
+	// The impulses stored for warm starting are the ones b2Island::Report reads from the solver
+	for (int32 i = 0; i < range.contactCount; ++i)
+	{
+		b2Contact* c = m_contacts[range.contactStart + i];
+		const b2Manifold* manifold = c->GetManifold();
+
+		b2ContactImpulse impulse;
+		impulse.count = manifold->pointCount;
+		for (int32 j = 0; j < manifold->pointCount; ++j)
+		{
+			impulse.normalImpulses[j] = manifold->points[j].normalImpulse;
+			impulse.tangentImpulses[j] = manifold->points[j].tangentImpulse;
+		}
+
+		listener->PostSolve(c, &impulse);
+	}
+}
+
+void b2IslandSolver::WorkerLoop(int32 index, uint32 startGeneration)
+{
+	uint32 generation = startGeneration;
+
+	for (;;)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_startSignal.wait(lock, [this, generation]() { return m_stopping || m_generation != generation; });
+
+		if (m_stopping)
+		{
+			return;
+		}
+
+		generation = m_generation;
+		lock.unlock();
+
+		SolveIslands(m_allocators[index]);
+
+		lock.lock();
+		m_busy--;
+		if (m_busy == 0)
+		{
+			m_doneSignal.notify_one();
+		}
+	}
+}
+
+void b2IslandSolver::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+
+	m_startSignal.notify_all();
+
+	for (size_t i = 0; i < m_workers.size(); ++i)
+	{
+		m_workers[i].join();
+	}
+
+	for (size_t i = 0; i < m_allocators.size(); ++i)
+	{
+		delete m_allocators[i];
+	}
+
+	m_workers.clear();
+	m_allocators.clear();
+}
\ No newline at end of file
@@ -20,6 +20,7 @@
 #include <box2d/Dynamics/b2Body.h>
 #include <box2d/Dynamics/b2Fixture.h>
 #include <box2d/Dynamics/b2Island.h>
+#include <box2d/Dynamics/b2IslandSolver.h>
 #include <box2d/Dynamics/Joints/b2PulleyJoint.h>
 #include <box2d/Dynamics/Contacts/b2Contact.h>
 #include <box2d/Dynamics/Contacts/b2ContactSolver.h>
@@ -46,6 +47,7 @@ b2World::b2World(const b2Vec2& gravity)
 	m_jointCount = 0;
 
 	m_warmStarting = true;
+	m_wideSolver = false;
 	m_continuousPhysics = true;
 	m_subStepping = false;
 
@@ -61,6 +63,8 @@ b2World::b2World(const b2Vec2& gravity)
 	m_contactManager.m_allocator = &m_blockAllocator;
 
 	memset(&m_profile, 0, sizeof(b2Profile));
+
+	m_islandSolver = NULL;
 }
 
 b2World::~b2World()
@@ -82,6 +86,27 @@ b2World::~b2World()
 
 		b = bNext;
 	}
+
+	delete m_islandSolver;
+}
+
+void b2World::SetThreadCount(int32 count)
+{
+	b2Assert(IsLocked() == false);
+
+	delete m_islandSolver;
+	m_islandSolver = NULL;
+
+	if (count > 1)
+	{
+		m_islandSolver = new b2IslandSolver();
+		m_islandSolver->SetThreadCount(count);
+	}
+}
+
+int32 b2World::GetThreadCount() const
+{
+	return m_islandSolver ? m_islandSolver->GetThreadCount() : 1;
 }
 
 void b2World::SetDestructionListener(b2DestructionListener* listener)
@@ -527,11 +552,19 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
-		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
-		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
+		if (m_islandSolver)
+		{
+			// Solved with the others once they are all built.
+			m_islandSolver->Add(island);
+		}
+		else
+		{
+			b2Profile profile;
+			island.Solve(&profile, step, m_gravity, m_allowSleep);
+			m_profile.solveInit += profile.solveInit;
+			m_profile.solveVelocity += profile.solveVelocity;
+			m_profile.solvePosition += profile.solvePosition;
+		}
 
 		// Post solve cleanup.
 		for (int32 i = 0; i < island.m_bodyCount; ++i)
@@ -547,6 +580,12 @@ void b2World::Solve(const b2TimeStep& step)
 
 	m_stackAllocator.Free(stack);
 
+	if (m_islandSolver)
+	{
+		m_islandSolver->Solve(&m_profile, step, m_gravity, m_allowSleep, &m_stackAllocator,
+							  m_contactManager.m_contactListener);
+	}
+
 	{
 		b2Timer timer;
 		// Synchronize fixtures, check for out of range bodies.
@@ -860,7 +899,8 @@ void b2World::SolveTOI(const b2TimeStep& step)
 		subStep.positionIterations = 20;
 		subStep.velocityIterations = step.velocityIterations;
 		subStep.warmStarting = false;
-		island.SolveTOI(subStep, bA->m_islandIndex, bB->m_islandIndex);
+		subStep.wideSolver = false;
+		island.SolveTOI(subStep, island.GetIndex(bA), island.GetIndex(bB));
 
 		// Reset island flags and synchronize broad-phase proxies.
 		for (int32 i = 0; i < island.m_bodyCount; ++i)
@@ -898,6 +938,8 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 {
 	b2Timer stepTimer;
 
+	m_contactManager.m_broadPhase.ResetCounters();
+
 	// If new fixtures were added, we need to find the new contacts.
 	if (m_flags & e_newFixture)
 	{
@@ -923,6 +965,7 @@ void b2World::Step(float32 dt, int32 velocityIterations, int32 positionIteration
 	step.dtRatio = m_inv_dt0 * dt;
 
 	step.warmStarting = m_warmStarting;
+	step.wideSolver = m_wideSolver;
 
 	// Update contacts. This is where some contacts are destroyed.
 	{
@@ -1256,6 +1299,37 @@ float32 b2World::GetTreeQuality() const
 	return m_contactManager.m_broadPhase.GetTreeQuality();
 }
 
+int32 b2World::GetStaticProxyCount() const
+{
+	return m_contactManager.m_broadPhase.GetStaticProxyCount();
+}
+
+int32 b2World::GetStaticTreeHeight() const
+{
+	return m_contactManager.m_broadPhase.GetStaticTreeHeight();
+}
+
+float32 b2World::GetStaticTreeQuality() const
+{
+	return m_contactManager.m_broadPhase.GetStaticTreeQuality();
+}
+
+void b2World::RebuildStaticTree()
+{
+	b2Assert(IsLocked() == false);
+	if (IsLocked())
+	{
+		return;
+	}
+
+	m_contactManager.m_broadPhase.RebuildStaticTree();
+}
+
+const b2BroadPhaseCounters& b2World::GetBroadPhaseCounters() const
+{
+	return m_contactManager.m_broadPhase.GetCounters();
+}
+
 void b2World::Dump()
 {
 	if ((m_flags & e_locked) == e_locked)
@@ -0,0 +1,57 @@
+#ifndef BOX_STACK_H
+#define BOX_STACK_H
+
+#include <Entity.h>
+#include <GameState.h>
+#include <IPhysic.h>
+#include <Rectangle.h>
+#include <vector>
+
+// Columns of a few thousand boxes that never sleep, the solver does the same work every step. The average step time
+// is logged every SAMPLE_FRAMES frames, then either the contact solver or the box manifolds takes the scalar path so
+// each is timed on its own against the frames where both are wide
+class BoxStack final : public bart::Entity
+{
+public:
+    virtual ~BoxStack() = default;
+
+    bool CanDraw() override { return true; }
+    bool CanUpdate() override { return true; }
+
+    void Draw() override;
+    void Update(float aDeltaTime) override;
+    void Start() override;
+    void Destroy() override;
+
+    static const int COLUMNS;
+    static const int ROWS;
+    static const int BOX_SIZE; // world units
+    static const int SAMPLE_FRAMES;
+
+private:
+    enum EPath
+    {
+        ALL_WIDE,
+        SCALAR_SOLVER,
+        SCALAR_COLLIDE,
+        PATH_COUNT
+    };
+
+    void ApplyPath() const;
+
+    std::vector<size_t> m_Bodies;
+    bart::BodyTransforms m_Transforms;
+    std::vector<bart::Rectangle> m_Rects;
+    int m_Path{ALL_WIDE};
+    int m_Frames{0};
+    float m_Milliseconds{0.0f};
+};
+
+class BoxStackScene final : public bart::GameState
+{
+public:
+    virtual ~BoxStackScene() = default;
+    void Load() override;
+};
+
+#endif
\ No newline at end of file
@@ -32,6 +32,7 @@ public:
 	void SetBodyType(bart::EBodyType aType);
 
 private:
+    static const float WALK_SPEED; // world units per second
 
     bart::Animation* m_Animation;
     bart::Transform* m_Transform;
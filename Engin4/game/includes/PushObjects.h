@@ -23,6 +23,7 @@ public:
 	void Start() override;
 	void Update(float aDeltatime) override;
 	void Destroy() override;
+	bool GetBounds(Rectangle* aBounds) const override;
 
 	void OnCollisionEnter(Entity* aEntity, const vector<pair<float, float>>& aContactPoints, float aNormalX, float aNormalY) override;
 	void OnCollisionExit(Entity* aEntity) override;
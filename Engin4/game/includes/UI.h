@@ -1,9 +1,9 @@
 #ifndef UI_H
 #define UI_H
 
-#include <Text.h>
 #include <Entity.h>
-#include <Transform.h>
+#include <UILabel.h>
+#include <UILayer.h>
 
 
 class UI final : public bart::Entity
@@ -12,10 +12,9 @@ public:
 	UI();
 	virtual ~UI() = default;
 
-	bool CanDraw() override { return true; }
+	bool CanDraw() override { return false; } // the UI layer is a pass of the render graph
 	bool CanUpdate() override { return true; }
 
-	void Draw() override;
 	void Start() override;
 	void Update(float aDeltaTime) override;
 	void Destroy() override;
@@ -25,8 +24,8 @@ public:
 
 private:
 	float m_Timer;
-	bart::Text* m_TimerTxt { nullptr };
-	bart::Transform* m_TimerPosition { nullptr };
+	bart::UILayer m_Layer;
+	bart::UILabel* m_TimerTxt { nullptr };
 };
 
 
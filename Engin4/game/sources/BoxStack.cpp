@@ -0,0 +1,109 @@
+#include <BoxStack.h>
+#include <Engine.h>
+
+const int BoxStack::COLUMNS = 60;
+const int BoxStack::ROWS = 50;
+const int BoxStack::BOX_SIZE = 12;
+const int BoxStack::SAMPLE_FRAMES = 300;
+
+void BoxStack::Start()
+{
+    bart::IPhysic& tPhysic = bart::Engine::Instance().GetPhysic();
+
+    bart::PhysicMaterial tGround;
+    tGround.BodyType = bart::STATIC_BODY;
+    tGround.PosX = 0.0f;
+    tGround.PosY = 760.0f;
+    tGround.Width = 1600.0f;
+    tGround.Height = 40.0f;
+    m_Bodies.push_back(tPhysic.CreateBody(tGround));
+
+    bart::PhysicMaterial tBox;
+    tBox.BodyType = bart::DYNAMIC_BODY;
+    tBox.Width = static_cast<float>(BOX_SIZE);
+    tBox.Height = static_cast<float>(BOX_SIZE);
+    tBox.Friction = 0.6f;
+    tBox.AllowSleep = false;
+
+    // One column every two boxes, the boxes of a column touch so every step has a full load of contacts
+    for (int tColumn = 0; tColumn < COLUMNS; tColumn++)
+    {
+        for (int tRow = 0; tRow < ROWS; tRow++)
+        {
+            tBox.PosX = static_cast<float>(80 + tColumn * BOX_SIZE * 2);
+            tBox.PosY = static_cast<float>(760 - (tRow + 1) * BOX_SIZE);
+            m_Bodies.push_back(tPhysic.CreateBody(tBox));
+        }
+    }
+
+    ApplyPath();
+}
+
+void BoxStack::Update(float /*aDeltaTime*/)
+{
+    bart::IPhysic& tPhysic = bart::Engine::Instance().GetPhysic();
+
+    m_Milliseconds += tPhysic.GetStepMilliseconds();
+    m_Frames++;
+
+    if (m_Frames == SAMPLE_FRAMES)
+    {
+        bart::Engine::Instance().GetLogger().Log("%s solver, %s manifolds: %.3f ms per frame\n",
+                                                 m_Path == SCALAR_SOLVER ? "Scalar" : "Wide",
+                                                 m_Path == SCALAR_COLLIDE ? "scalar" : "wide",
+                                                 m_Milliseconds / static_cast<float>(m_Frames));
+
+        m_Path = (m_Path + 1) % PATH_COUNT;
+        ApplyPath();
+        m_Milliseconds = 0.0f;
+        m_Frames = 0;
+    }
+}
+
+void BoxStack::ApplyPath() const
+{
+    bart::IPhysic& tPhysic = bart::Engine::Instance().GetPhysic();
+    tPhysic.SetWideSolver(m_Path != SCALAR_SOLVER);
+    tPhysic.SetWideCollide(m_Path != SCALAR_COLLIDE);
+}
+
+void BoxStack::Draw()
+{
+    bart::IGraphic& tGraphic = bart::Engine::Instance().GetGraphic();
+    const size_t tCount = bart::Engine::Instance().GetPhysic().SyncTransforms(m_Transforms);
+
+    m_Rects.resize(tCount);
+    for (size_t i = 0; i < tCount; i++)
+    {
+        m_Rects[i].X = static_cast<int>(m_Transforms.X[i]);
+        m_Rects[i].Y = static_cast<int>(m_Transforms.Y[i]);
+        m_Rects[i].W = BOX_SIZE;
+        m_Rects[i].H = BOX_SIZE;
+    }
+
+    tGraphic.SetColor(200, 120, 40, 255);
+    tGraphic.FillRects(m_Rects.data(), tCount);
+    tGraphic.SetColor(60, 60, 60, 255);
+    tGraphic.Fill(0, 760, 1600, 40);
+}
+
+void BoxStack::Destroy()
+{
+    bart::IPhysic& tPhysic = bart::Engine::Instance().GetPhysic();
+
+    for (size_t tId : m_Bodies)
+    {
+        tPhysic.DestroyBody(tId);
+    }
+
+    m_Bodies.clear();
+
+    // The next scene gets the one at a time paths back
+    tPhysic.SetWideSolver(false);
+    tPhysic.SetWideCollide(false);
+}
+
+void BoxStackScene::Load()
+{
+    bart::Engine::Instance().GetScene().AddEntity("BoxStack", new BoxStack());
+}
\ No newline at end of file
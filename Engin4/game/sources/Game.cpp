@@ -1,5 +1,8 @@
 #include <Engine.h>
+#include <OffscreenGraphics.h>
 #include <SceneGame.h>
+#include <BoxStack.h>
+#include <cstdlib>
 
 using namespace bart;
 
@@ -11,16 +14,105 @@ using namespace bart;
 void RegisterGameStates()
 {
     Engine::Instance().GetScene().Register("SceneGame", new SceneGame());
+    Engine::Instance().GetScene().Register("BoxStack", new BoxStackScene());
 }
 
-int main()
+// -frames N renders N frames offscreen as fast as possible, -hashes logs a hash of every frame
+// and -dump FOLDER INTERVAL saves one frame out of INTERVAL in FOLDER. -budget MS lowers the resolution
+// of the world, down to half, when rendering a frame takes longer than MS milliseconds. -physicthread steps the
+// physic on its own thread while the frame is rendered and -solverthreads N solves its islands on N threads. -scene NAME
+// loads another registered scene, BoxStack compares the wide and the scalar contact solvers. -compare IMAGE draws test
+// cases with the software renderer and with SDL's and exits with 1 when the frames differ
+int main(int argc, char* argv[])
 {
-    if (Engine::Instance().Initialize("Climber Puzzle", 1600, 800))
+    int tFrames = 0;
+    float tBudget = 0.0f;
+    bool tHashes = false;
+    std::string tDumpFolder;
+    unsigned int tDumpInterval = 0;
+    bool tPhysicThread = false;
+    int tSolverThreads = 1;
+    std::string tScene = "SceneGame";
+    std::string tCompareImage;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string tArg = argv[i];
+
+        if (tArg == "-frames" && i + 1 < argc)
+        {
+            tFrames = std::atoi(argv[++i]);
+        }
+        else if (tArg == "-hashes")
+        {
+            tHashes = true;
+        }
+        else if (tArg == "-dump" && i + 2 < argc)
+        {
+            tDumpFolder = argv[++i];
+            tDumpInterval = static_cast<unsigned int>(std::atoi(argv[++i]));
+        }
+        else if (tArg == "-budget" && i + 1 < argc)
+        {
+            tBudget = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (tArg == "-physicthread")
+        {
+            tPhysicThread = true;
+        }
+        else if (tArg == "-solverthreads" && i + 1 < argc)
+        {
+            tSolverThreads = std::atoi(argv[++i]);
+        }
+        else if (tArg == "-scene" && i + 1 < argc)
+        {
+            tScene = argv[++i];
+        }
+        else if (tArg == "-compare" && i + 1 < argc)
+        {
+            tCompareImage = argv[++i];
+        }
+    }
+
+    if (!tCompareImage.empty())
+    {
+        if (!Engine::Instance().Initialize("Climber Puzzle", 640, 360, OFFSCREEN))
+        {
+            return 1;
+        }
+
+        return Engine::Instance().RunComparison(tCompareImage) ? 0 : 1;
+    }
+
+    if (Engine::Instance().Initialize("Climber Puzzle", 1600, 800, tFrames > 0 ? OFFSCREEN : WINDOWED))
     {
         RegisterGameStates();
 
-        Engine::Instance().GetScene().Load("SceneGame");
-        Engine::Instance().Start();
+        if (tBudget > 0.0f)
+        {
+            Engine::Instance().GetResolution().Enable(tBudget, 0.5f, 1.0f);
+        }
+
+        Engine::Instance().GetPhysic().SetThreaded(tPhysicThread);
+        Engine::Instance().GetPhysic().SetSolverThreads(tSolverThreads);
+
+        Engine::Instance().GetScene().Load(tScene);
+
+        if (tFrames > 0)
+        {
+            OffscreenGraphics* tGraphic = dynamic_cast<OffscreenGraphics*>(&Engine::Instance().GetGraphic());
+            if (tGraphic != nullptr)
+            {
+                tGraphic->SetHashLogging(tHashes);
+                tGraphic->SetFrameDumps(tDumpFolder, tDumpInterval);
+            }
+
+            Engine::Instance().RunFrames(tFrames, 1.0f / 60.0f);
+        }
+        else
+        {
+            Engine::Instance().Start();
+        }
     }
     return 0;
 }
@@ -22,7 +22,6 @@ void GroundEntities::Start()
 
 void GroundEntities::Update(float aDeltatime)
 {
-	m_RigidBody->Update(m_Transform, aDeltatime);
 	m_Sprite->Update(m_Transform, aDeltatime);
 }
 
@@ -36,6 +35,12 @@ void GroundEntities::Destroy()
 	SAFE_DELETE(m_RigidBody);
 }
 
+bool GroundEntities::GetBounds(Rectangle* aBounds) const
+{
+	m_Transform->GetAxisAlignedBounds(aBounds);
+	return true;
+}
+
 void GroundEntities::OnCollisionEnter(Entity * aEntity, const vector<pair<float, float>>& aContactPoints, float aNormalX, float aNormalY)
 {
 }
@@ -3,6 +3,8 @@
 #include <MapEntity.h>
 #include <Config.h>
 
+const float PlayerEntity::WALK_SPEED = 60.0f;
+
 PlayerEntity::PlayerEntity()
 {
     m_Transform = new bart::Transform();
@@ -43,25 +45,33 @@ void PlayerEntity::Update(float aDeltaTime)
 {
 
 	IInput& tInput = Engine::Instance().GetInput();
-	m_RigidBody->Update(m_Transform, aDeltaTime);
 	
 
 
+	// The walk cycle only advances while walking, the animation system moves the frames
+	const bool tWalking = tInput.IsKeyDown(KEY_LEFT) || tInput.IsKeyDown(KEY_RIGHT);
+
+	// The body walks, the transform drawn between two steps is never set back on it
+	float tVelocityX = 0.0f;
+	float tVelocityY = 0.0f;
+	m_RigidBody->GetVelocity(&tVelocityX, &tVelocityY);
+	tVelocityX = 0.0f;
+
 	if (tInput.IsKeyDown(KEY_LEFT))
 	{
-		m_Transform->Translate(-1.0f, 0.0f);
+		tVelocityX = -Engine::Instance().GetPhysic().ToPhysic(WALK_SPEED);
 		m_Transform->SetFlip(true, false);
-		m_Animation->Update(m_Transform, aDeltaTime);
-
 	}
 	else if (tInput.IsKeyDown(KEY_RIGHT))
 	{
-		m_Transform->Translate(1.0f, 0.0f);
+		tVelocityX = Engine::Instance().GetPhysic().ToPhysic(WALK_SPEED);
 		m_Transform->SetFlip(false, false);
-		m_Animation->Update(m_Transform, aDeltaTime);
 	}
 
-	m_RigidBody->SetTransform(m_Transform);
+	m_RigidBody->SetVelocity(tVelocityX, tVelocityY);
+
+	m_Animation->SetPaused(!tWalking);
+	m_Animation->Update(m_Transform, aDeltaTime);
 }
 
 
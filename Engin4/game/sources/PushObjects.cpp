@@ -23,7 +23,6 @@ void PushObjects::Start()
 
 void PushObjects::Update(float aDeltatime)
 {
-	m_RigidBody->Update(m_Transform, aDeltatime);
 	m_Sprite->Update(m_Transform, aDeltatime);
 }
 
@@ -37,6 +36,12 @@ void PushObjects::Destroy()
 	SAFE_DELETE(m_RigidBody);
 }
 
+bool PushObjects::GetBounds(Rectangle* aBounds) const
+{
+	m_Transform->GetAxisAlignedBounds(aBounds);
+	return true;
+}
+
 void PushObjects::OnCollisionEnter(Entity * aEntity, const vector<pair<float, float>>& aContactPoints, float aNormalX, float aNormalY)
 {
 }
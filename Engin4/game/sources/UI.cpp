@@ -1,26 +1,31 @@
 #include <UI.h>
+#include <Engine.h>
 #include <Assets.h>
 #include <Color.h>
 #include <Config.h>
 
 UI::UI()
 {
-	m_TimerTxt = new bart::Text();
-	m_TimerPosition = new bart::Transform();
-}
-
-void UI::Draw()
-{
-	m_TimerTxt->Draw();
+	m_TimerTxt = new bart::UILabel();
 }
 
 void UI::Start()
 {
+	bart::IGraphic& tGraphic = bart::Engine::Instance().GetGraphic();
+
+	int tWidth, tHeight;
+	float tScaleX, tScaleY;
+	tGraphic.GetWindowSize(&tWidth, &tHeight);
+	tGraphic.GetViewportScale(&tScaleX, &tScaleY);
+	// Screen space, drawn by the render graph over the scene. The text is only rendered again when the displayed
+	// second changes
+	m_Layer.Initialize("UI", static_cast<int>(tWidth / tScaleX), static_cast<int>(tHeight / tScaleY));
+
 	m_Timer = 10.0f;
 	m_TimerTxt->Load(Assets::EIGHTBIT_WONDER_FONT, 12, bart::Color::White);
 	m_TimerTxt->SetText("10:00");
-	m_TimerPosition->SetPosition(100.0f, 100.0f);
-	m_TimerTxt->Update(m_TimerPosition, 0.0f);
+	m_TimerTxt->SetPosition(100, 100);
+	m_Layer.Add(m_TimerTxt);
 }
 
 void UI::Update(float aDeltaTime)
@@ -36,6 +41,7 @@ void UI::Update(float aDeltaTime)
 
 void UI::Destroy()
 {
+	m_Layer.Clean();
+	m_TimerTxt->Unload();
 	SAFE_DELETE(m_TimerTxt);
-	SAFE_DELETE(m_TimerPosition);
 }